@@ -14,6 +14,8 @@ void FI_CLI_Poll(void); /* from fi_cli.c */
 
 #define LINK_UART LPUART3
 
+FI_SITE_REGISTER(s_siteExceptions, "EXCEPTIONS", FI_B_EXCEPTIONS, FI_TRIG_PROB, 0u, 0u, 0u);
+
 static void LinkUart_Init115200(void)
 {
     lpuart_config_t cfg;
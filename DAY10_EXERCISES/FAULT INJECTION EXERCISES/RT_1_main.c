@@ -11,6 +11,7 @@
 #include "fi/arinc429.h"
 
 void FI_CLI_Poll(void); /* from fi_cli.c */
+bool FI_CLI_StartCampaign(const char *script); /* from fi_cli.c */
 
 #define LINK_UART LPUART3
 
@@ -40,9 +41,16 @@ int main(void)
     FI_SetProbability(5);
     FI_SetSeed(0x0000BEEFu);
 
-    /* Required triggers (can also arm via CLI): */
-    FI_ArmNth(FI_F_ARINC_PARITY, 10);
+    /* Required triggers: the window is absolute boot time 2000..2100 ms
+       (inclusive), which a campaign "arm ... time" step cannot express: it
+       counts from the step. The Nth trigger runs as a campaign from
+       FI_CLI_Poll (can also arm via CLI, or replace with "camp add ..."). */
     FI_ArmWindowMs(FI_F_ARINC_PARITY, 2000u, 2100u);
+    (void)FI_CLI_StartCampaign("arm ARINC_PARITY nth 10");
+
+    /* Frames leave through the interrupt-driven TX queue; the loop no longer
+       stalls ~520 us per word in LPUART_WriteBlocking. */
+    ARINC429_TxInit(LINK_UART, NULL, NULL);
 
     arinc429_word_t aw = { .label = 0x12u, .sdi = 1u, .data = 0x12345u, .ssm = 2u };
 
@@ -55,14 +63,17 @@ int main(void)
         /* Event counting for Nth trigger */
         FI_NotifyEvent(FI_F_ARINC_PARITY);
 
-        status_t st = ARINC429_SendWord(LINK_UART, &aw);
+        status_t st = ARINC429_SendWordAsync(&aw);
         if (st == kStatus_LPUART_TxBusy)
             PRINTF("TX: busy\r\n");
 
         if ((tx_ctr % 100u) == 0u)
         {
-            PRINTF("t=%ums tx=%u FI=%d mask=0x%08x pct=%u\r\n",
-                   (unsigned)FI_NowMs(), (unsigned)tx_ctr, FI_IsEnabled(),
+            arinc429_tx_stats_t ts;
+            ARINC429_TxGetStats(&ts);
+            PRINTF("t=%ums tx=%u sent=%u xfers=%u FI=%d mask=0x%08x pct=%u\r\n",
+                   (unsigned)FI_NowMs(), (unsigned)tx_ctr, (unsigned)ts.sent,
+                   (unsigned)ts.transfers, FI_IsEnabled(),
                    (unsigned)FI_GetMask(), (unsigned)FI_GetProbability());
         }
 
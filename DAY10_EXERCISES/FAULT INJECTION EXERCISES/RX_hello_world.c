@@ -6,6 +6,8 @@
 #include "fsl_common.h"
 #include "fsl_lpuart.h"
 
+#include "../common/a429_word.h"
+
 #define LINK_UART LPUART3
 
 static void LinkUart_Init115200(void)
@@ -39,13 +41,7 @@ static uint8_t crc8(const uint8_t *d, uint32_t n)
 static bool arinc_odd_parity_ok(uint32_t w)
 {
     /* overall odd parity check (including bit31 parity bit) */
-    uint32_t x = w;
-    x ^= x >> 16;
-    x ^= x >> 8;
-    x ^= x >> 4;
-    x &= 0xFu;
-    uint8_t parity32 = (uint8_t)((0x6996u >> x) & 1u);
-    return (parity32 == 1u);
+    return A429_ParityOk(w);
 }
 
 int main(void)
@@ -90,7 +86,7 @@ int main(void)
                              ((uint32_t)body[2] << 16) |
                              ((uint32_t)body[3] << 24);
 
-                uint8_t label = (uint8_t)(w & 0xFFu);
+                uint8_t label = (uint8_t)A429_GetLabel(w);
 
                 if (label != 0x12u)
                     bad_arinc_label++;
@@ -13,6 +13,8 @@
 #define LINK_UART LPUART3
 #define MAX_BUSY_RETRY 3
 
+FI_SITE_REGISTER(s_siteBitflip, "MEM_BITFLIP", FI_B_MEM_BITFLIP, FI_TRIG_PROB, 0u, 0u, 0u);
+
 static void LinkUart_Init115200(void)
 {
     lpuart_config_t cfg;
@@ -1,4 +1,9 @@
 #include "arinc429.h"
+#include "uart_fi_shim.h"
+
+#include "fsl_common.h"
+#include "../../common/a429_word.h"
+#include <string.h>
 
 static uint8_t crc8(const uint8_t *d, uint32_t n)
 {
@@ -18,34 +23,21 @@ static uint8_t crc8(const uint8_t *d, uint32_t n)
     return c;
 }
 
-static uint8_t odd_parity_31(uint32_t v31)
-{
-    uint32_t x = v31;
-    x ^= x >> 16;
-    x ^= x >> 8;
-    x ^= x >> 4;
-    x &= 0xFu;
-    uint8_t parity = (uint8_t)((0x6996u >> x) & 1u);
-    return (parity == 0u) ? 1u : 0u;
-}
-
 uint32_t ARINC429_Pack(const arinc429_word_t *w, bool force_bad_parity)
 {
-    uint32_t v = 0u;
-    v |= ((uint32_t)(w->label) & 0xFFu) << 0;
-    v |= ((uint32_t)(w->sdi) & 0x03u) << 8;
-    v |= ((uint32_t)(w->data) & 0x7FFFFu) << 10;
-    v |= ((uint32_t)(w->ssm) & 0x03u) << 29;
+    uint32_t v = A429_Pack(w->label, w->sdi, w->data, w->ssm);
 
-    uint8_t p = odd_parity_31(v);
     if (force_bad_parity)
-        p ^= 1u;
-    v |= ((uint32_t)p) << 31;
+        v ^= A429_MASK(PARITY);
 
     return v;
 }
 
-status_t ARINC429_SendWord(LPUART_Type *base, const arinc429_word_t *w)
+FI_SITE_REGISTER(s_siteLabel, "ARINC_LABEL", FI_B_ARINC_LABEL, FI_TRIG_PROB, 0u, 0u, 0u);
+FI_SITE_REGISTER(s_siteParity, "ARINC_PARITY", FI_B_ARINC_PARITY, FI_TRIG_PROB, 0u, 0u, 0u);
+
+/* Build one link frame, applying the ARINC-level FI points. */
+static void ARINC429_FormatFrame(const arinc429_word_t *w, uint8_t frame[ARINC429_FRAME_LEN])
 {
     bool bad_parity = false;
     arinc429_word_t temp = *w;
@@ -59,8 +51,7 @@ status_t ARINC429_SendWord(LPUART_Type *base, const arinc429_word_t *w)
     uint32_t word = ARINC429_Pack(&temp, bad_parity);
 
     /* Frame: [0xA5][word LSB..MSB][CRC8(word bytes)] */
-    uint8_t frame[1 + 4 + 1];
-    frame[0] = 0xA5u;
+    frame[0] = ARINC429_FRAME_SYNC;
     frame[1] = (uint8_t)(word & 0xFFu);
     frame[2] = (uint8_t)((word >> 8) & 0xFFu);
     frame[3] = (uint8_t)((word >> 16) & 0xFFu);
@@ -68,7 +59,168 @@ status_t ARINC429_SendWord(LPUART_Type *base, const arinc429_word_t *w)
     frame[5] = crc8(&frame[1], 4);
 
     /* Optional: burst noise */
-    FI_POINT(FI_F_UART_CORRUPT, FI_BitFlipRange(frame, sizeof(frame), 2););
+    FI_POINT(FI_F_UART_CORRUPT, FI_BitFlipRange(frame, ARINC429_FRAME_LEN, 2););
+}
 
+status_t ARINC429_SendWord(LPUART_Type *base, const arinc429_word_t *w)
+{
+    uint8_t frame[ARINC429_FRAME_LEN];
+    ARINC429_FormatFrame(w, frame);
     return UART_FI_WriteBlocking(base, frame, sizeof(frame));
 }
+
+/* ==== Non-blocking TX queue ====
+ * Frames are formatted straight into queue slots. Slots are contiguous, so
+ * every run of queued frames up to the wrap point goes out as one driver
+ * transfer. wr is only written by the producer (main loop), rd only by the
+ * LPUART IRQ; both are free-running frame counters.
+ */
+static LPUART_Type          *s_txBase;
+static lpuart_handle_t       s_txHandle;
+static arinc429_tx_done_cb_t s_txDoneCb;
+static void                 *s_txDoneUser;
+
+static uint8_t           s_txq[ARINC429_TXQ_DEPTH][ARINC429_FRAME_LEN];
+static volatile uint32_t s_txq_wr;
+static volatile uint32_t s_txq_rd;
+static volatile uint32_t s_txq_inflight;
+static volatile bool     s_tx_busy;
+
+static arinc429_tx_stats_t s_txStats;
+
+/* Start a transfer for the next contiguous run. Caller must exclude the IRQ. */
+static void txq_kick_locked(void)
+{
+    if (s_tx_busy || (s_txq_wr == s_txq_rd))
+        return;
+
+    uint32_t start = s_txq_rd % ARINC429_TXQ_DEPTH;
+    uint32_t n     = s_txq_wr - s_txq_rd;
+    if (n > (ARINC429_TXQ_DEPTH - start))
+        n = ARINC429_TXQ_DEPTH - start;
+
+    lpuart_transfer_t xfer;
+    xfer.data     = &s_txq[start][0];
+    xfer.dataSize = (size_t)n * ARINC429_FRAME_LEN;
+
+    s_txq_inflight = n;
+    s_tx_busy      = true;
+    if (LPUART_TransferSendNonBlocking(s_txBase, &s_txHandle, &xfer) == kStatus_Success)
+    {
+        s_txStats.transfers++;
+    }
+    else
+    {
+        s_txq_inflight = 0u;
+        s_tx_busy      = false;
+    }
+}
+
+static void txq_kick(void)
+{
+    uint32_t primask = DisableGlobalIRQ();
+    txq_kick_locked();
+    EnableGlobalIRQ(primask);
+}
+
+static void ARINC429_TxCallback(LPUART_Type *base, lpuart_handle_t *handle, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)userData;
+
+    if (status != kStatus_LPUART_TxIdle)
+        return;
+
+    uint32_t n = s_txq_inflight;
+    s_txq_rd += n;
+    s_txq_inflight = 0u;
+    s_tx_busy = false;
+    s_txStats.sent += n;
+
+    if (s_txDoneCb)
+        s_txDoneCb(n, kStatus_Success, s_txDoneUser);
+
+    txq_kick_locked();
+}
+
+void ARINC429_TxInit(LPUART_Type *base, arinc429_tx_done_cb_t cb, void *user)
+{
+    s_txBase       = base;
+    s_txDoneCb     = cb;
+    s_txDoneUser   = user;
+    s_txq_wr       = 0u;
+    s_txq_rd       = 0u;
+    s_txq_inflight = 0u;
+    s_tx_busy      = false;
+    memset(&s_txStats, 0, sizeof(s_txStats));
+
+    /* Also enables the LPUART IRQ in the NVIC. */
+    LPUART_TransferCreateHandle(base, &s_txHandle, ARINC429_TxCallback, NULL);
+}
+
+/* Queue one frame. Applies the same FI points as the blocking path:
+ * ARINC-level ones while formatting, then the UART_FI shim's TX_BUSY/CORRUPT
+ * on the queued bytes (the slot is ours, so no scratch copy is needed). */
+static status_t txq_push(const arinc429_word_t *w)
+{
+    if ((s_txq_wr - s_txq_rd) >= ARINC429_TXQ_DEPTH)
+    {
+        s_txStats.queue_full++;
+        return kStatus_LPUART_TxBusy;
+    }
+
+    if (FI_ENABLE && FICore_ShouldFire(FI_B_UART_TX_BUSY))
+    {
+        s_txStats.busy_injected++;
+        return kStatus_LPUART_TxBusy;
+    }
+
+    uint8_t *slot = s_txq[s_txq_wr % ARINC429_TXQ_DEPTH];
+    ARINC429_FormatFrame(w, slot);
+
+    if (FI_ENABLE && FICore_ShouldFire(FI_B_UART_CORRUPT))
+        FI_BitFlipRange(slot, ARINC429_FRAME_LEN, 7);
+
+    s_txq_wr++;
+    s_txStats.queued++;
+    return kStatus_Success;
+}
+
+status_t ARINC429_SendWordAsync(const arinc429_word_t *w)
+{
+    status_t st = txq_push(w);
+    if (st == kStatus_Success)
+        txq_kick();
+    return st;
+}
+
+uint32_t ARINC429_SendBurstAsync(const arinc429_word_t *w, uint32_t count)
+{
+    uint32_t queued = 0u;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        status_t st = txq_push(&w[i]);
+        if (st == kStatus_Success)
+            queued++;
+        else if ((s_txq_wr - s_txq_rd) >= ARINC429_TXQ_DEPTH)
+            break;
+    }
+
+    /* One kick for the whole burst so it leaves as a single transfer. */
+    if (queued != 0u)
+        txq_kick();
+    return queued;
+}
+
+uint32_t ARINC429_TxPending(void)
+{
+    return s_txq_wr - s_txq_rd;
+}
+
+void ARINC429_TxGetStats(arinc429_tx_stats_t *out)
+{
+    uint32_t primask = DisableGlobalIRQ();
+    *out = s_txStats;
+    EnableGlobalIRQ(primask);
+}
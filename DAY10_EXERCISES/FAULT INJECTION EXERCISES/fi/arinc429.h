@@ -7,6 +7,15 @@
 #include "fsl_lpuart.h"
 #include "fi.h"
 
+/* Frame on the link UART: [0xA5][word LSB..MSB][CRC8(word bytes)] */
+#define ARINC429_FRAME_SYNC 0xA5u
+#define ARINC429_FRAME_LEN  6u
+
+/* Async TX queue depth in frames (one slot = one preformatted frame). */
+#ifndef ARINC429_TXQ_DEPTH
+#define ARINC429_TXQ_DEPTH 32u
+#endif
+
 typedef struct {
     uint8_t  label;
     uint8_t  sdi;
@@ -14,7 +23,26 @@ typedef struct {
     uint8_t  ssm;
 } arinc429_word_t;
 
+/* Called from the LPUART IRQ when a queued transfer has left the UART. */
+typedef void (*arinc429_tx_done_cb_t)(uint32_t frames_done, status_t status, void *user);
+
+typedef struct {
+    uint32_t queued;        /* frames accepted into the queue */
+    uint32_t sent;          /* frames completed by the driver */
+    uint32_t transfers;     /* driver transfers started (bursts coalesce) */
+    uint32_t queue_full;    /* frames refused because the queue was full */
+    uint32_t busy_injected; /* frames refused by FI_F_UART_TX_BUSY */
+} arinc429_tx_stats_t;
+
 uint32_t ARINC429_Pack(const arinc429_word_t *w, bool force_bad_parity);
 status_t ARINC429_SendWord(LPUART_Type *base, const arinc429_word_t *w);
 
+/* Non-blocking path: frames are queued and drained by the interrupt-driven
+ * LPUART transfer API. Call ARINC429_TxInit once after LPUART_Init. */
+void     ARINC429_TxInit(LPUART_Type *base, arinc429_tx_done_cb_t cb, void *user);
+status_t ARINC429_SendWordAsync(const arinc429_word_t *w);
+uint32_t ARINC429_SendBurstAsync(const arinc429_word_t *w, uint32_t count); /* returns frames queued */
+uint32_t ARINC429_TxPending(void);
+void     ARINC429_TxGetStats(arinc429_tx_stats_t *out);
+
 #endif
@@ -1,34 +1,30 @@
 #include "fi.h"
 
-#include <string.h>
 #include "fsl_device_registers.h"
 
-static volatile uint32_t fi_mask = FI_FEATURE_MASK;
-static volatile uint8_t  fi_prob = FI_DEFAULT_PROB_PCT;
-static volatile bool     fi_en   = (FI_ENABLE != 0);
+/* Decisions, triggers, counters and the log live in common/fi_core.c; this
+ * file maps feature bits onto core sites (site = bit number) and keeps the
+ * lab's global probability, DWT time base and exception injections. */
 
-static uint32_t lcg_state = FI_SEED;
+static uint8_t fi_prob = FI_DEFAULT_PROB_PCT;
 
-static uint32_t ev_count[32];
-static uint32_t nth_arm[32];
-static bool     nth_fired[32];
+ficm_t g_fi_uart_model;   /* zero: FICM_OFF */
 
-static uint32_t win_start_ms[32];
-static uint32_t win_end_ms[32];
-static bool     win_armed[32];
+#define FI_PATCH_LEN 16u      /* FI_CorruptWrite: affected bytes per write */
 
-static inline uint32_t lcg_next(void)
-{
-    lcg_state = lcg_state * 1664525u + 1013904223u;
-    return lcg_state;
-}
+/* FI_NowMs = CYCCNT / (SystemCoreClock / 1000) without a divide: exact
+ * multiply-high reciprocal (Granlund-Montgomery), computed in FI_Init. */
+static uint32_t ms_mul;
+static uint8_t  ms_sh1;
+static uint8_t  ms_sh2;
+static bool     ms_ok;
 
+/* Site of a single-bit feature, -1 for 0 or several bits. */
 static inline int bit_index(uint32_t feature)
 {
-    for (int i = 0; i < 32; i++)
-        if (feature == (1u << i))
-            return i;
-    return -1;
+    if (feature == 0u || (feature & (feature - 1u)) != 0u)
+        return -1;
+    return __builtin_ctz(feature);
 }
 
 static void dwt_init(void)
@@ -38,126 +34,181 @@ static void dwt_init(void)
     DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 }
 
+static void ms_recip_init(void)
+{
+    uint32_t d = SystemCoreClock / 1000u;
+    uint32_t l = (d > 1u) ? (32u - (uint32_t)__builtin_clz(d - 1u)) : 0u; /* ceil(log2 d) */
+
+    ms_ok = (d != 0u);
+    if (!ms_ok)
+        return;
+    ms_mul = (uint32_t)(((((uint64_t)1u << l) - d) << 32) / d) + 1u;
+    ms_sh1 = (uint8_t)((l != 0u) ? 1u : 0u);
+    ms_sh2 = (uint8_t)((l != 0u) ? (l - 1u) : 0u);
+}
+
 uint32_t FI_NowMs(void)
 {
-    uint32_t hz = SystemCoreClock;
-    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0u || hz == 0u)
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0u || !ms_ok)
         return 0u;
-    return (uint32_t)(DWT->CYCCNT / (hz / 1000u));
+    uint32_t n = DWT->CYCCNT;
+    uint32_t t = (uint32_t)(((uint64_t)n * ms_mul) >> 32);
+    return (t + ((n - t) >> ms_sh1)) >> ms_sh2;
 }
 
+/* Every feature fires with the global probability unless it has a
+ * registered default; Nth triggers count FI_NotifyEvent. */
 void FI_Init(void)
 {
+    fi_core_cfg_t cfg = {0};
+
     SystemCoreClockUpdate();
     dwt_init();
+    ms_recip_init();
 
-    lcg_state = (FI_SEED ^ 0xA5A5A5A5u) + 1u;
+    FICore_Init((FI_SEED ^ 0xA5A5A5A5u) + 1u);
+    FICore_SetClock(FI_NowMs);
+    FICore_SetEnabled(FI_ENABLE != 0);
+    FICore_SetMask(FI_FEATURE_MASK);
 
-    memset((void *)ev_count, 0, sizeof(ev_count));
-    memset((void *)nth_arm, 0, sizeof(nth_arm));
-    memset((void *)nth_fired, 0, sizeof(nth_fired));
-    memset((void *)win_start_ms, 0, sizeof(win_start_ms));
-    memset((void *)win_end_ms, 0, sizeof(win_end_ms));
-    memset((void *)win_armed, 0, sizeof(win_armed));
+    cfg.trig  = FI_TRIG_PROB;
+    cfg.pct   = fi_prob;
+    cfg.flags = FI_CORE_F_EVENTS;
+    for (uint32_t site = 0; site < FI_CORE_SITES; site++)
+        FICore_Arm(site, &cfg);
+
+    FI_SITES_FOREACH(d)
+    {
+        if (FI_SiteIsFirst(d))
+            FICore_ArmDefault(d, fi_prob, FI_CORE_F_EVENTS);
+    }
 }
 
-void FI_SetEnabled(bool en) { fi_en = en; }
-bool FI_IsEnabled(void) { return fi_en; }
+void FI_SetEnabled(bool en) { FICore_SetEnabled(en); }
+bool FI_IsEnabled(void) { return FICore_IsEnabled(); }
 
-void FI_SetMask(uint32_t mask) { fi_mask = mask; }
-uint32_t FI_GetMask(void) { return fi_mask; }
+void FI_SetMask(uint32_t mask) { FICore_SetMask(mask); }
+uint32_t FI_GetMask(void) { return FICore_GetMask(); }
 
-void FI_SetProbability(uint8_t pct) { fi_prob = pct; }
+void FI_SetProbability(uint8_t pct)
+{
+    fi_prob = pct;
+    for (uint32_t site = 0; site < FI_CORE_SITES; site++)
+        FICore_SetPct(site, pct);
+}
 uint8_t FI_GetProbability(void) { return fi_prob; }
 
-void FI_SetSeed(uint32_t seed) { lcg_state = seed ? seed : 1u; }
+void FI_SetSeed(uint32_t seed) { FICore_SetSeed(seed ? seed : 1u); }
 
-uint8_t FI_RandPct(void) { return (uint8_t)(lcg_next() % 100u); }
+uint8_t FI_RandPct(void) { return FICore_RandPct(); }
 
 void FI_BitFlip8(uint8_t *p, uint8_t mask) { *p ^= mask; }
 
 void FI_BitFlipRange(void *buf, uint32_t len, uint32_t everyN)
 {
-    if (!fi_en || everyN == 0u)
+    if (!FICore_IsEnabled() || everyN == 0u)
         return;
     uint8_t *b = (uint8_t *)buf;
-    for (uint32_t i = 0; i < len; i++)
+    for (uint32_t i = 0; i < len; i += everyN)
+        b[i] ^= (uint8_t)(1u << (FICore_Rand32() & 7u));
+}
+
+/* status_t: kStatus_Success is 0 */
+int32_t FI_CorruptWrite(fi_write_t write, void *ctx, const uint8_t *data, size_t length, uint32_t everyN)
+{
+    ficm_t *m = &g_fi_uart_model;
+    uint8_t patch[FI_PATCH_LEN];
+    int32_t st = 0;
+
+    if (m->model == FICM_OFF)
     {
-        if ((i % everyN) == 0u)
-            b[i] ^= (uint8_t)(1u << (lcg_next() & 7u));
+        /* FI_BitFlipRange on the fly: byte 0, N, 2N, ... one bit each */
+        if (!FICore_IsEnabled() || everyN == 0u)
+            return write(ctx, data, length);
+        for (size_t i = 0; st == 0 && i < length; i += everyN)
+        {
+            size_t run = length - i - 1u;
+            if (run > everyN - 1u)
+                run = everyN - 1u;
+            patch[0] = (uint8_t)(data[i] ^ (1u << (FICore_Rand32() & 7u)));
+            st = write(ctx, patch, 1u);
+            if (st == 0 && run != 0u)
+                st = write(ctx, &data[i + 1u], run);
+        }
+        return st;
     }
+
+    FICorrupt_Begin(m, FICore_Rand32(), length);
+    while (st == 0 && !FICorrupt_Done(m))
+    {
+        size_t used = FICorrupt_Clean(m);
+        if (used != 0u)
+        {
+            st = write(ctx, data, used);
+            FICorrupt_Skip(m, used);
+        }
+        else
+        {
+            size_t n = FICorrupt_Patch(m, data, length, &used, patch, sizeof(patch));
+            if (n != 0u)
+                st = write(ctx, patch, n);
+        }
+        data += used;
+        length -= used;
+    }
+    return st;
 }
 
 void FI_NotifyEvent(uint32_t feature)
 {
     int bi = bit_index(feature);
     if (bi >= 0)
-        ev_count[bi]++;
+        FICore_NotifyEvent((uint32_t)bi);
 }
 
 void FI_ArmNth(uint32_t feature, uint32_t nth)
 {
+    const uint32_t v[3] = {nth, 0u, 0u};
     int bi = bit_index(feature);
     if (bi >= 0)
-    {
-        nth_arm[bi] = nth;
-        nth_fired[bi] = false;
-    }
+        (void)FICore_ArmArgs((uint32_t)bi, (nth != 0u) ? FI_TRIG_NTH : FI_TRIG_PROB, v);
 }
 
 void FI_ArmWindowMs(uint32_t feature, uint32_t start_ms, uint32_t end_ms)
 {
     int bi = bit_index(feature);
-    if (bi >= 0)
+    if (bi >= 0) /* inclusive end */
+        FICore_SetTimeGate((uint32_t)bi, true, start_ms, (end_ms != UINT32_MAX) ? (end_ms + 1u) : end_ms);
+}
+
+void FI_Disarm(uint32_t feature)
+{
+    static const uint32_t no_args[3] = {0u, 0u, 0u};
+
+    for (uint32_t f = feature; f != 0u; f &= f - 1u)
     {
-        win_start_ms[bi] = start_ms;
-        win_end_ms[bi]   = end_ms;
-        win_armed[bi]    = true;
+        uint32_t site = (uint32_t)__builtin_ctz(f);
+        (void)FICore_ArmArgs(site, FI_TRIG_PROB, no_args);
+        FICore_SetTimeGate(site, false, 0u, 0u);
     }
 }
 
-static bool window_allows(uint32_t feature)
+bool FI_ShouldFire(uint32_t feature)
 {
     int bi = bit_index(feature);
-    if (bi < 0 || !win_armed[bi])
-        return true;
-    uint32_t now = FI_NowMs();
-    return (now >= win_start_ms[bi]) && (now <= win_end_ms[bi]);
+    return (bi >= 0) && FICore_ShouldFire((uint32_t)bi);
 }
 
-static bool nth_allows(uint32_t feature)
+uint32_t FI_GetEventCount(uint32_t feature)
 {
     int bi = bit_index(feature);
-    if (bi < 0)
-        return true;
-
-    if (nth_arm[bi] == 0u)
-        return true;
-
-    if (nth_fired[bi])
-        return false;
-
-    if (ev_count[bi] == nth_arm[bi])
-    {
-        nth_fired[bi] = true;
-        return true;
-    }
-
-    return false;
+    return (bi >= 0) ? FICore_Site((uint32_t)bi)->events : 0u;
 }
 
-bool FI_ShouldFire(uint32_t feature)
+uint32_t FI_GetFireCount(uint32_t feature)
 {
-    if (!fi_en)
-        return false;
-    if ((fi_mask & feature) == 0u)
-        return false;
-    if (!window_allows(feature))
-        return false;
-    if (!nth_allows(feature))
-        return false;
-
-    return (FI_RandPct() < fi_prob);
+    int bi = bit_index(feature);
+    return (bi >= 0) ? FICore_Site((uint32_t)bi)->fires : 0u;
 }
 
 /* ==== Exception injections (RT-2 uses these) ==== */
@@ -1,15 +1,26 @@
 #ifndef FI_H
 #define FI_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 #include "fi_config.h"
 
+/* Decisions come from common/fi_core.h with site = FI_B_* bit number.
+ * Sites register their name and default trigger next to the FI_POINT
+ * (FI_SITE_REGISTER, policy = FICore_ArmArgs policy); FI_Init and the CLI
+ * read the registry. Compiled out with FI_ENABLE=0. */
+#define FI_SITE_REGISTRY FI_ENABLE
+#include "../../common/fi_core.h"
+#include "../../common/fi_corrupt.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Also caches the cycles-per-ms reciprocal for FI_NowMs (call again after
+ * changing the core clock) and arms the registered default triggers. */
 void     FI_Init(void);
 void     FI_SetEnabled(bool en);
 bool     FI_IsEnabled(void);
@@ -23,17 +34,39 @@ uint8_t  FI_GetProbability(void);
 void     FI_SetSeed(uint32_t seed);
 
 uint8_t  FI_RandPct(void);
+
+/* Runtime-feature form of the decision (CLI, bench). FI_POINT and the
+ * library call sites use FICore_ShouldFire(FI_B_*) directly, whose
+ * disabled / masked-out path is one inline bit test. */
 bool     FI_ShouldFire(uint32_t feature);
 
 void     FI_BitFlip8(uint8_t *p, uint8_t mask);
 void     FI_BitFlipRange(void *buf, uint32_t len, uint32_t everyN);
 
+/* What a UART_CORRUPT fire does to the payload in uart_fi_shim.c /
+ * wrap_lpuart_writeblocking.c (common/fi_corrupt.h, CLI 'model'). FICM_OFF
+ * (default): what FI_BitFlipRange(payload, length, everyN) would do. */
+extern ficm_t g_fi_uart_model;
+
+/* Blocking write of the driver underneath (returns status_t) */
+typedef int32_t (*fi_write_t)(void *ctx, const uint8_t *data, size_t length);
+
+/* Send a payload corrupted by g_fi_uart_model without copying it: clean
+ * stretches go to write() straight from data, only the affected bytes from
+ * a small patch buffer. Any length; stops at the first failing write. */
+int32_t FI_CorruptWrite(fi_write_t write, void *ctx, const uint8_t *data, size_t length, uint32_t everyN);
+
 /* Runtime trigger helpers (used in RT-1) */
 void     FI_NotifyEvent(uint32_t feature);
 void     FI_ArmNth(uint32_t feature, uint32_t nth);
 void     FI_ArmWindowMs(uint32_t feature, uint32_t start_ms, uint32_t end_ms);
+void     FI_Disarm(uint32_t feature); /* drop Nth and window triggers */
 uint32_t FI_NowMs(void);
 
+/* Per-feature counters since FI_Init (single-bit feature) */
+uint32_t FI_GetEventCount(uint32_t feature); /* FI_NotifyEvent calls */
+uint32_t FI_GetFireCount(uint32_t feature);  /* decisions that fired */
+
 /* Exception injections (used in RT-2) */
 void FI_Inject_DivByZero(void);
 void FI_Inject_UnalignedAccess(void);
@@ -41,7 +74,7 @@ void FI_Inject_MemFault(void);
 
 #if FI_ENABLE
 #define FI_POINT(feature, code_block) \
-    do { if (FI_ShouldFire((feature))) { code_block; } } while (0)
+    do { if (FICore_ShouldFire((uint32_t)__builtin_ctz(feature))) { code_block; } } while (0)
 #else
 #define FI_POINT(feature, code_block) \
     do { (void)(feature); } while (0)
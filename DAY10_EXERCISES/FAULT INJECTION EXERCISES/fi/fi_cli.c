@@ -3,6 +3,11 @@
 #include <stdlib.h>
 
 #include "fi.h"
+#include "fsl_device_registers.h"
+#include "../../common/fi_campaign.h"
+
+#define FI_BENCH_CALLS   10000u
+#define FI_BENCH_FEATURE (1u << 31)   /* no FI_POINT uses this bit */
 
 static char line[80];
 static unsigned idx = 0;
@@ -22,16 +27,43 @@ static uint32_t parse_hex(const char *s)
     return (uint32_t)strtoul(s ? s : "0", NULL, 16);
 }
 
+/* Only sites linked into this image resolve; 0 (no feature) otherwise. */
 static uint32_t feature_from_name(const char *s)
 {
-    if (!s) return 0;
-    if (!strcmp(s, "UART_TX_BUSY")) return FI_F_UART_TX_BUSY;
-    if (!strcmp(s, "UART_CORRUPT")) return FI_F_UART_CORRUPT;
-    if (!strcmp(s, "ARINC_PARITY")) return FI_F_ARINC_PARITY;
-    if (!strcmp(s, "ARINC_LABEL"))  return FI_F_ARINC_LABEL;
-    if (!strcmp(s, "MEM_BITFLIP"))  return FI_F_MEM_BITFLIP;
-    if (!strcmp(s, "EXCEPTIONS"))   return FI_F_EXCEPTIONS;
-    return 0;
+    const fi_site_desc_t *d = FI_SiteByName(s);
+    return (d && d->id < 32u) ? (1u << d->id) : 0u;
+}
+
+static void print_sites(void)
+{
+    PRINTF("Sites (mask=0x%08x):\r\n", (unsigned)FI_GetMask());
+    FI_SITES_FOREACH(d)
+    {
+        const fi_core_site_t *s = FICore_Site(d->id);
+        if (!FI_SiteIsFirst(d) || !s)
+            continue;
+        PRINTF("  %-13s bit %2u %-6s n=%u pct=%u%s ev=%u hit=%u fire=%u\r\n", d->name,
+               (unsigned)d->id, FICore_TrigName(s->cfg.trig), (unsigned)s->cfg.n,
+               (unsigned)s->cfg.pct, (s->cfg.flags & FI_CORE_F_TIME_GATE) ? " timed" : "",
+               (unsigned)s->events, (unsigned)s->hits, (unsigned)s->fires);
+    }
+}
+
+/* Pending fi_core log records, oldest first; reading consumes them. */
+static void print_log(void)
+{
+    fi_core_event_t e;
+    unsigned n = 0;
+
+    while (FICore_LogRead(&e))
+    {
+        const fi_site_desc_t *d = FI_SiteById(e.site);
+        PRINTF("  t=%u ctx=%u %-13s hit=%u extra=%u data=0x%08x\r\n", (unsigned)e.tsMs,
+               (unsigned)e.ctx, d ? d->name : "?", (unsigned)e.hit, (unsigned)e.extra,
+               (unsigned)e.data);
+        n++;
+    }
+    PRINTF("log: %u records, %u dropped (total)\r\n", n, (unsigned)FICore_LogDrops());
 }
 
 static void print_help(void)
@@ -44,12 +76,418 @@ static void print_help(void)
     PRINTF("  seed HEX\r\n");
     PRINTF("  nth FEATURE N\r\n");
     PRINTF("  win FEATURE START_MS END_MS\r\n");
+    PRINTF("  off FEATURE          (drop nth/win triggers)\r\n");
+    PRINTF("  sites                (FEATURE names linked into this image)\r\n");
+    PRINTF("  log                  (fires since the last log, oldest first)\r\n");
+    PRINTF("  bench                (FI_ShouldFire cost; advances the PRNG)\r\n");
+    PRINTF("  camp add STEP[; STEP] | clear | run | stop | stat\r\n");
+    PRINTF("                       (common/fi_campaign.h script)\r\n");
+    PRINTF("  rec [stop|dump|load OFF HEX]  (record every FI decision)\r\n");
+    PRINTF("  replay [stop]        (decisions from the recording)\r\n");
+    PRINTF("  model [off|ge PGB PBG [EBAD [EGOOD]]|stuck MASK VAL [LEN]|drop|ins|dup [PPM]|slip BITS [LEN]]\r\n");
+    PRINTF("                       (UART_CORRUPT payload model, common/fi_corrupt.h)\r\n");
+}
+
+/* ==== Campaign adapter ====
+ *   arm FEATURE POLICY ...     FICore_ArmArgs policies (prob, every, nth,
+ *                              window, burst, time, always, off); also
+ *                              unmasks FEATURE
+ *   disarm FEATURE             triggers and gates off, masked out
+ *   set en|pct|seed|msk VALUE
+ * Counters: FEATURE.ev (FI_NotifyEvent), FEATURE.hit, FEATURE.fire. */
+static const char *const camp_param[]  = {"en", "pct", "seed", "msk"};
+
+static fic_campaign_t camp;
+static uint32_t camp_ms;
+static uint32_t camp_cyc_last;
+static uint32_t camp_cyc_rem;
+
+/* FI_NowMs follows CYCCNT and wraps after 2^32 cycles (seconds); campaigns
+ * run for hours, so accumulate CYCCNT deltas instead. Needs a poll at
+ * least once per wrap, which the main loop's FI_CLI_Poll provides. */
+static uint32_t camp_now_ms(void *ctx)
+{
+    uint32_t per = SystemCoreClock / 1000u;
+    uint32_t cyc = DWT->CYCCNT;
+    (void)ctx;
+
+    camp_cyc_rem += cyc - camp_cyc_last;
+    camp_cyc_last = cyc;
+    if (per != 0u)
+    {
+        camp_ms      += camp_cyc_rem / per;
+        camp_cyc_rem %= per;
+    }
+    return camp_ms;
+}
+
+static int camp_lookup(const char *const *names, uint32_t n, const char *s)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (!strcmp(names[i], s))
+            return (int)i;
+    }
+    return -1;
+}
+
+static int camp_site_id(void *ctx, const char *name)
+{
+    const fi_site_desc_t *d = FI_SiteByName(name);
+    (void)ctx;
+    return (d && d->id < 32u) ? (int)d->id : -1;
+}
+
+static int camp_policy_id(void *ctx, const char *name)
+{
+    (void)ctx;
+    return FICore_ArmPolicyId(name);
+}
+
+static int camp_param_id(void *ctx, const char *name)
+{
+    (void)ctx;
+    return camp_lookup(camp_param, sizeof(camp_param) / sizeof(camp_param[0]), name);
+}
+
+static int camp_counter_id(void *ctx, const char *name)
+{
+    char site[16];
+    const char *dot = strchr(name, '.');
+    size_t n = dot ? (size_t)(dot - name) : 0u;
+    int bit;
+
+    if (!dot || n >= sizeof(site))
+        return -1;
+    memcpy(site, name, n);
+    site[n] = 0;
+    bit = camp_site_id(ctx, site);
+    if (bit < 0)
+        return -1;
+    if (!strcmp(dot + 1, "ev"))
+        return bit << 2;
+    if (!strcmp(dot + 1, "hit"))
+        return (bit << 2) | 1;
+    if (!strcmp(dot + 1, "fire"))
+        return (bit << 2) | 2;
+    return -1;
+}
+
+static bool camp_arm(void *ctx, uint16_t site, uint8_t policy, const uint32_t v[3])
+{
+    (void)ctx;
+    if (!FICore_ArmArgs(site, policy, v))
+        return false;
+    FI_SetMask(FI_GetMask() | (1u << site));
+    return true;
+}
+
+static void camp_disarm(void *ctx, uint16_t site)
+{
+    (void)ctx;
+    FI_Disarm(1u << site);
+    FI_SetMask(FI_GetMask() & ~(1u << site));
+}
+
+static bool camp_set(void *ctx, uint16_t param, uint32_t value)
+{
+    (void)ctx;
+    switch (param)
+    {
+        case 0: FI_SetEnabled(value != 0u); return true;
+        case 1: if (value > 100u) return false; FI_SetProbability((uint8_t)value); return true;
+        case 2: FI_SetSeed(value); return true;
+        case 3: FI_SetMask(value); return true;
+        default: return false;
+    }
+}
+
+static uint32_t camp_counter(void *ctx, uint16_t id)
+{
+    const fi_core_site_t *s = FICore_Site(id >> 2);
+    (void)ctx;
+    if (!s)
+        return 0u;
+    switch (id & 3u)
+    {
+        case 0:  return s->events;
+        case 1:  return s->hits;
+        default: return s->fires;
+    }
+}
+
+static void camp_on_result(void *ctx, const fic_result_t *r)
+{
+    (void)ctx;
+    PRINTF("camp it=%u step=%u %s %s delta=%u (+%u ms)\r\n", (unsigned)r->iteration,
+           (unsigned)r->step, FICampaign_OpName(r->op), r->pass ? "PASS" : "FAIL",
+           (unsigned)r->delta, (unsigned)r->tMs);
+}
+
+static void camp_print_stat(void)
+{
+    PRINTF("camp %s steps=%u step=%u it=%u pass=%u fail=%u\r\n",
+           camp.running ? "running" : "idle", (unsigned)camp.stepCount, (unsigned)camp.pc,
+           (unsigned)camp.iterations, (unsigned)camp.passed, (unsigned)camp.failed);
+    if (camp.failed != 0u)
+        PRINTF("  first fail: it=%u step=%u %s delta=%u\r\n", (unsigned)camp.firstFail.iteration,
+               (unsigned)camp.firstFail.step, FICampaign_OpName(camp.firstFail.op),
+               (unsigned)camp.firstFail.delta);
+}
+
+static void camp_on_done(void *ctx)
+{
+    (void)ctx;
+    camp_print_stat();
+}
+
+static const fic_ops_t camp_ops = {
+    .now_ms     = camp_now_ms,
+    .site_id    = camp_site_id,
+    .policy_id  = camp_policy_id,
+    .param_id   = camp_param_id,
+    .counter_id = camp_counter_id,
+    .arm        = camp_arm,
+    .disarm     = camp_disarm,
+    .set        = camp_set,
+    .counter    = camp_counter,
+    .on_result  = camp_on_result,
+    .on_done    = camp_on_done,
+};
+
+static void camp_ensure_init(void)
+{
+    if (camp.ops == NULL)
+    {
+        FICampaign_Init(&camp, &camp_ops);
+        camp_cyc_last = DWT->CYCCNT;
+    }
+}
+
+/* Replace the script and start it; false if a step does not compile. */
+bool FI_CLI_StartCampaign(const char *script)
+{
+    uint32_t err = 0;
+
+    camp_ensure_init();
+    FICampaign_Clear(&camp);
+    if (!FICampaign_Compile(&camp, script, &err))
+    {
+        PRINTF("camp: step %u rejected\r\n", (unsigned)err);
+        return false;
+    }
+    FICampaign_Start(&camp);
+    return true;
+}
+
+static void cmd_camp(const char *sub, char *rest)
+{
+    uint32_t err = 0;
+
+    camp_ensure_init();
+    if (!sub)
+        sub = "stat";
+
+    if (!strcmp(sub, "add"))
+    {
+        if (camp.running || !rest || !FICampaign_Compile(&camp, rest, &err))
+            PRINTF("camp: %s\r\n", camp.running ? "stop first" : "bad step");
+        else
+            PRINTF("camp: %u steps\r\n", (unsigned)camp.stepCount);
+    }
+    else if (!strcmp(sub, "clear")) FICampaign_Clear(&camp);
+    else if (!strcmp(sub, "run"))   FICampaign_Start(&camp);
+    else if (!strcmp(sub, "stop"))  { FICampaign_Stop(&camp); camp_print_stat(); }
+    else                            camp_print_stat();
+}
+
+/* ==== Decision record / replay (common/fi_core.h) ====
+ * 'rec dump' prints 'rec load' lines; pasted back after a reset they
+ * restore the stream for 'replay'. */
+#define RR_LINE 24u
+
+static uint8_t  rr_buf[1024];
+static uint32_t rr_len;
+
+static void rr_print_stat(void)
+{
+    static const char *const mode[] = {"off", "recording", "replaying"};
+    fi_core_rr_stat_t st;
+
+    FICore_RRStat(&st);
+    PRINTF("rr %s: %u bytes, %u fires%s", mode[st.mode],
+           (unsigned)((st.mode == FI_CORE_RR_OFF) ? rr_len : st.len), (unsigned)st.fires,
+           st.overflow ? " (buffer full)" : "");
+    if (st.mode == FI_CORE_RR_REPLAY)
+        PRINTF(", %u pending, diverged 0x%08x", (unsigned)st.pending, (unsigned)st.diverged);
+    PRINTF("\r\n");
+}
+
+static void rr_load(const char *off_s, const char *hex)
+{
+    char *end = NULL;
+    uint32_t off = off_s ? (uint32_t)strtoul(off_s, &end, 0) : 0u;
+
+    if (!off_s || *end != '\0' || !FICore_RRLoadHex(rr_buf, sizeof(rr_buf), &rr_len, off, hex))
+        PRINTF("rec load: bad line\r\n");
+}
+
+static void cmd_rec(const char *sub)
+{
+    uint32_t len;
+
+    if (!sub)
+    {
+        FICore_ReplayStop();
+        rr_len = 0;
+        (void)FICore_RecordStart(rr_buf, sizeof(rr_buf));
+    }
+    else if (!strcmp(sub, "stop"))
+    {
+        len = FICore_RecordStop();
+        if (len)
+            rr_len = len;
+    }
+    else if (!strcmp(sub, "dump"))
+    {
+        for (uint32_t off = 0; off < rr_len; off += RR_LINE)
+        {
+            PRINTF("rec load %u ", (unsigned)off);
+            for (uint32_t i = off; i < rr_len && i < off + RR_LINE; i++)
+                PRINTF("%02x", (unsigned)rr_buf[i]);
+            PRINTF("\r\n");
+        }
+        return;
+    }
+    else if (!strcmp(sub, "load"))
+    {
+        char *off_s = strtok(NULL, " ");
+        rr_load(off_s, strtok(NULL, " "));
+        return;
+    }
+    rr_print_stat();
+}
+
+static void cmd_replay(const char *sub)
+{
+    uint32_t len;
+
+    if (sub && !strcmp(sub, "stop"))
+    {
+        rr_print_stat();
+        FICore_ReplayStop();
+        return;
+    }
+    len = FICore_RecordStop();   /* still recording: finish that stream first */
+    if (len)
+        rr_len = len;
+    if (FICore_ReplayStart(rr_buf, rr_len))
+        rr_print_stat();
+    else
+        PRINTF("nothing to replay (rec ... rec stop, or rec load lines)\r\n");
+}
+
+/* ==== UART_CORRUPT corruption model ==== */
+static void cmd_model(const char *name)
+{
+    uint32_t v[FICM_ARGS] = {0u, 0u, 0u, 0u};
+    int id;
+
+    if (name)
+    {
+        id = FICorrupt_ModelId(name);
+        for (uint32_t i = 0; i < FICM_ARGS; i++)
+        {
+            char *a = strtok(NULL, " ");
+            if (!a)
+                break;
+            v[i] = (uint32_t)strtoul(a, NULL, 0);
+        }
+        if (id < 0 || !FICorrupt_Set(&g_fi_uart_model, id, v))
+        {
+            PRINTF("model: bad model or args (help)\r\n");
+            return;
+        }
+    }
+    PRINTF("model %s %u %u %u %u\r\n", FICorrupt_ModelName(g_fi_uart_model.model),
+           (unsigned)g_fi_uart_model.args[0], (unsigned)g_fi_uart_model.args[1],
+           (unsigned)g_fi_uart_model.args[2], (unsigned)g_fi_uart_model.args[3]);
+}
+
+static uint32_t bench_loop(bool (*fn)(uint32_t), uint32_t feature)
+{
+    uint32_t fired = 0;
+    uint32_t t0 = DWT->CYCCNT;
+    for (uint32_t i = 0; i < FI_BENCH_CALLS; i++)
+        fired += fn(feature) ? 1u : 0u;
+    uint32_t cyc = DWT->CYCCNT - t0;
+    (void)fired;
+    return cyc;
+}
+
+static bool bench_empty(uint32_t feature)
+{
+    return feature == 0u;
+}
+
+/* What an FI_POINT compiles to: the inline core test on a constant site */
+static bool bench_point(uint32_t feature)
+{
+    (void)feature;
+    return FICore_ShouldFire(31u);
+}
+
+static void bench_report(const char *name, uint32_t cyc, uint32_t base)
+{
+    uint32_t net = (cyc > base) ? (cyc - base) : 0u;
+    PRINTF("  %-22s %3u.%02u cycles/call\r\n", name,
+           (unsigned)(net / FI_BENCH_CALLS), (unsigned)(((net % FI_BENCH_CALLS) * 100u) / FI_BENCH_CALLS));
+}
+
+/* Cost of one FI_POINT check in each state, net of the loop and call
+ * through a pointer (measured with an empty function). Uses a spare
+ * feature bit and restores enable/mask/probability afterwards. */
+static void cmd_bench(void)
+{
+    bool     en   = FI_IsEnabled();
+    uint32_t mask = FI_GetMask();
+    uint8_t  pct  = FI_GetProbability();
+    uint32_t base = bench_loop(bench_empty, FI_BENCH_FEATURE);
+
+    PRINTF("FI_ShouldFire, %u calls each:\r\n", (unsigned)FI_BENCH_CALLS);
+
+    FI_SetEnabled(false);
+    bench_report("disabled", bench_loop(FI_ShouldFire, FI_BENCH_FEATURE), base);
+    bench_report("disabled, FI_POINT", bench_loop(bench_point, FI_BENCH_FEATURE), base);
+
+    FI_SetEnabled(true);
+    FI_SetMask(mask & ~FI_BENCH_FEATURE);
+    bench_report("enabled, masked out", bench_loop(FI_ShouldFire, FI_BENCH_FEATURE), base);
+
+    FI_SetMask(mask | FI_BENCH_FEATURE);
+    FI_SetProbability(50u);
+    bench_report("enabled, pct roll", bench_loop(FI_ShouldFire, FI_BENCH_FEATURE), base);
+
+    FI_ArmNth(FI_BENCH_FEATURE, 1u);
+    bench_report("nth armed", bench_loop(FI_ShouldFire, FI_BENCH_FEATURE), base);
+
+    FI_ArmWindowMs(FI_BENCH_FEATURE, 0u, 0xFFFFFFFFu);
+    bench_report("nth + window armed", bench_loop(FI_ShouldFire, FI_BENCH_FEATURE), base);
+
+    FI_Disarm(FI_BENCH_FEATURE);
+    FI_SetMask(mask);
+    FI_SetProbability(pct);
+    FI_SetEnabled(en);
 }
 
 void FI_CLI_Poll(void)
 {
     char ch;
-    if (Console_TryReadChar(&ch) != kStatus_Success)
+
+    if (camp.running)
+        (void)FICampaign_Poll(&camp);
+
+    if (!Console_TryReadChar(&ch))
         return;
 
     if (ch == '\r' || ch == '\n')
@@ -117,6 +555,26 @@ void FI_CLI_Poll(void)
             return;
         }
 
+        if (!strcmp(cmd, "off"))
+        {
+            FI_Disarm(feature_from_name(strtok(NULL, " ")));
+            PRINTF("triggers off\r\n");
+            return;
+        }
+
+        if (!strcmp(cmd, "bench")) { cmd_bench(); return; }
+        if (!strcmp(cmd, "sites")) { print_sites(); return; }
+        if (!strcmp(cmd, "log"))   { print_log(); return; }
+        if (!strcmp(cmd, "rec"))    { cmd_rec(strtok(NULL, " ")); return; }
+        if (!strcmp(cmd, "replay")) { cmd_replay(strtok(NULL, " ")); return; }
+        if (!strcmp(cmd, "model"))  { cmd_model(strtok(NULL, " ")); return; }
+        if (!strcmp(cmd, "camp"))
+        {
+            char *sub = strtok(NULL, " ");
+            cmd_camp(sub, strtok(NULL, ""));
+            return;
+        }
+
         PRINTF("? (type help)\r\n");
         return;
     }
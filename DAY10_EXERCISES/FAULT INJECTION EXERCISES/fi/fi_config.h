@@ -17,11 +17,19 @@
 #define FI_FEATURE_MASK 0xFFFFFFFFu
 #endif
 
-#define FI_F_UART_TX_BUSY   (1u << 0)
-#define FI_F_UART_CORRUPT   (1u << 1)
-#define FI_F_ARINC_PARITY   (1u << 2)
-#define FI_F_ARINC_LABEL    (1u << 3)
-#define FI_F_MEM_BITFLIP    (1u << 4)
-#define FI_F_EXCEPTIONS     (1u << 5)
+/* Feature bit numbers: the site ids in the FI_SITE_REGISTER table */
+#define FI_B_UART_TX_BUSY   0u
+#define FI_B_UART_CORRUPT   1u
+#define FI_B_ARINC_PARITY   2u
+#define FI_B_ARINC_LABEL    3u
+#define FI_B_MEM_BITFLIP    4u
+#define FI_B_EXCEPTIONS     5u
+
+#define FI_F_UART_TX_BUSY   (1u << FI_B_UART_TX_BUSY)
+#define FI_F_UART_CORRUPT   (1u << FI_B_UART_CORRUPT)
+#define FI_F_ARINC_PARITY   (1u << FI_B_ARINC_PARITY)
+#define FI_F_ARINC_LABEL    (1u << FI_B_ARINC_LABEL)
+#define FI_F_MEM_BITFLIP    (1u << FI_B_MEM_BITFLIP)
+#define FI_F_EXCEPTIONS     (1u << FI_B_EXCEPTIONS)
 
 #endif
@@ -3,19 +3,21 @@
 
 extern status_t __real_LPUART_WriteBlocking(LPUART_Type *base, const uint8_t *data, size_t length);
 
+/* Same ids and defaults as uart_fi_shim.c; either may be linked. */
+FI_SITE_REGISTER(s_siteTxBusy, "UART_TX_BUSY", FI_B_UART_TX_BUSY, FI_TRIG_PROB, 0u, 0u, 0u);
+FI_SITE_REGISTER(s_siteCorrupt, "UART_CORRUPT", FI_B_UART_CORRUPT, FI_TRIG_PROB, 0u, 0u, 0u);
+
+static int32_t real_write(void *ctx, const uint8_t *data, size_t length)
+{
+    return __real_LPUART_WriteBlocking((LPUART_Type *)ctx, data, length);
+}
+
 status_t __wrap_LPUART_WriteBlocking(LPUART_Type *base, const uint8_t *data, size_t length)
 {
     FI_POINT(FI_F_UART_TX_BUSY, return kStatus_LPUART_TxBusy;);
 
-    if (FI_ENABLE && FI_ShouldFire(FI_F_UART_CORRUPT) && length <= 128u)
-    {
-        uint8_t scratch[128];
-        for (size_t i = 0; i < length; i++)
-            scratch[i] = data[i];
-
-        FI_BitFlipRange(scratch, (uint32_t)length, 11);
-        return __real_LPUART_WriteBlocking(base, scratch, length);
-    }
+    if (FI_ENABLE && FICore_ShouldFire(FI_B_UART_CORRUPT))
+        return FI_CorruptWrite(real_write, base, data, length, 11u);
 
     return __real_LPUART_WriteBlocking(base, data, length);
 }
@@ -5,6 +5,7 @@
 #include "fsl_common.h"
 #include "board.h"
 #include "board_uart3_pins.h"
+#include "../analyzer/a429_text.h"
 
 #define ARINC_UART            LPUART3
 #define ARINC_UART_CLK_FREQ   BOARD_DebugConsoleSrcFreq()
@@ -84,6 +85,16 @@ void ArincSim_InitUart3(uint32_t baudrate)
     timebase_init_1ms();
 }
 
+/* Hex field as sscanf("%lx") took it: optional 0x prefix, up to 8 digits */
+static bool take_hex32(a429_text_cursor_t *c, uint32_t *out)
+{
+    if (!A429Text_TakeLit(c, "0x", 2U))
+    {
+        (void)A429Text_TakeLit(c, "0X", 2U);
+    }
+    return A429Text_TakeHex(c, 8U, out);
+}
+
 static bool bridge_wait_ready(uint32_t bootCount, uint32_t flags)
 {
     char line[LINE_MAX];
@@ -203,13 +214,18 @@ void ArincSim_RunBridge(void)
 
         if (strncmp(line, "TX ", 3) == 0)
         {
-            /* Parse TX <seq> <label> <data> (best-effort) */
-            unsigned long seq = 0, label = 0, data = 0;
-            (void)sscanf(line, "TX %lu %lx %lx", &seq, &label, &data);
+            /* Parse TX <seq> <label> <data> (best-effort; only seq is echoed) */
+            uint32_t seq = 0U, label = 0U, data = 0U;
+            a429_text_cursor_t c = {line + 3, line + strlen(line)};
+            if (A429Text_TakeDec(&c, 9U, &seq) && A429Text_TakeLit(&c, " ", 1U) &&
+                take_hex32(&c, &label) && A429Text_TakeLit(&c, " ", 1U))
+            {
+                (void)take_hex32(&c, &data);
+            }
 
             /* Acknowledge */
             char ack[LINE_MAX];
-            (void)snprintf(ack, sizeof(ack), "ACK %lu\r\n", seq);
+            (void)snprintf(ack, sizeof(ack), "ACK %lu\r\n", (unsigned long)seq);
             uart3_write_str(ack);
             continue;
         }
@@ -1,4 +1,7 @@
 #include "a429_frame.h"
+#include "../common/a429_word.h"
+
+#include <string.h>
 
 #define ST_WAIT_SYNC  0
 #define ST_LEN        1
@@ -18,6 +21,7 @@ void A429_ParserInit(a429_uart_parser_t *p)
     p->len = 0;
     p->pay_idx = 0;
     p->chk = 0;
+    p->carry_len = 0;
     p->frames_ok = 0;
     p->frames_bad_chk = 0;
     p->frames_bad_len = 0;
@@ -85,25 +89,129 @@ a429_parse_result_t A429_ParserFeed(a429_uart_parser_t *p, uint8_t byte, uint32_
     return A429_PARSE_NONE;
 }
 
-static uint32_t popcount32(uint32_t x)
+/* Validate a candidate frame f[0..have) with f[0] == sync.
+ * Returns NONE while more bytes are needed. */
+static a429_parse_result_t check_frame(a429_uart_parser_t *p, const uint8_t *f, size_t have, uint32_t *out_word)
+{
+    if (have >= 2U && f[1] != 4U)
+    {
+        p->frames_bad_len++;
+        return A429_PARSE_BAD_LEN;
+    }
+    if (have < A429_FRAME_LEN)
+    {
+        return A429_PARSE_NONE;
+    }
+    if (chk8(f[1], &f[2]) != f[6])
+    {
+        p->frames_bad_chk++;
+        return A429_PARSE_BAD_CHK;
+    }
+
+    *out_word = ((uint32_t)f[2]) |
+                ((uint32_t)f[3] << 8) |
+                ((uint32_t)f[4] << 16) |
+                ((uint32_t)f[5] << 24);
+    p->frames_ok++;
+    return A429_PARSE_WORD_OK;
+}
+
+uint32_t A429_ParserFeedBuf(a429_uart_parser_t *p, const uint8_t *buf, size_t len,
+                            uint32_t *out_words, uint32_t max, size_t *consumed)
 {
-    /* Portable popcount */
-    x = x - ((x >> 1U) & 0x55555555U);
-    x = (x & 0x33333333U) + ((x >> 2U) & 0x33333333U);
-    x = (x + (x >> 4U)) & 0x0F0F0F0FU;
-    x = x + (x >> 8U);
-    x = x + (x >> 16U);
-    return x & 0x3FU;
+    size_t pos = 0;
+    uint32_t n = 0;
+    uint32_t w = 0;
+
+    /* 1) Complete a frame carried over from the previous buffer. */
+    while (p->carry_len != 0U && n < max)
+    {
+        const size_t old = p->carry_len;
+        size_t take = A429_FRAME_LEN - old;
+        if (take > len) take = len;
+
+        memcpy(&p->carry[old], buf, take);
+        const size_t have = old + take;
+
+        a429_parse_result_t r = check_frame(p, p->carry, have, &w);
+        if (r == A429_PARSE_NONE)
+        {
+            p->carry_len = (uint8_t)have;
+            pos = len;
+            break;
+        }
+        if (r == A429_PARSE_WORD_OK)
+        {
+            out_words[n++] = w;
+            p->carry_len = 0;
+            pos = take;
+            break;
+        }
+
+        /* Rejected: resync on the next sync byte inside the rejected bytes. */
+        const uint8_t *s = (const uint8_t *)memchr(&p->carry[1], A429_FRAME_SYNC, have - 1U);
+        if (s == NULL)
+        {
+            p->carry_len = 0;
+            pos = take;
+            break;
+        }
+        const size_t k = (size_t)(s - p->carry);
+        if (k >= old)
+        {
+            /* Sync is in this buffer: drop the carry and rescan from there. */
+            p->carry_len = 0;
+            pos = k - old;
+            break;
+        }
+        /* Sync is in the old carry: keep its tail and give back what we took. */
+        memmove(p->carry, &p->carry[k], old - k);
+        p->carry_len = (uint8_t)(old - k);
+    }
+
+    /* 2) Fast path: frames validated straight from buf. */
+    while (pos < len && n < max)
+    {
+        const uint8_t *s = (const uint8_t *)memchr(&buf[pos], A429_FRAME_SYNC, len - pos);
+        if (s == NULL)
+        {
+            pos = len;
+            break;
+        }
+        pos = (size_t)(s - buf);
+
+        const size_t avail = len - pos;
+        a429_parse_result_t r = check_frame(p, &buf[pos], (avail < A429_FRAME_LEN) ? avail : A429_FRAME_LEN, &w);
+        if (r == A429_PARSE_NONE)
+        {
+            memcpy(p->carry, &buf[pos], avail);
+            p->carry_len = (uint8_t)avail;
+            pos = len;
+            break;
+        }
+        if (r == A429_PARSE_WORD_OK)
+        {
+            out_words[n++] = w;
+            pos += A429_FRAME_LEN;
+        }
+        else
+        {
+            pos += 1U;
+        }
+    }
+
+    if (consumed) *consumed = pos;
+    return n;
 }
 
 bool A429_CheckOddParity(uint32_t word)
 {
     /* Treat bit31 as the parity bit; odd parity across all 32 bits means popcount is odd. */
-    return (popcount32(word) & 0x1U) == 1U;
+    return A429_ParityOk(word);
 }
 
 uint8_t A429_Label(uint32_t word)
 {
     /* Label in bits 0..7 if using little-endian assembly above. */
-    return (uint8_t)(word & 0xFFU);
+    return (uint8_t)A429_GetLabel(word);
 }
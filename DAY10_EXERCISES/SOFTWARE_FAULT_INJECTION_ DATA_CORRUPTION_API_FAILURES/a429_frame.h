@@ -1,9 +1,14 @@
 #ifndef A429_FRAME_H
 #define A429_FRAME_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
+/* [0xA5][LEN=4][W0][W1][W2][W3][CHK] */
+#define A429_FRAME_SYNC 0xA5U
+#define A429_FRAME_LEN  7U
+
 typedef enum
 {
     A429_PARSE_NONE = 0,
@@ -21,6 +26,10 @@ typedef struct
     uint8_t pay_idx;
     uint8_t chk;
 
+    /* A429_ParserFeedBuf: head of a frame that straddled the previous buffer */
+    uint8_t carry[A429_FRAME_LEN];
+    uint8_t carry_len;
+
     /* Stats */
     uint32_t frames_ok;
     uint32_t frames_bad_chk;
@@ -32,6 +41,17 @@ void A429_ParserInit(a429_uart_parser_t *p);
 
 a429_parse_result_t A429_ParserFeed(a429_uart_parser_t *p, uint8_t byte, uint32_t *out_word);
 
+/* Buffer-oriented feed: scans buf for sync bytes, validates complete frames
+ * in place and writes up to max words to out_words. After a bad length or
+ * checksum it resyncs on the next 0xA5 following the rejected sync byte, so
+ * a real frame hidden behind a false sync is not lost. Bad frames are only
+ * reported through the frames_bad_* counters.
+ * Returns the number of words written; *consumed (optional) is the number of
+ * bytes used, which is len unless out_words filled up first.
+ * Feed a given parser through one API only (byte-wise or buffer). */
+uint32_t A429_ParserFeedBuf(a429_uart_parser_t *p, const uint8_t *buf, size_t len,
+                            uint32_t *out_words, uint32_t max, size_t *consumed);
+
 /* ARINC checks */
 bool A429_CheckOddParity(uint32_t word);
 uint8_t A429_Label(uint32_t word);
@@ -0,0 +1,27 @@
+#include "a429_plaus.h"
+
+#include <string.h>
+
+void A429Plaus_Init(a429_plaus_t *p, uint32_t min_interval_ms)
+{
+    memset(p->allow, 0, sizeof(p->allow));
+    memset(p->last_ms, 0, sizeof(p->last_ms));
+    p->min_interval_ms = min_interval_ms;
+}
+
+void A429Plaus_Allow(a429_plaus_t *p, uint8_t label)
+{
+    p->allow[label] = 1U;
+}
+
+bool A429Plaus_Accept(a429_plaus_t *p, uint8_t label, uint32_t now_ms)
+{
+    if (!p->allow[label]) return false;
+
+    if ((now_ms - p->last_ms[label]) < p->min_interval_ms)
+    {
+        return false;
+    }
+    p->last_ms[label] = now_ms;
+    return true;
+}
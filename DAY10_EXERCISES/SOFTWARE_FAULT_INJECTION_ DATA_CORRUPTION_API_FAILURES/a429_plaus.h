@@ -0,0 +1,21 @@
+#ifndef A429_PLAUS_H
+#define A429_PLAUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Plausibility barrier: label allow-list plus a minimum repeat interval per
+ * label. Time is passed in by the caller (ms), so the same check runs on the
+ * target (PIT tick) and in the host replay tool (capture timestamps). */
+typedef struct
+{
+    uint8_t  allow[256];
+    uint32_t last_ms[256];
+    uint32_t min_interval_ms;
+} a429_plaus_t;
+
+void A429Plaus_Init(a429_plaus_t *p, uint32_t min_interval_ms);
+void A429Plaus_Allow(a429_plaus_t *p, uint8_t label);
+bool A429Plaus_Accept(a429_plaus_t *p, uint8_t label, uint32_t now_ms);
+
+#endif /* A429_PLAUS_H */
@@ -16,6 +16,14 @@
 #define DATA_LPUART_CLK_FREQ BOARD_DebugConsoleSrcFreq()
 #define DATA_LPUART_BAUDRATE (115200U)
 
+/* Circular eDMA RX for the data UART. Ring size must be a power of two;
+ * 512 B is ~44 ms of line time at 115200 baud. */
+#define DATA_DMA_BASEADDR          DMA0
+#define DATA_DMAMUX_BASEADDR       DMAMUX
+#define DATA_LPUART_RX_DMA_CHANNEL (0U)
+#define DATA_LPUART_RX_DMA_REQUEST kDmaRequestMuxLPUART3Rx
+#define DATA_UART_RX_RING_SIZE     (512U)
+
 /* PIT tick (10 ms) used for TX stall monitoring + periodic telemetry. */
 #define DEMO_PIT_BASEADDR PIT
 #define DEMO_PIT_CHANNEL  kPIT_Chnl_0
@@ -8,12 +8,7 @@ static void DataUart_Callback(LPUART_Type *base, lpuart_handle_t *handle, status
     (void)handle;
     data_uart_t *u = (data_uart_t *)userData;
 
-    if (status == kStatus_LPUART_RxIdle)
-    {
-        u->rxOnGoing = false;
-        u->rxByteReady = true;
-    }
-    else if (status == kStatus_LPUART_TxIdle)
+    if (status == kStatus_LPUART_TxIdle)
     {
 #if SFI_ENABLED
         /* Simulate lost TX completion by refusing to clear txOnGoing for this transfer. */
@@ -36,16 +31,26 @@ void DataUart_Init(data_uart_t *u, LPUART_Type *base, uint32_t clkHz, uint32_t b
     lpuart_config_t cfg;
 
     u->base = base;
-    u->rxOnGoing = false;
     u->txOnGoing = false;
-    u->rxByteReady = false;
-    u->rxByte = 0;
     u->txStallActive = false;
+    u->rxRing = NULL;
+    u->rxRingSize = 0;
+    u->rxWraps = 0;
+    u->rxLastHead = 0;
+    u->rxTail = 0;
+    u->rxIdle = false;
+    u->rxIdleEvents = 0;
+    u->rxHwOverruns = 0;
+    u->rxOverruns = 0;
+    u->rxLostBytes = 0;
 
     LPUART_GetDefaultConfig(&cfg);
     cfg.baudRate_Bps = baud;
     cfg.enableTx = true;
     cfg.enableRx = true;
+    /* Idle after one character time of a quiet line, counted from the stop bit. */
+    cfg.rxIdleType = kLPUART_IdleTypeStopBit;
+    cfg.rxIdleConfig = kLPUART_IdleCharacter1;
 
     LPUART_Init(base, &cfg, clkHz);
     LPUART_TransferCreateHandle(base, &u->handle, DataUart_Callback, (void *)u);
@@ -54,52 +59,148 @@ void DataUart_Init(data_uart_t *u, LPUART_Type *base, uint32_t clkHz, uint32_t b
     /* NOTE: If using multiple cores/RTOS, set NVIC priority appropriately. */
 }
 
-status_t DataUart_StartReceive1(data_uart_t *u)
+void DataUart_IRQHandler(data_uart_t *u)
 {
-    lpuart_transfer_t xfer;
-    if (u->rxOnGoing) return kStatus_LPUART_RxBusy;
+    const uint32_t stat = LPUART_GetStatusFlags(u->base);
+
+    /* RX runs on the DMA, not on the handle: with no receive pending the
+     * SDK handler would mask the idle IRQ after its first hit. Take both
+     * flags here so it never sees them. */
+    if ((stat & (uint32_t)kLPUART_IdleLineFlag) != 0U)
+    {
+        (void)LPUART_ClearStatusFlags(u->base, (uint32_t)kLPUART_IdleLineFlag);
+        u->rxIdleEvents++;
+        u->rxIdle = true;
+    }
+    if ((stat & (uint32_t)kLPUART_RxOverrunFlag) != 0U)
+    {
+        (void)LPUART_ClearStatusFlags(u->base, (uint32_t)kLPUART_RxOverrunFlag);
+        u->rxHwOverruns++;
+    }
+
+    /* TX completion */
+    LPUART_TransferHandleIRQ(u->base, &u->handle);
+}
 
-    xfer.data = &u->rxByte;
-    xfer.dataSize = 1U;
+static void DataUart_RxDmaCallback(edma_handle_t *handle, void *userData, bool transferDone, uint32_t tcds)
+{
+    (void)handle;
+    (void)tcds;
+    data_uart_t *u = (data_uart_t *)userData;
 
-    u->rxOnGoing = true;
-    u->rxByteReady = false;
+    if (transferDone)
+    {
+        u->rxWraps++;
+    }
+}
 
-    return LPUART_TransferReceiveNonBlocking(u->base, &u->handle, &xfer, NULL);
+void DataUart_StartRxDma(data_uart_t *u, DMA_Type *dma, DMAMUX_Type *mux,
+                         uint32_t channel, uint32_t request,
+                         uint8_t *ring, uint32_t ringSize)
+{
+    edma_config_t dmaCfg;
+    edma_transfer_config_t xfer;
+
+    u->rxDma = dma;
+    u->rxDmaChannel = channel;
+    u->rxRing = ring;
+    u->rxRingSize = ringSize;
+    u->rxWraps = 0;
+    u->rxLastHead = 0;
+    u->rxTail = 0;
+
+    DMAMUX_Init(mux);
+    DMAMUX_SetSource(mux, channel, request);
+    DMAMUX_EnableChannel(mux, channel);
+
+    EDMA_GetDefaultConfig(&dmaCfg);
+    EDMA_Init(dma, &dmaCfg);
+    EDMA_CreateHandle(&u->rxDmaHandle, dma, channel);
+    EDMA_SetCallback(&u->rxDmaHandle, DataUart_RxDmaCallback, (void *)u);
+
+    /* One byte per request from the LPUART data register, major loop = ring. */
+    EDMA_PrepareTransfer(&xfer, (void *)(uintptr_t)LPUART_GetDataRegisterAddress(u->base), sizeof(uint8_t),
+                         ring, sizeof(uint8_t), sizeof(uint8_t), ringSize, kEDMA_PeripheralToMemory);
+    (void)EDMA_SubmitTransfer(&u->rxDmaHandle, &xfer);
+
+    /* Make it circular: keep the request enabled at major-loop end and
+     * rewind the destination; the major-loop IRQ only counts wraps. */
+    EDMA_EnableAutoStopRequest(dma, channel, false);
+    dma->TCD[channel].DLAST_SGA = (uint32_t)(-(int32_t)ringSize);
+
+    EDMA_StartTransfer(&u->rxDmaHandle);
+
+    LPUART_EnableRxDMA(u->base, true);
+    LPUART_EnableInterrupts(u->base, kLPUART_IdleLineInterruptEnable | kLPUART_RxOverrunInterruptEnable);
 }
 
-status_t DataUart_SendNonBlocking_FI(data_uart_t *u, const uint8_t *data, size_t len)
+uint32_t DataUart_RxHead(data_uart_t *u)
 {
-    lpuart_transfer_t xfer;
+    uint32_t wraps;
+    uint32_t remaining;
 
-    /* Inject API failure: return TxBusy without calling the driver. */
-#if SFI_ENABLED
+    /* Re-read if the wrap IRQ ran in between. */
+    do
     {
-        fi_site_cfg_t *cfg = FI_SiteCfg(FI_SITE_TX_API_FAIL);
-        bool fire = FI_ShouldFire(FI_SITE_TX_API_FAIL);
-        if (cfg)
-        {
-            FI_Log(FI_SITE_TX_API_FAIL, fire, cfg->hit_count, (uint32_t)len, (uint32_t)(len ? data[0] : 0U));
-        }
-        if (fire)
-        {
-            return kStatus_LPUART_TxBusy;
-        }
+        wraps = u->rxWraps;
+        remaining = EDMA_GetRemainingMajorLoopCount(u->rxDma, u->rxDmaChannel);
+    } while (wraps != u->rxWraps);
+
+    uint32_t head = (wraps * u->rxRingSize) + (u->rxRingSize - remaining);
+
+    /* CITER reloaded but the wrap IRQ is still pending: head went backwards. */
+    if ((int32_t)(head - u->rxLastHead) < 0)
+    {
+        head += u->rxRingSize;
     }
-#endif
+    u->rxLastHead = head;
+    return head;
+}
 
-#if SFI_ENABLED
-    /* Inject TX stall (lost completion): arm a one-transfer stall when site is active. */
+bool DataUart_RxReady(data_uart_t *u)
+{
+    return u->rxIdle || ((DataUart_RxHead(u) - u->rxTail) >= (u->rxRingSize / 2U));
+}
+
+size_t DataUart_RxPeek(data_uart_t *u, uint8_t **data)
+{
+    /* Before the head: an idle after this read stays pending. */
+    u->rxIdle = false;
+
+    uint32_t head = DataUart_RxHead(u);
+    uint32_t avail = head - u->rxTail;
+
+    if (avail > u->rxRingSize)
     {
-        fi_site_cfg_t *cfg = FI_SiteCfg(FI_SITE_TX_STALL);
-        bool fire = FI_ShouldFire(FI_SITE_TX_STALL);
-        if (cfg)
-        {
-            FI_Log(FI_SITE_TX_STALL, fire, cfg->hit_count, (uint32_t)len, (uint32_t)(len ? data[0] : 0U));
-        }
-        u->txStallActive = fire;
+        /* Lapped: the unread bytes were overwritten while we read them. */
+        u->rxOverruns++;
+        u->rxLostBytes += avail;
+        u->rxTail = head;
+        return 0;
     }
+
+    uint32_t off = u->rxTail & (u->rxRingSize - 1U);
+    uint32_t n = u->rxRingSize - off;
+    if (n > avail) n = avail;
+
+    *data = &u->rxRing[off];
+    return n;
+}
+
+void DataUart_RxConsume(data_uart_t *u, size_t n)
+{
+    u->rxTail += (uint32_t)n;
+}
+
+status_t DataUart_SendNonBlocking(data_uart_t *u, const uint8_t *data, size_t len, bool stall)
+{
+    lpuart_transfer_t xfer;
+
+#if SFI_ENABLED
+    /* TX stall (lost completion): the callback keeps txOnGoing for this transfer */
+    u->txStallActive = stall;
 #else
+    (void)stall;
     u->txStallActive = false;
 #endif
 
@@ -5,6 +5,8 @@
 #include <stdbool.h>
 
 #include "fsl_lpuart.h"
+#include "fsl_edma.h"
+#include "fsl_dmamux.h"
 #include "fi.h"
 
 typedef struct
@@ -12,27 +14,62 @@ typedef struct
     LPUART_Type *base;
     lpuart_handle_t handle;
 
-    volatile bool rxOnGoing;
     volatile bool txOnGoing;
-    volatile bool rxByteReady;
-
-    uint8_t rxByte;
 
     /* TX stall simulation */
     volatile bool txStallActive;
 
+    /* Circular eDMA RX: the DMA writes rxRing forever (DLAST wraps the
+     * destination), the consumer follows with a free-running tail index. */
+    edma_handle_t rxDmaHandle;
+    DMA_Type *rxDma;
+    uint32_t rxDmaChannel;
+    uint8_t *rxRing;
+    uint32_t rxRingSize;            /* power of two */
+    volatile uint32_t rxWraps;      /* major-loop completions (DMA IRQ) */
+    uint32_t rxLastHead;
+    uint32_t rxTail;
+
+    /* RX diagnostics */
+    volatile bool rxIdle;           /* idle line seen since last RxPeek (IRQ) */
+    volatile uint32_t rxIdleEvents;
+    volatile uint32_t rxHwOverruns; /* LPUART OR flag */
+    uint32_t rxOverruns;            /* consumer lapped by the DMA */
+    uint32_t rxLostBytes;
+
 } data_uart_t;
 
 void DataUart_Init(data_uart_t *u, LPUART_Type *base, uint32_t clkHz, uint32_t baud);
 
-/* Non-blocking, 1-byte RX "pump" */
-status_t DataUart_StartReceive1(data_uart_t *u);
+/* Call from the LPUART IRQ handler: idle line and overrun flags, then the
+ * SDK handle (TX). */
+void DataUart_IRQHandler(data_uart_t *u);
+
+/* Start continuous RX into ring (non-cacheable, ringSize a power of two).
+ * Initialises DMAMUX/eDMA and enables the idle-line and overrun IRQs. */
+void DataUart_StartRxDma(data_uart_t *u, DMA_Type *dma, DMAMUX_Type *mux,
+                         uint32_t channel, uint32_t request,
+                         uint8_t *ring, uint32_t ringSize);
+
+/* Free-running count of bytes written by the DMA. */
+uint32_t DataUart_RxHead(data_uart_t *u);
+
+/* Worth draining: the line went idle (end of a burst) or half the ring is
+ * unread. */
+bool DataUart_RxReady(data_uart_t *u);
+
+/* Contiguous span of unread bytes starting at the tail (0 if none). Call
+ * again after DataUart_RxConsume to get the part after the ring wrap.
+ * The span may be modified in place (FI). An overrun drops all unread bytes. */
+size_t DataUart_RxPeek(data_uart_t *u, uint8_t **data);
+void DataUart_RxConsume(data_uart_t *u, size_t n);
 
-/* TX wrapper that can inject API failure / stall */
-status_t DataUart_SendNonBlocking_FI(data_uart_t *u, const uint8_t *data, size_t len);
+/* Non-blocking send; stall loses the completion of this transfer (the
+ * link's txstall site decides, sfi_link.c) */
+status_t DataUart_SendNonBlocking(data_uart_t *u, const uint8_t *data, size_t len, bool stall);
 
 /* Progress tracking for stall monitor */
 status_t DataUart_GetSendCount(data_uart_t *u, uint32_t *count);
 void DataUart_AbortSend(data_uart_t *u);
 
-#endif /* DATA_UART_H */
\ No newline at end of file
+#endif /* DATA_UART_H */
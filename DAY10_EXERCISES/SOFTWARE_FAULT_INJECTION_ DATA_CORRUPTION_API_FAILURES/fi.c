@@ -2,158 +2,110 @@
 
 #if SFI_ENABLED
 
-#ifndef FI_LOG_DEPTH
-#define FI_LOG_DEPTH 128
-#endif
-
-static volatile uint32_t g_now_ms;
-static fi_site_cfg_t g_sites[FI_SITE_COUNT];
-static fi_event_t g_log[FI_LOG_DEPTH];
-static volatile uint32_t g_log_wr;
-
-static uint32_t g_rng;
-
-static uint32_t xorshift32(uint32_t x)
-{
-    /* Deterministic and fast. */
-    x ^= x << 13;
-    x ^= x >> 17;
-    x ^= x << 5;
-    return x;
-}
-
 void FI_Init(uint32_t seed)
 {
-    g_now_ms = 0;
-    g_rng = (seed == 0U) ? 0xA5A5A5A5U : seed;
+    FICore_Init(seed);
+    FICore_SetClock(NULL);
+    FICore_SetNowMs(0U);
 
-    for (int i = 0; i < (int)FI_SITE_COUNT; i++)
+    /* Default arming from the site registrations (exercise spec values
+     * live next to each injection point). Unregistered sites stay off. */
+    FI_SITES_FOREACH(d)
     {
-        g_sites[i].policy = FI_POLICY_DISABLED;
-        g_sites[i].every_n = 0;
-        g_sites[i].window_start = 0;
-        g_sites[i].window_end = 0;
-        g_sites[i].hit_count = 0;
-        g_sites[i].fire_count = 0;
-        g_sites[i].bits_to_flip = 1;
+        if (d->id < FI_SITE_COUNT && FI_SiteIsFirst(d))
+        {
+            FICore_ArmDefault(d, 100U, 0U);
+        }
     }
-
-    /* Default arming matching the exercise spec */
-    g_sites[FI_SITE_RX_CORRUPT].policy = FI_POLICY_EVERY_N;
-    g_sites[FI_SITE_RX_CORRUPT].every_n = 200;
-    g_sites[FI_SITE_RX_CORRUPT].bits_to_flip = 3;
-
-    g_sites[FI_SITE_TX_API_FAIL].policy = FI_POLICY_EVERY_N;
-    g_sites[FI_SITE_TX_API_FAIL].every_n = 100;
-
-    g_sites[FI_SITE_TX_STALL].policy = FI_POLICY_WINDOW;
-    g_sites[FI_SITE_TX_STALL].window_start = 500;
-    g_sites[FI_SITE_TX_STALL].window_end   = 520;
-
-    /* Optional: you can arm label/parity tampers from CLI */
-    g_sites[FI_SITE_A429_LABEL_TAMPER].policy = FI_POLICY_DISABLED;
-    g_sites[FI_SITE_A429_PARITY_TAMPER].policy = FI_POLICY_DISABLED;
-
-    g_log_wr = 0;
 }
 
-void FI_SetNowMs(uint32_t now_ms) { g_now_ms = now_ms; }
-uint32_t FI_NowMs(void) { return g_now_ms; }
+void FI_SetNowMs(uint32_t now_ms) { FICore_SetNowMs(now_ms); }
+uint32_t FI_NowMs(void) { return FICore_NowMs(); }
 
-fi_site_cfg_t *FI_SiteCfg(fi_site_t site)
+uint8_t FI_CorruptByteDeterministic(uint8_t in)
 {
-    if ((int)site < 0 || site >= FI_SITE_COUNT) return (fi_site_cfg_t *)0;
-    return &g_sites[site];
-}
+    /* Flip param bits (default 1) at RNG-chosen positions. */
+    const fi_core_site_t *s = FICore_Site(FI_SITE_RX_CORRUPT);
+    uint8_t out = in;
 
-void FI_DisableAll(void)
-{
-    for (int i = 0; i < (int)FI_SITE_COUNT; i++)
+    const uint8_t flips = (s && s->cfg.param) ? s->cfg.param : 1U;
+    for (uint8_t i = 0; i < flips; i++)
     {
-        g_sites[i].policy = FI_POLICY_DISABLED;
+        uint32_t r = FICore_Rand32();
+        uint8_t bit = (uint8_t)(r & 0x7U);
+        out ^= (uint8_t)(1U << bit);
     }
+    return out;
 }
 
-uint32_t FI_Rand32(void)
+const char *FI_SiteName(fi_site_t site)
 {
-    g_rng = xorshift32(g_rng);
-    return g_rng;
+    const fi_site_desc_t *d = FI_SiteById((uint32_t)site);
+    return d ? d->name : "?";
 }
 
-bool FI_ShouldFire(fi_site_t site)
+/* Tiny formatters so the dump needs neither stdio nor the debug console */
+static char *put_str(char *p, const char *s)
 {
-    fi_site_cfg_t *cfg = FI_SiteCfg(site);
-    if (!cfg) return false;
-
-    cfg->hit_count++;
+    while (*s != '\0') *p++ = *s++;
+    return p;
+}
 
-    bool fire = false;
-    switch (cfg->policy)
+static char *put_dec(char *p, uint32_t v)
+{
+    char tmp[10];
+    uint32_t n = 0;
+    do
     {
-        case FI_POLICY_DISABLED:
-            fire = false;
-            break;
-        case FI_POLICY_EVERY_N:
-            fire = (cfg->every_n != 0U) && ((cfg->hit_count % cfg->every_n) == 0U);
-            break;
-        case FI_POLICY_WINDOW:
-            fire = (cfg->hit_count >= cfg->window_start) && (cfg->hit_count < cfg->window_end);
-            break;
-        default:
-            fire = false;
-            break;
-    }
-
-    if (fire) cfg->fire_count++;
-    return fire;
+        tmp[n++] = (char)('0' + (v % 10U));
+        v /= 10U;
+    } while (v != 0U);
+    while (n != 0U) *p++ = tmp[--n];
+    return p;
 }
 
-uint8_t FI_CorruptByteDeterministic(uint8_t in)
+static char *put_hex8(char *p, uint32_t v)
 {
-    /* Flip cfg->bits_to_flip bits deterministically based on RNG. */
-    fi_site_cfg_t *cfg = FI_SiteCfg(FI_SITE_RX_CORRUPT);
-    uint8_t out = in;
-
-    const uint8_t flips = (cfg && cfg->bits_to_flip) ? cfg->bits_to_flip : 1U;
-    for (uint8_t i = 0; i < flips; i++)
+    for (int sh = 28; sh >= 0; sh -= 4)
     {
-        uint32_t r = FI_Rand32();
-        uint8_t bit = (uint8_t)(r & 0x7U);
-        out ^= (uint8_t)(1U << bit);
+        *p++ = "0123456789ABCDEF"[(v >> sh) & 0xFU];
     }
-    return out;
+    return p;
 }
 
-void FI_Log(fi_site_t site, bool fired, uint32_t hit, uint32_t extra, uint32_t data_peek)
+void FI_DumpLog(void (*emit)(const char *s))
 {
-    uint32_t idx = g_log_wr++;
-    fi_event_t *e = &g_log[idx % FI_LOG_DEPTH];
-    e->ts_ms = FI_NowMs();
-    e->site = (uint8_t)site;
-    e->fired = fired ? 1U : 0U;
-    e->hit = hit;
-    e->extra = extra;
-    e->data_peek = data_peek;
-}
+    char line[96];
+    char *p;
+    fi_core_event_t e;
+    uint32_t n = 0;
 
-static const char *site_name(fi_site_t s)
-{
-    switch (s)
+    while (FICore_LogRead(&e))
     {
-        case FI_SITE_RX_CORRUPT: return "RX_CORRUPT";
-        case FI_SITE_A429_LABEL_TAMPER: return "A429_LABEL_TAMPER";
-        case FI_SITE_A429_PARITY_TAMPER: return "A429_PARITY_TAMPER";
-        case FI_SITE_TX_API_FAIL: return "TX_API_FAIL";
-        case FI_SITE_TX_STALL: return "TX_STALL";
-        default: return "?";
+        p = put_str(line, "  t=");
+        p = put_dec(p, e.tsMs);
+        p = put_str(p, " ctx=");
+        p = put_dec(p, e.ctx);
+        p = put_str(p, " site=");
+        p = put_str(p, FI_SiteName((fi_site_t)e.site));
+        p = put_str(p, " hit=");
+        p = put_dec(p, e.hit);
+        p = put_str(p, " extra=");
+        p = put_dec(p, e.extra);
+        p = put_str(p, " data=0x");
+        p = put_hex8(p, e.data);
+        *p = '\0';
+        emit(line);
+        n++;
     }
-}
 
-void FI_DumpLog(void (*emit)(const char *s))
-{
-    /* Very small footprint dump; caller formats. */
-    (void)emit;
-    /* Implemented in main via PRINTF for convenience; keep this module RTOS-agnostic. */
+    p = put_str(line, "log: ");
+    p = put_dec(p, n);
+    p = put_str(p, " records, ");
+    p = put_dec(p, FICore_LogDrops());
+    p = put_str(p, " dropped (total)");
+    *p = '\0';
+    emit(line);
 }
 
 #else /* SFI_ENABLED == 0 */
@@ -161,15 +113,8 @@ void FI_DumpLog(void (*emit)(const char *s))
 void FI_Init(uint32_t seed) { (void)seed; }
 void FI_SetNowMs(uint32_t now_ms) { (void)now_ms; }
 uint32_t FI_NowMs(void) { return 0; }
-fi_site_cfg_t *FI_SiteCfg(fi_site_t site) { (void)site; return (fi_site_cfg_t *)0; }
-void FI_DisableAll(void) {}
-bool FI_ShouldFire(fi_site_t site) { (void)site; return false; }
+const char *FI_SiteName(fi_site_t site) { (void)site; return "?"; }
 uint8_t FI_CorruptByteDeterministic(uint8_t in) { return in; }
-uint32_t FI_Rand32(void) { return 0; }
-void FI_Log(fi_site_t site, bool fired, uint32_t hit, uint32_t extra, uint32_t data_peek)
-{
-    (void)site; (void)fired; (void)hit; (void)extra; (void)data_peek;
-}
 void FI_DumpLog(void (*emit)(const char *s)) { (void)emit; }
 
-#endif
\ No newline at end of file
+#endif
@@ -8,6 +8,15 @@
 #define SFI_ENABLED 1
 #endif
 
+/* Decisions, triggers, counters and the event log come from
+ * common/fi_core.h with site = fi_site_t. Sites register name and default
+ * policy next to their injection point (FI_SITE_REGISTER, policy = an
+ * FICore_ArmArgs policy); FI_Init, the CLI and 'fi dump' read the
+ * registry. */
+#define FI_SITE_REGISTRY SFI_ENABLED
+#include "../common/fi_core.h"
+
+/* Site ids: stable numbers for the log; names live in the registrations. */
 typedef enum
 {
     FI_SITE_RX_CORRUPT = 0,
@@ -19,59 +28,21 @@ typedef enum
     FI_SITE_COUNT
 } fi_site_t;
 
-typedef enum
-{
-    FI_POLICY_DISABLED = 0,
-    FI_POLICY_EVERY_N,
-    FI_POLICY_WINDOW
-} fi_policy_t;
-
-typedef struct
-{
-    fi_policy_t policy;
-    uint32_t every_n;        /* for EVERY_N */
-    uint32_t window_start;   /* for WINDOW (inclusive) */
-    uint32_t window_end;     /* for WINDOW (exclusive) */
-
-    uint32_t hit_count;
-    uint32_t fire_count;
-
-    /* Optional parameters per site */
-    uint8_t bits_to_flip;    /* RX_CORRUPT */
-    uint8_t reserved;
-    uint16_t reserved2;
-} fi_site_cfg_t;
-
-typedef struct
-{
-    uint32_t ts_ms;
-    uint8_t site;
-    uint8_t fired;
-    uint16_t spare;
-    uint32_t hit;
-    uint32_t extra;
-    uint32_t data_peek;
-} fi_event_t;
-
+/* Core reset plus the registered defaults (exercise spec). */
 void FI_Init(uint32_t seed);
 
 /* Timebase hookup (ms). Call once from PIT ISR or your time source. */
 void FI_SetNowMs(uint32_t now_ms);
 uint32_t FI_NowMs(void);
 
-/* Configuration */
-fi_site_cfg_t *FI_SiteCfg(fi_site_t site);
-void FI_DisableAll(void);
-
-/* Decision */
-bool FI_ShouldFire(fi_site_t site);
+const char *FI_SiteName(fi_site_t site);
 
 /* Helpers */
-uint8_t FI_CorruptByteDeterministic(uint8_t in);
-uint32_t FI_Rand32(void);
+uint8_t FI_CorruptByteDeterministic(uint8_t in); /* RX_CORRUPT param bits */
 
-/* Logging */
-void FI_Log(fi_site_t site, bool fired, uint32_t hit, uint32_t extra, uint32_t data_peek);
+/* Logging: reads (consumes) the pending fi_core log records, one text
+ * line per record plus a summary line, without line endings. Same reader
+ * as the binary drain (common/fi_logstream.h): use one or the other. */
 void FI_DumpLog(void (*emit)(const char *s));
 
-#endif /* FI_H */
\ No newline at end of file
+#endif /* FI_H */
@@ -8,38 +8,15 @@
 #include "fsl_pit.h"
 
 #include "fi.h"
-#include "a429_frame.h"
+#include "sfi_link.h"
+#include "sfi_camp.h"
 #include "data_uart.h"
+#include "../common/fi_logstream.h"
 
 /* -------------------------------
  * User LED macros come from board.h in the imported example.
  * ------------------------------- */
 
-/* -------------------------------
- * Simple ACK on data UART to exercise TX path
- * ------------------------------- */
-#define ACK_SYNC 0xACU
-
-typedef enum
-{
-    ACK_OK = 0,
-    ACK_BAD_CHK = 1,
-    ACK_BAD_PARITY = 2,
-    ACK_BAD_PLAUS = 3,
-    ACK_BAD_LEN = 4,
-    ACK_TX_DROP = 5,
-} ack_reason_t;
-
-typedef struct
-{
-    uint8_t b[2];
-    uint8_t len;
-} ack_msg_t;
-
-#define ACK_Q_DEPTH 32
-static ack_msg_t g_ackQ[ACK_Q_DEPTH];
-static volatile uint32_t g_ackWr = 0, g_ackRd = 0;
-
 static bool Console_TryReadChar(char *out)
 {
     int c = DbgConsole_Getchar();   /* returns -1 if no char available */
@@ -51,37 +28,6 @@ static bool Console_TryReadChar(char *out)
     return true;
 }
 
-static bool AckQ_Push(ack_reason_t r)
-{
-    uint32_t wr = g_ackWr;
-    uint32_t rd = g_ackRd;
-    if ((wr - rd) >= ACK_Q_DEPTH)
-    {
-        return false;
-    }
-
-    ack_msg_t *m = &g_ackQ[wr % ACK_Q_DEPTH];
-    m->b[0] = ACK_SYNC;
-    m->b[1] = (uint8_t)r;
-    m->len = 2;
-
-    g_ackWr = wr + 1;
-    return true;
-}
-
-static bool AckQ_Peek(ack_msg_t *out)
-{
-    uint32_t rd = g_ackRd;
-    if (rd == g_ackWr) return false;
-    *out = g_ackQ[rd % ACK_Q_DEPTH];
-    return true;
-}
-
-static void AckQ_Pop(void)
-{
-    if (g_ackRd != g_ackWr) g_ackRd++;
-}
-
 /* -------------------------------
  * Timebase via PIT
  * ------------------------------- */
@@ -111,64 +57,83 @@ static void Pit10ms_Init(void)
     PIT_StartTimer(DEMO_PIT_BASEADDR, DEMO_PIT_CHANNEL);
 }
 
-/* -------------------------------
- * Plausibility barrier
- * ------------------------------- */
-static uint8_t g_allowLabel[256];
-static uint32_t g_lastLabelMs[256];
-static const uint32_t g_minLabelIntervalMs = 20U; /* 50 Hz */
-
-static void Plausibility_Init(void)
-{
-    memset(g_allowLabel, 0, sizeof(g_allowLabel));
-    memset(g_lastLabelMs, 0, sizeof(g_lastLabelMs));
-
-    /* Allow-list example: change to your real labels. */
-    g_allowLabel[0x01] = 1;
-    g_allowLabel[0x02] = 1;
-    g_allowLabel[0x03] = 1;
-    g_allowLabel[0x04] = 1;
-}
-
-static bool Plausibility_Accept(uint8_t label)
-{
-    if (!g_allowLabel[label]) return false;
-
-    uint32_t now = g_ms;
-    uint32_t last = g_lastLabelMs[label];
-    if ((now - last) < g_minLabelIntervalMs)
-    {
-        return false;
-    }
-    g_lastLabelMs[label] = now;
-    return true;
-}
-
 /* -------------------------------
  * Simple CLI (non-blocking) on debug console
  * Commands:
- *   fi dump
- *   fi arm rx every <N> bits <M>
+ *   fi dump                        (site counters + pending log as text)
+ *   fi drain [off]                 (pending log as binary FIL1 blocks)
+ *   fi cov [reset]                 (per-site detection coverage / escapes)
+ *   fi rec [stop|dump|load <off> <hex>]   (record every FI decision)
+ *   fi replay [stop]               (decisions from the recording)
+ *   fi arm rx every <N> bits <M>   (N counts RX chunks, not bytes)
  *   fi arm txbusy every <N>
- *   fi arm txstall window <S> <E>
+ *   fi arm txstall window <S> <E>  (hits from now)
  *   fi arm label every <N>
  *   fi arm parity every <N>
+ *   fi arm <site> prob|nth|burst|time|always|off ...   (FICore_ArmArgs)
+ *   fi model [off | ge <PGB> <PBG> [<EBAD> [<EGOOD>]] | stuck <MASK> <VAL> [<LEN>]
+ *            | drop|ins|dup [<PPM>] | slip <BITS> [<LEN>]]
+ *                                  (what an rx fire does, common/fi_corrupt.h)
  *   fi off
+ *   fi camp add <step>[; <step>...] | clear | demo | list | run | stop | stat
  * ------------------------------- */
 
 static char g_cliLine[96];
 static uint32_t g_cliLen = 0;
 
+/* Binary FI log drain ('fi drain') on the console UART, interleaved with
+ * the text output between blocks; host/fi_logdump.c decodes a raw capture
+ * of the console. Telemetry waits while a block is half written; all other
+ * text (CLI replies, campaign results, the TX stall note) goes through
+ * console_text_begin, which finishes the block first. */
+static filog_drain_t g_logDrain;
+static bool g_logDrainOn = false;
+
+static void cli_campaign(int argc, char **argv);
+static void cli_coverage(int argc, char **argv);
+static void cli_record(int argc, char **argv);
+static void cli_model(int argc, char **argv);
+
+static void dump_emit(const char *s)
+{
+    PRINTF("%s\r\n", s);
+}
+
+/* Never waits for the line: takes what the TX data register accepts now */
+static size_t console_write_nb(void *user, const uint8_t *p, size_t n)
+{
+    size_t i = 0;
+    (void)user;
+    while ((i < n) && ((LPUART_GetStatusFlags(DEMO_LPUART) & (uint32_t)kLPUART_TxDataRegEmptyFlag) != 0U))
+    {
+        LPUART_WriteByte(DEMO_LPUART, p[i++]);
+    }
+    return i;
+}
+
+/* Call before any PRINTF that cannot wait for the next pass: writes the
+ * rest of a half-sent block (at most FILOG_BLOCK_MAX bytes, ~13 ms at
+ * 115200) so the text does not split it. */
+static void console_text_begin(void)
+{
+    while (FILog_DrainBusy(&g_logDrain))
+    {
+        (void)FILog_DrainPoll(&g_logDrain, console_write_nb, NULL);
+    }
+}
+
 static void cli_print_cfg(void)
 {
 #if SFI_ENABLED
     PRINTF("\r\nSFI sites:\r\n");
-    for (int i = 0; i < (int)FI_SITE_COUNT; i++)
+    FI_SITES_FOREACH(d)
     {
-        fi_site_cfg_t *c = FI_SiteCfg((fi_site_t)i);
-        if (!c) continue;
-        PRINTF("  site %d: policy=%d hit=%lu fire=%lu every=%lu win=[%lu,%lu) bits=%u\r\n",
-               i, (int)c->policy, c->hit_count, c->fire_count, c->every_n, c->window_start, c->window_end, c->bits_to_flip);
+        const fi_core_site_t *s = FICore_Site(d->id);
+        if (!s || d->id >= FI_SITE_COUNT || !FI_SiteIsFirst(d)) continue;
+        PRINTF("  site %d %-8s: %-6s hit=%lu fire=%lu n=%lu win=[%lu,%lu) pct=%u bits=%u%s\r\n",
+               (int)d->id, d->name, FICore_TrigName(s->cfg.trig), s->hits, s->fires, s->cfg.n,
+               s->cfg.a, s->cfg.b, s->cfg.pct, s->cfg.param,
+               (s->cfg.flags & FI_CORE_F_TIME_GATE) ? " timed" : "");
     }
 #else
     PRINTF("\r\nSFI_DISABLED build.\r\n");
@@ -200,15 +165,50 @@ static void cli_handle_line(const char *line)
 
     if (argc >= 2 && strcmp(argv[1], "dump") == 0)
     {
-        /* Dump a short snapshot of site counters; event log dump kept minimal */
+        /* Site counters, then the pending log records as text */
         cli_print_cfg();
+        PRINTF("\r\n");
+        FI_DumpLog(dump_emit);
+        return;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "drain") == 0)
+    {
+        g_logDrainOn = !(argc >= 3 && strcmp(argv[2], "off") == 0);
+        PRINTF("\r\nLog drain %s: blocks=%lu records=%lu pending=%lu dropped=%lu\r\n",
+               g_logDrainOn ? "on" : "off", g_logDrain.blocks, g_logDrain.records,
+               FICore_LogPending(), FICore_LogDrops());
+        return;
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "camp") == 0)
+    {
+        cli_campaign(argc, argv);
+        return;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "cov") == 0)
+    {
+        cli_coverage(argc, argv);
+        return;
+    }
+
+    if (argc >= 2 && (strcmp(argv[1], "rec") == 0 || strcmp(argv[1], "replay") == 0))
+    {
+        cli_record(argc, argv);
+        return;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "model") == 0)
+    {
+        cli_model(argc, argv);
         return;
     }
 
     if (argc >= 2 && strcmp(argv[1], "off") == 0)
     {
 #if SFI_ENABLED
-        FI_DisableAll();
+        FICore_DisarmAll();
         PRINTF("\r\nSFI disabled (all sites).\r\n");
 #endif
         return;
@@ -217,56 +217,52 @@ static void cli_handle_line(const char *line)
     if (argc >= 3 && strcmp(argv[1], "arm") == 0)
     {
 #if SFI_ENABLED
-        fi_site_t site = FI_SITE_COUNT;
-        if (strcmp(argv[2], "rx") == 0) site = FI_SITE_RX_CORRUPT;
-        else if (strcmp(argv[2], "txbusy") == 0) site = FI_SITE_TX_API_FAIL;
-        else if (strcmp(argv[2], "txstall") == 0) site = FI_SITE_TX_STALL;
-        else if (strcmp(argv[2], "label") == 0) site = FI_SITE_A429_LABEL_TAMPER;
-        else if (strcmp(argv[2], "parity") == 0) site = FI_SITE_A429_PARITY_TAMPER;
-
-        if (site == FI_SITE_COUNT)
+        const fi_site_desc_t *d = FI_SiteByName(argv[2]);
+        fi_site_t site = d ? (fi_site_t)d->id : FI_SITE_COUNT;
+
+        if (site >= FI_SITE_COUNT)
         {
-            PRINTF("\r\nUnknown site. Use: rx|txbusy|txstall|label|parity\r\n");
+            PRINTF("\r\nUnknown site. Use:");
+            FI_SITES_FOREACH(e)
+            {
+                if (FI_SiteIsFirst(e)) PRINTF(" %s", e->name);
+            }
+            PRINTF("\r\n");
             return;
         }
 
-        fi_site_cfg_t *c = FI_SiteCfg(site);
-        if (!c) return;
+        int policy = (argc >= 4) ? FICore_ArmPolicyId(argv[3]) : -1;
+        uint32_t v[3] = {0U, 0U, 0U};
+        uint32_t nv = 0;
 
-        if (argc >= 5 && strcmp(argv[3], "every") == 0)
+        /* Numbers in order; "bits" is only a label for the param value */
+        for (int i = 4; i < argc && nv < 3U; i++)
         {
-            c->policy = FI_POLICY_EVERY_N;
-            c->every_n = (uint32_t)strtoul(argv[4], NULL, 0);
-            if (site == FI_SITE_RX_CORRUPT && argc >= 7 && strcmp(argv[5], "bits") == 0)
-            {
-                c->bits_to_flip = (uint8_t)strtoul(argv[6], NULL, 0);
-            }
-            PRINTF("\r\nArmed site %d EVERY %lu\r\n", (int)site, c->every_n);
-            return;
+            if (strcmp(argv[i], "bits") == 0) continue;
+            v[nv++] = (uint32_t)strtoul(argv[i], NULL, 0);
         }
-        if (argc >= 6 && strcmp(argv[3], "window") == 0)
+
+        if (policy >= 0 && FICore_ArmArgs(site, policy, v))
         {
-            c->policy = FI_POLICY_WINDOW;
-            c->window_start = (uint32_t)strtoul(argv[4], NULL, 0);
-            c->window_end   = (uint32_t)strtoul(argv[5], NULL, 0);
-            PRINTF("\r\nArmed site %d WINDOW [%lu,%lu)\r\n", (int)site, c->window_start, c->window_end);
+            PRINTF("\r\nArmed site %s %s %lu %lu %lu\r\n", FI_SiteName(site),
+                   FICore_ArmPolicyName(policy), v[0], v[1], v[2]);
             return;
         }
 
-        PRINTF("\r\nUsage: fi arm <site> every <N> [bits <M>] | fi arm txstall window <S> <E>\r\n");
+        PRINTF("\r\nUsage: fi arm <site> every <N> [bits <M>] | window <S> <E> | prob <P> | nth <N> | burst <N> <L> | time <T0> <T1> | always | off\r\n");
 #else
         PRINTF("\r\nSFI_DISABLED build.\r\n");
 #endif
         return;
     }
 
-    PRINTF("\r\nUsage: fi dump | fi arm ... | fi off\r\n");
+    PRINTF("\r\nUsage: fi dump | fi drain [off] | fi arm ... | fi camp ... | fi cov [reset] | fi rec ... | fi replay [stop] | fi model ... | fi off\r\n");
 }
 
 static void cli_poll(void)
 {
     char ch;
-    if (Console_TryReadChar(&ch) != kStatus_Success)
+    if (!Console_TryReadChar(&ch))
     {
         return;
     }
@@ -276,6 +272,7 @@ static void cli_poll(void)
         if (g_cliLen > 0)
         {
             g_cliLine[g_cliLen] = '\0';
+            console_text_begin();
             cli_handle_line(g_cliLine);
             g_cliLen = 0;
         }
@@ -293,69 +290,423 @@ static void cli_poll(void)
  * ------------------------------- */
 
 static data_uart_t g_dataUart;
-static a429_uart_parser_t g_parser;
 
-/* Counters */
-static uint32_t rx_ok = 0;
-static uint32_t rx_bad_chk = 0;
-static uint32_t rx_bad_parity = 0;
-static uint32_t rx_bad_plaus = 0;
-static uint32_t rx_bad_len = 0;
+void DATA_LPUART_IRQHandler(void)
+{
+    DataUart_IRQHandler(&g_dataUart);
+    SDK_ISR_EXIT_BARRIER;
+}
 
-static uint32_t tx_retries = 0;
-static uint32_t tx_failures = 0;
-static uint32_t tx_recoveries = 0;
-static uint32_t tx_drops = 0;
+/* Barriers, ACK queue, TX retry / stall recovery and the RX injection
+ * sites (sfi_link.c); host/sfi_sim.c runs the same link without a board. */
+static sfi_link_t g_link;
+static const uint32_t g_minLabelIntervalMs = 20U; /* 50 Hz */
 
-/* TX stall monitor */
-static uint32_t g_tx_last_progress_ms = 0;
-static uint32_t g_tx_last_send_count = 0;
-static uint32_t g_tx_last_checked_ms = 0;
+/* RX ring (written by eDMA, so keep it out of the D-cache) */
+AT_NONCACHEABLE_SECTION_ALIGN(static uint8_t g_rxRing[DATA_UART_RX_RING_SIZE], 32);
 
-static void telemetry_print_1s(void)
+/* -------------------------------
+ * Data UART as the link's TX path
+ * ------------------------------- */
+static sfi_tx_status_t link_tx_send(void *ctx, const uint8_t *data, size_t len, bool stall)
 {
-    static uint32_t last = 0;
-    if ((g_ms - last) >= 1000U)
+    data_uart_t *u = (data_uart_t *)ctx;
+    status_t st = DataUart_SendNonBlocking(u, data, len, stall);
+
+    if (st == kStatus_Success) return SFI_TX_STARTED;
+    if (st == kStatus_LPUART_TxBusy)
     {
-        last = g_ms;
-        PRINTF("\r\n[%lu ms] rx_ok=%lu bad_chk=%lu bad_parity=%lu bad_plaus=%lu bad_len=%lu | tx_retry=%lu tx_fail=%lu tx_recov=%lu tx_drop=%lu\r\n",
-               g_ms, rx_ok, rx_bad_chk, rx_bad_parity, rx_bad_plaus, rx_bad_len,
-               tx_retries, tx_failures, tx_recoveries, tx_drops);
+        u->txOnGoing = false; /* because we did not actually start the driver */
+        return SFI_TX_BUSY;
+    }
+    return SFI_TX_FAILED;
+}
+
+static bool link_tx_busy(void *ctx)
+{
+    return ((data_uart_t *)ctx)->txOnGoing;
+}
+
+static bool link_tx_send_count(void *ctx, uint32_t *count)
+{
+    return DataUart_GetSendCount((data_uart_t *)ctx, count) == kStatus_Success;
+}
+
+static void link_tx_abort(void *ctx)
+{
+    DataUart_AbortSend((data_uart_t *)ctx);
+}
+
+static const sfi_tx_ops_t s_linkTx = {
+    .ctx        = &g_dataUart,
+    .send       = link_tx_send,
+    .busy       = link_tx_busy,
+    .send_count = link_tx_send_count,
+    .abort      = link_tx_abort,
+};
+
+static void link_event(void *ctx, sfi_link_ev_t ev, uint32_t arg)
+{
+    (void)ctx;
+    switch (ev)
+    {
+        case SFI_EV_RX_OK:
+            USER_LED_OFF();
+            break;
+        case SFI_EV_RX_BAD:
+            USER_LED_ON();
+            break;
+        case SFI_EV_INJECT:
+            USER_LED_TOGGLE();
+            break;
+        case SFI_EV_TX_STALL:
+            console_text_begin();
+            PRINTF("\r\nTX stall detected at %lu ms (send_count=%lu). Aborting and retrying.\r\n", g_ms, arg);
+            break;
+        default:
+            break;
+    }
+}
+
+/* -------------------------------
+ * FI coverage table ('fi cov', campaign end)
+ * ------------------------------- */
+#if SFI_ENABLED
+
+static void cov_print_permille(int32_t v)
+{
+    if (v < 0) PRINTF("     -");
+    else PRINTF(" %3ld.%ld", v / 10, v % 10);
+}
+
+static void cov_print_row(const char *name, const fio_site_stats_t *s)
+{
+    const uint32_t det = s->outcome[FIO_DETECTED];
+
+    PRINTF("  %-8s %6lu %5lu %5lu %5lu", name, s->fired, det, s->outcome[FIO_ESCAPED], s->outcome[FIO_MASKED]);
+    cov_print_permille(FIOutcome_CoveragePermille(s));
+    cov_print_permille(FIOutcome_EscapePermille(s));
+    PRINTF("  %5lu/%-5lu %5lu/%-5lu", det ? (s->latMsSum / det) : 0U, s->latMsMax,
+           det ? (s->latBytesSum / det) : 0U, s->latBytesMax);
+    for (uint32_t b = 0; b < COV_B_COUNT; b++)
+    {
+        if (s->byBarrier[b] != 0U) PRINTF(" %s=%lu", SfiLink_BarrierName(b), s->byBarrier[b]);
+    }
+    if (s->untracked != 0U) PRINTF(" untracked=%lu", s->untracked);
+    PRINTF("\r\n");
+}
+
+static void cov_print(void)
+{
+    fio_site_stats_t total;
+    const uint32_t open = FIOutcome_Total(&g_link.cov, &total);
+
+    PRINTF("\r\nFI coverage (%lu still open):\r\n", open);
+    PRINTF("  %-8s %6s %5s %5s %5s %6s %6s  %-11s %-11s %s\r\n", "site", "fired", "det", "esc", "mask",
+           "cov%", "esc%", "lat ms a/m", "lat B a/m", "caught by");
+    for (uint32_t i = 0; i < FI_SITE_COUNT; i++)
+    {
+        if (g_link.cov.site[i].fired != 0U) cov_print_row(FI_SiteName((fi_site_t)i), &g_link.cov.site[i]);
+    }
+    cov_print_row("total", &total);
+
+    PRINTF("  unattributed detections:");
+    for (uint32_t b = 0; b < COV_B_COUNT; b++)
+    {
+        PRINTF(" %s=%lu", SfiLink_BarrierName(b), g_link.cov.falseAlarms[b]);
+    }
+    PRINTF("\r\n");
+}
+#endif /* SFI_ENABLED */
+
+static void cli_coverage(int argc, char **argv)
+{
+#if SFI_ENABLED
+    if (argc >= 3 && strcmp(argv[2], "reset") == 0)
+    {
+        FIOutcome_Reset(&g_link.cov);
+        PRINTF("\r\nFI coverage reset.\r\n");
+        return;
+    }
+    cov_print();
+#else
+    (void)argc;
+    (void)argv;
+    PRINTF("\r\nSFI_DISABLED build.\r\n");
+#endif
+}
+
+/* -------------------------------
+ * FI decision record / replay (common/fi_core.h). A failing run recorded
+ * with 'fi rec' fires at the same calls again under 'fi replay', whatever
+ * the timing and CLI input, given the same RX stream (peer replay).
+ * 'fi rec dump' prints the stream as 'fi rec load' lines: pasted back
+ * after a reset they restore it; host/sfi_sim reads them too.
+ * ------------------------------- */
+#define RR_BUF_SIZE  2048U
+#define RR_DUMP_LINE 32U
+
+#if SFI_ENABLED
+static uint8_t g_rrBuf[RR_BUF_SIZE];
+static uint32_t g_rrLen = 0;
+
+static void rr_print_stat(void)
+{
+    static const char *const mode[] = {"off", "recording", "replaying"};
+    fi_core_rr_stat_t st;
+
+    FICore_RRStat(&st);
+    PRINTF("\r\nFI record/replay %s: %lu bytes, %lu fires%s", mode[st.mode],
+           (st.mode == FI_CORE_RR_OFF) ? g_rrLen : st.len, st.fires, st.overflow ? " (buffer full)" : "");
+    if (st.mode == FI_CORE_RR_REPLAY)
+    {
+        PRINTF(", %lu pending, diverged sites 0x%08lX", st.pending, st.diverged);
     }
+    PRINTF("\r\n");
 }
 
-static void tx_stall_monitor_10ms(void)
+static void rr_load(const char *offText, const char *hex)
 {
-    /* Run at ~10ms cadence; do not call LPUART APIs inside PIT ISR. */
-    if ((g_ms - g_tx_last_checked_ms) < 10U) return;
-    g_tx_last_checked_ms = g_ms;
+    char *end;
+    uint32_t off = (uint32_t)strtoul(offText, &end, 0);
+
+    if ((*end != '\0') || !FICore_RRLoadHex(g_rrBuf, sizeof(g_rrBuf), &g_rrLen, off, hex))
+    {
+        PRINTF("\r\nrec load: bad line\r\n");
+    }
+}
+#endif /* SFI_ENABLED */
 
-    if (!g_dataUart.txOnGoing) return;
+/* -------------------------------
+ * RX corruption model (fi model)
+ * ------------------------------- */
+static void cli_model(int argc, char **argv)
+{
+#if SFI_ENABLED
+    ficm_t *m = &g_link.rxModel;
 
-    uint32_t cnt = 0;
-    if (DataUart_GetSendCount(&g_dataUart, &cnt) == kStatus_Success)
+    if (argc >= 3)
     {
-        if (cnt != g_tx_last_send_count)
+        uint32_t v[FICM_ARGS] = {0U, 0U, 0U, 0U};
+        int id = FICorrupt_ModelId(argv[2]);
+
+        for (int i = 3; (i < argc) && ((uint32_t)(i - 3) < FICM_ARGS); i++)
         {
-            g_tx_last_send_count = cnt;
-            g_tx_last_progress_ms = g_ms;
+            v[i - 3] = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+        if ((id < 0) || !FICorrupt_Set(m, id, v))
+        {
+            PRINTF("\r\nUsage: fi model off | ge <PGB> <PBG> [<EBAD> [<EGOOD>]] | stuck <MASK> <VAL> [<LEN>] | drop|ins|dup [<PPM>] | slip <BITS> [<LEN>]\r\n");
+            return;
+        }
+    }
+    PRINTF("\r\nrx model %s %lu %lu %lu %lu%s\r\n", FICorrupt_ModelName(m->model), m->args[0], m->args[1],
+           m->args[2], m->args[3], (m->model == (uint8_t)FICM_OFF) ? " (rx param bits in one byte)" : "");
+#else
+    (void)argc;
+    (void)argv;
+    PRINTF("\r\nSFI_DISABLED build.\r\n");
+#endif
+}
+
+static void cli_record(int argc, char **argv)
+{
+#if SFI_ENABLED
+    const char *sub = (argc >= 3) ? argv[2] : "";
+
+    if (strcmp(argv[1], "replay") == 0)
+    {
+        if (strcmp(sub, "stop") == 0)
+        {
+            rr_print_stat();
+            FICore_ReplayStop();
         }
         else
         {
-            /* No progress */
-            if ((g_ms - g_tx_last_progress_ms) > 100U)
-            {
-                /* Stall detected */
-                tx_recoveries++;
-                PRINTF("\r\nTX stall detected at %lu ms (send_count=%lu). Aborting and retrying.\r\n", g_ms, cnt);
+            /* Still recording: finish that stream first */
+            uint32_t len = FICore_RecordStop();
+            if (len != 0U) g_rrLen = len;
 
-                DataUart_AbortSend(&g_dataUart);
+            if (FICore_ReplayStart(g_rrBuf, g_rrLen)) rr_print_stat();
+            else PRINTF("\r\nNothing to replay: fi rec ... fi rec stop, or fi rec load lines.\r\n");
+        }
+        return;
+    }
 
-                /* Keep pending ACK in queue; next main-loop iteration will resend. */
-                g_tx_last_progress_ms = g_ms;
-                g_tx_last_send_count = 0;
+    if (sub[0] == '\0')
+    {
+        FICore_ReplayStop();
+        g_rrLen = 0;
+        (void)FICore_RecordStart(g_rrBuf, sizeof(g_rrBuf));
+        rr_print_stat();
+    }
+    else if (strcmp(sub, "stop") == 0)
+    {
+        uint32_t len = FICore_RecordStop();
+        if (len != 0U) g_rrLen = len;
+        rr_print_stat();
+    }
+    else if (strcmp(sub, "dump") == 0)
+    {
+        PRINTF("\r\n");
+        for (uint32_t off = 0; off < g_rrLen; off += RR_DUMP_LINE)
+        {
+            PRINTF("fi rec load %lu ", off);
+            for (uint32_t i = off; i < g_rrLen && i < (off + RR_DUMP_LINE); i++)
+            {
+                PRINTF("%02X", g_rrBuf[i]);
             }
+            PRINTF("\r\n");
+        }
+    }
+    else if (strcmp(sub, "load") == 0 && argc >= 5)
+    {
+        rr_load(argv[3], argv[4]);
+    }
+    else
+    {
+        PRINTF("\r\nUsage: fi rec [stop|dump|load <off> <hex>] | fi replay [stop]\r\n");
+    }
+#else
+    (void)argc;
+    (void)argv;
+    PRINTF("\r\nSFI_DISABLED build.\r\n");
+#endif
+}
+
+/* -------------------------------
+ * FI campaign (common/fi_campaign.h) through the link's adapter
+ * (sfi_camp.h: sites, policies, counters, demo script). A run starts
+ * with fresh coverage and prints the coverage table when it ends.
+ * ------------------------------- */
+#if SFI_ENABLED
+static sfi_camp_t g_campAdapter;
+static fic_campaign_t g_campaign;
+
+static void camp_on_result(void *ctx, const fic_result_t *r)
+{
+    (void)ctx;
+    console_text_begin();
+    PRINTF("\r\n[camp %lu ms] it=%lu step=%u %s %s delta=%lu (+%lu ms)\r\n",
+           g_ms, r->iteration, r->step, FICampaign_OpName(r->op), r->pass ? "PASS" : "FAIL",
+           r->delta, r->tMs);
+}
+
+static void camp_print_stat(void)
+{
+    PRINTF("\r\nCampaign: %s steps=%u step=%u it=%lu pass=%lu fail=%lu\r\n",
+           g_campaign.running ? "running" : "idle", g_campaign.stepCount, g_campaign.pc,
+           g_campaign.iterations, g_campaign.passed, g_campaign.failed);
+    if (g_campaign.failed != 0U)
+    {
+        PRINTF("  first fail: it=%lu step=%u %s delta=%lu (+%lu ms)\r\n",
+               g_campaign.firstFail.iteration, g_campaign.firstFail.step,
+               FICampaign_OpName(g_campaign.firstFail.op), g_campaign.firstFail.delta,
+               g_campaign.firstFail.tMs);
+    }
+}
+
+static void camp_on_done(void *ctx)
+{
+    (void)ctx;
+    console_text_begin();
+    camp_print_stat();
+    cov_print();
+}
+
+
+static void camp_list(void)
+{
+    PRINTF("\r\nCampaign steps:\r\n");
+    for (uint32_t i = 0; i < g_campaign.stepCount; i++)
+    {
+        const fic_step_t *s = &g_campaign.steps[i];
+        PRINTF("  %2lu %-6s arg=%u id=%u v=%lu,%lu,%lu\r\n", i, FICampaign_OpName(s->op),
+               s->arg, s->id, s->v[0], s->v[1], s->v[2]);
+    }
+}
+#endif /* SFI_ENABLED */
+
+static void cli_campaign(int argc, char **argv)
+{
+#if SFI_ENABLED
+    const char *sub = argv[2];
+    uint32_t errLine = 0;
+
+    if (strcmp(sub, "add") == 0 && argc >= 4)
+    {
+        /* Re-join the tokens: the step text is space separated */
+        char text[96];
+        size_t len = 0;
+        for (int i = 3; i < argc; i++)
+        {
+            size_t n = strlen(argv[i]);
+            if ((len + n + 2U) > sizeof(text)) break;
+            memcpy(&text[len], argv[i], n);
+            len += n;
+            text[len++] = ' ';
         }
+        text[len] = '\0';
+        if (g_campaign.running || !FICampaign_Compile(&g_campaign, text, &errLine))
+        {
+            PRINTF("\r\ncamp: %s\r\n", g_campaign.running ? "stop first" : "bad step");
+            return;
+        }
+        PRINTF("\r\ncamp: %u steps\r\n", g_campaign.stepCount);
+    }
+    else if (strcmp(sub, "clear") == 0)
+    {
+        FICampaign_Clear(&g_campaign);
+    }
+    else if (strcmp(sub, "demo") == 0)
+    {
+        FICampaign_Clear(&g_campaign);
+        if (!FICampaign_Compile(&g_campaign, SfiCamp_Demo, &errLine))
+        {
+            PRINTF("\r\ncamp: demo line %lu rejected\r\n", errLine);
+        }
+        camp_list();
+    }
+    else if (strcmp(sub, "list") == 0)
+    {
+        camp_list();
+    }
+    else if (strcmp(sub, "run") == 0)
+    {
+        SfiCamp_Start(&g_campAdapter, &g_campaign);
+    }
+    else if (strcmp(sub, "stop") == 0)
+    {
+        FICampaign_Stop(&g_campaign);
+        camp_print_stat();
+        cov_print();
+    }
+    else if (strcmp(sub, "stat") == 0)
+    {
+        camp_print_stat();
+    }
+    else
+    {
+        PRINTF("\r\nUsage: fi camp add <step>[; <step>] | clear | demo | list | run | stop | stat\r\n");
+    }
+#else
+    (void)argc;
+    (void)argv;
+    PRINTF("\r\nSFI_DISABLED build.\r\n");
+#endif
+}
+
+static void telemetry_print_1s(void)
+{
+    static uint32_t last = 0;
+    if (FILog_DrainBusy(&g_logDrain)) return;
+    if ((g_ms - last) >= 1000U)
+    {
+        last = g_ms;
+        PRINTF("\r\n[%lu ms] rx_ok=%lu bad_chk=%lu bad_parity=%lu bad_plaus=%lu bad_len=%lu rx_ovr=%lu hw_ovr=%lu | tx_retry=%lu tx_fail=%lu tx_recov=%lu tx_drop=%lu\r\n",
+               g_ms, g_link.rx_ok, g_link.rx_bad_chk, g_link.rx_bad_parity, g_link.rx_bad_plaus,
+               g_link.rx_bad_len, g_dataUart.rxOverruns, g_dataUart.rxHwOverruns,
+               g_link.tx_retries, g_link.tx_failures, g_link.tx_recoveries, g_link.tx_drops);
     }
 }
 
@@ -372,8 +723,13 @@ int main(void)
 #endif
 
     FI_Init(0xC0FFEE01U);
-    A429_ParserInit(&g_parser);
-    Plausibility_Init();
+    FILog_DrainInit(&g_logDrain);
+    SfiLink_Init(&g_link, &s_linkTx, link_event, NULL, g_minLabelIntervalMs);
+#if SFI_ENABLED
+    SfiCamp_Init(&g_campAdapter, &g_campaign, &g_link, &g_ms, camp_on_result, camp_on_done);
+    (void)SfiCamp_BindCounter(&g_campAdapter, "rx_ovr", &g_dataUart.rxOverruns);
+    (void)SfiCamp_BindCounter(&g_campAdapter, "hw_ovr", &g_dataUart.rxHwOverruns);
+#endif
 
     Pit10ms_Init();
 
@@ -381,169 +737,52 @@ int main(void)
     DataUart_Init(&g_dataUart, DATA_LPUART, DATA_LPUART_CLK_FREQ, DATA_LPUART_BAUDRATE);
     EnableIRQ(DATA_LPUART_IRQn);
 
-    /* Prime RX */
-    (void)DataUart_StartReceive1(&g_dataUart);
-
-    PRINTF("\r\nCLI: fi dump | fi arm rx every <N> bits <M> | fi arm txbusy every <N> | fi arm txstall window <S> <E> | fi arm label every <N> | fi arm parity every <N> | fi off\r\n");
+    /* Continuous RX: eDMA fills the ring, the main loop follows the head */
+    DataUart_StartRxDma(&g_dataUart, DATA_DMA_BASEADDR, DATA_DMAMUX_BASEADDR,
+                        DATA_LPUART_RX_DMA_CHANNEL, DATA_LPUART_RX_DMA_REQUEST,
+                        g_rxRing, sizeof(g_rxRing));
 
-    uint32_t last_good_word = 0;
-    bool last_good_valid = false;
+    PRINTF("\r\nCLI: fi dump | fi drain [off] | fi arm rx every <N> bits <M> | fi arm txbusy every <N> | fi arm txstall window <S> <E> | fi arm label every <N> | fi arm parity every <N> | fi camp ... | fi cov [reset] | fi rec [stop|dump] | fi replay [stop] | fi model ... | fi off\r\n");
 
     while (1)
     {
-        /* --- CLI --- */
+        /* --- CLI + campaign --- */
         cli_poll();
-
-        /* --- RX pump --- */
-        if (!g_dataUart.rxOnGoing && !g_dataUart.rxByteReady)
-        {
-            (void)DataUart_StartReceive1(&g_dataUart);
-        }
-
-        if (g_dataUart.rxByteReady)
-        {
-            uint8_t b = g_dataUart.rxByte;
-            g_dataUart.rxByteReady = false;
-
 #if SFI_ENABLED
-            /* RX corruption injection point ("before" app ring buffer / parser) */
-            {
-                fi_site_cfg_t *cfg = FI_SiteCfg(FI_SITE_RX_CORRUPT);
-                bool fire = FI_ShouldFire(FI_SITE_RX_CORRUPT);
-                if (cfg)
-                {
-                    FI_Log(FI_SITE_RX_CORRUPT, fire, cfg->hit_count, (uint32_t)b, (uint32_t)b);
-                }
-                if (fire)
-                {
-                    USER_LED_TOGGLE();
-                    b = FI_CorruptByteDeterministic(b);
-                }
-            }
+        (void)FICampaign_Poll(&g_campaign);
 #endif
 
-            uint32_t word = 0;
-            a429_parse_result_t pr = A429_ParserFeed(&g_parser, b, &word);
-
-            if (pr == A429_PARSE_BAD_LEN)
-            {
-                rx_bad_len++;
-                (void)AckQ_Push(ACK_BAD_LEN);
-            }
-            else if (pr == A429_PARSE_BAD_CHK)
-            {
-                rx_bad_chk++;
-                USER_LED_ON(); /* solid indicates error observed */
-                (void)AckQ_Push(ACK_BAD_CHK);
-            }
-            else if (pr == A429_PARSE_WORD_OK)
-            {
-                /* Optional post-parse tampers */
-#if SFI_ENABLED
-                {
-                    fi_site_cfg_t *cfg = FI_SiteCfg(FI_SITE_A429_LABEL_TAMPER);
-                    bool fire = FI_ShouldFire(FI_SITE_A429_LABEL_TAMPER);
-                    if (cfg) FI_Log(FI_SITE_A429_LABEL_TAMPER, fire, cfg->hit_count, 0, word);
-                    if (fire)
-                    {
-                        /* Flip MSB of label to push it out of allow-list deterministically. */
-                        word ^= 0x00000080U;
-                        USER_LED_TOGGLE();
-                    }
-                }
-                {
-                    fi_site_cfg_t *cfg = FI_SiteCfg(FI_SITE_A429_PARITY_TAMPER);
-                    bool fire = FI_ShouldFire(FI_SITE_A429_PARITY_TAMPER);
-                    if (cfg) FI_Log(FI_SITE_A429_PARITY_TAMPER, fire, cfg->hit_count, 0, word);
-                    if (fire)
-                    {
-                        /* Flip parity bit (bit31). */
-                        word ^= 0x80000000U;
-                        USER_LED_TOGGLE();
-                    }
-                }
-#endif
-
-                /* Barrier 2: odd parity */
-                if (!A429_CheckOddParity(word))
-                {
-                    rx_bad_parity++;
-                    USER_LED_ON();
-                    (void)AckQ_Push(ACK_BAD_PARITY);
-                }
-                else
-                {
-                    /* Barrier 3: plausibility */
-                    uint8_t label = A429_Label(word);
-                    if (!Plausibility_Accept(label))
-                    {
-                        rx_bad_plaus++;
-                        USER_LED_ON();
-                        (void)AckQ_Push(ACK_BAD_PLAUS);
-                    }
-                    else
-                    {
-                        rx_ok++;
-                        last_good_word = word;
-                        last_good_valid = true;
-                        USER_LED_OFF();
-                        (void)AckQ_Push(ACK_OK);
-                    }
-                }
-            }
-        }
-
-        /* --- TX path (exercise API failures + stall recovery) --- */
-        if (!g_dataUart.txOnGoing)
+        /* --- RX: once the line goes idle (or the ring fills up), drain
+         *     everything the DMA wrote: a chunk is a burst of frames --- */
+        if (DataUart_RxReady(&g_dataUart))
         {
-            ack_msg_t m;
-            if (AckQ_Peek(&m))
+            uint8_t *chunk;
+            size_t n;
+            while ((n = DataUart_RxPeek(&g_dataUart, &chunk)) != 0U)
             {
-                status_t st = DataUart_SendNonBlocking_FI(&g_dataUart, m.b, m.len);
-                if (st == kStatus_Success)
-                {
-                    AckQ_Pop();
-                    g_tx_last_progress_ms = g_ms;
-                    g_tx_last_send_count = 0;
-                }
-                else if (st == kStatus_LPUART_TxBusy)
-                {
-                    /* Retry later */
-                    tx_retries++;
-                    g_dataUart.txOnGoing = false; /* because we did not actually start the driver */
-                }
-                else
-                {
-                    /* Unexpected TX failure; drop this ACK */
-                    tx_failures++;
-                    AckQ_Pop();
-                }
+                /* RX corruption site, parser, barriers, ACKs */
+                SfiLink_RxChunk(&g_link, chunk, n, g_ms);
+                DataUart_RxConsume(&g_dataUart, n);
             }
         }
-        else
-        {
-            /* Maintain a moving 'progress' baseline even for normal transfers */
-            if (g_tx_last_progress_ms == 0U) g_tx_last_progress_ms = g_ms;
-        }
 
-        /* If ACK queue overflowed, record and (optionally) tell peer */
-        if ((g_ackWr - g_ackRd) >= ACK_Q_DEPTH)
+        /* --- TX: next ACK, retry on API failure, stall recovery --- */
+        SfiLink_TxPoll(&g_link, g_ms);
+
+        /* --- FI log drain (binary, a few bytes per pass) --- */
+        if (g_logDrainOn)
         {
-            if (AckQ_Push(ACK_TX_DROP) == false)
-            {
-                tx_drops++;
-            }
+            (void)FILog_DrainPoll(&g_logDrain, console_write_nb, NULL);
         }
 
-        /* --- Stall monitor + telemetry --- */
-        tx_stall_monitor_10ms();
+        /* --- Telemetry --- */
         telemetry_print_1s();
 
         /* Optional: print last-known-good word occasionally */
-        if (last_good_valid)
+        if (g_link.lastGoodValid)
         {
             /* keep silent by default; uncomment for debugging
-             * PRINTF("Last good ARINC word: 0x%08lX\r\n", last_good_word);
+             * PRINTF("Last good ARINC word: 0x%08lX\r\n", g_link.lastGoodWord);
              */
         }
     }
@@ -0,0 +1,152 @@
+#include <string.h>
+
+#include "sfi_camp.h"
+
+#if SFI_ENABLED
+#define CAMP_SITE_CTR 0x100U /* | site << 1 | fire */
+#define CAMP_COV_CTR  0x200U /* | site << 2 | fio_outcome_t */
+
+/* Order of sfi_camp_t.ctr */
+static const char *const s_ctrName[SFI_CAMP_COUNTERS] = {
+    "rx_ok", "bad_chk", "bad_parity", "bad_plaus", "bad_len", "rx_ovr",
+    "hw_ovr", "tx_retry", "tx_fail", "tx_recov", "tx_drop",
+};
+
+static const uint32_t s_unbound = 0U;
+
+/* Unattended spec run: corrupt RX until the checksum barrier has caught
+ * it, confirm a clean link once disarmed, then stall TX and expect the
+ * monitor to recover. */
+const char SfiCamp_Demo[] =
+    "arm rx every 50 3\n"
+    "until bad_chk >= 3 5000\n"
+    "disarm rx\n"
+    "wait 500\n"
+    "snap\n"
+    "wait 2000\n"
+    "expect bad_chk == 0\n"
+    "expect rx_ok > 0\n"
+    "arm txstall window 0 20\n"
+    "until tx_recov >= 1 3000\n"
+    "disarm txstall\n"
+    "wait 1000\n"
+    "repeat\n";
+
+static uint32_t camp_now_ms(void *ctx)
+{
+    return *((const sfi_camp_t *)ctx)->nowMs;
+}
+
+static int camp_site_id(void *ctx, const char *name)
+{
+    const fi_site_desc_t *d = FI_SiteByName(name);
+    (void)ctx;
+    return (d && d->id < FI_SITE_COUNT) ? (int)d->id : -1;
+}
+
+static int camp_policy_id(void *ctx, const char *name)
+{
+    (void)ctx;
+    return FICore_ArmPolicyId(name);
+}
+
+static int camp_counter_id(void *ctx, const char *name)
+{
+    const char *dot = strchr(name, '.');
+    (void)ctx;
+
+    if (dot)
+    {
+        char site[16];
+        size_t n = (size_t)(dot - name);
+        if (n >= sizeof(site)) return -1;
+        memcpy(site, name, n);
+        site[n] = '\0';
+
+        int id = camp_site_id(NULL, site);
+        if (id < 0) return -1;
+        if (strcmp(dot + 1, "hit") == 0) return (int)(CAMP_SITE_CTR | ((uint32_t)id << 1));
+        if (strcmp(dot + 1, "fire") == 0) return (int)(CAMP_SITE_CTR | ((uint32_t)id << 1) | 1U);
+        if (strcmp(dot + 1, "det") == 0) return (int)(CAMP_COV_CTR | ((uint32_t)id << 2) | FIO_DETECTED);
+        if (strcmp(dot + 1, "esc") == 0) return (int)(CAMP_COV_CTR | ((uint32_t)id << 2) | FIO_ESCAPED);
+        if (strcmp(dot + 1, "mask") == 0) return (int)(CAMP_COV_CTR | ((uint32_t)id << 2) | FIO_MASKED);
+        return -1;
+    }
+    for (uint32_t i = 0; i < SFI_CAMP_COUNTERS; i++)
+    {
+        if (strcmp(s_ctrName[i], name) == 0) return (int)i;
+    }
+    return -1;
+}
+
+static bool camp_arm(void *ctx, uint16_t site, uint8_t policy, const uint32_t v[3])
+{
+    (void)ctx;
+    return (site < FI_SITE_COUNT) && FICore_ArmArgs(site, policy, v);
+}
+
+static void camp_disarm(void *ctx, uint16_t site)
+{
+    (void)ctx;
+    FICore_Disarm(site);
+}
+
+static uint32_t camp_counter(void *ctx, uint16_t id)
+{
+    const sfi_camp_t *a = (const sfi_camp_t *)ctx;
+
+    if (id >= CAMP_COV_CTR)
+    {
+        const uint32_t site = (id - CAMP_COV_CTR) >> 2;
+        return (site < FI_SITE_COUNT) ? a->link->cov.site[site].outcome[id & 3U] : 0U;
+    }
+    if (id >= CAMP_SITE_CTR)
+    {
+        const fi_core_site_t *s = FICore_Site((id - CAMP_SITE_CTR) >> 1);
+        if (!s) return 0U;
+        return (id & 1U) ? s->fires : s->hits;
+    }
+    return (id < SFI_CAMP_COUNTERS) ? *a->ctr[id] : 0U;
+}
+
+void SfiCamp_Init(sfi_camp_t *a, fic_campaign_t *c, sfi_link_t *link, const volatile uint32_t *nowMs,
+                  void (*onResult)(void *ctx, const fic_result_t *r), void (*onDone)(void *ctx))
+{
+    const volatile uint32_t *ctr[SFI_CAMP_COUNTERS] = {
+        &link->rx_ok, &link->rx_bad_chk, &link->rx_bad_parity, &link->rx_bad_plaus, &link->rx_bad_len,
+        &s_unbound, &s_unbound, &link->tx_retries, &link->tx_failures, &link->tx_recoveries, &link->tx_drops,
+    };
+
+    memset(a, 0, sizeof(*a));
+    a->link = link;
+    a->nowMs = nowMs;
+    memcpy(a->ctr, ctr, sizeof(a->ctr));
+
+    a->ops.ctx        = a;
+    a->ops.now_ms     = camp_now_ms;
+    a->ops.site_id    = camp_site_id;
+    a->ops.policy_id  = camp_policy_id;
+    a->ops.counter_id = camp_counter_id;
+    a->ops.arm        = camp_arm;
+    a->ops.disarm     = camp_disarm;
+    a->ops.counter    = camp_counter;
+    a->ops.on_result  = onResult;
+    a->ops.on_done    = onDone;
+    FICampaign_Init(c, &a->ops);
+}
+
+bool SfiCamp_BindCounter(sfi_camp_t *a, const char *name, const volatile uint32_t *value)
+{
+    const int id = camp_counter_id(a, name);
+
+    if ((id < 0) || ((uint32_t)id >= SFI_CAMP_COUNTERS) || (value == NULL)) return false;
+    a->ctr[id] = value;
+    return true;
+}
+
+void SfiCamp_Start(sfi_camp_t *a, fic_campaign_t *c)
+{
+    FIOutcome_Reset(&a->link->cov);
+    FICampaign_Start(c);
+}
+#endif /* SFI_ENABLED */
@@ -0,0 +1,49 @@
+#ifndef SFI_CAMP_H
+#define SFI_CAMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sfi_link.h"
+#include "../common/fi_campaign.h"
+
+/*
+ * FI campaign (common/fi_campaign.h) against the SFI link's sites and
+ * counters. main.c and host/sfi_sim.c both run scripts through this
+ * adapter, so a script means the same on the board and in simulation.
+ *   arm SITE POLICY ...   FICore_ArmArgs: every N [BITS] | window S E
+ *                         [BITS] | prob | nth | burst | time | always | off
+ * Windows count site hits from the arm step, not since boot, so a
+ * repeating script re-arms the same window every iteration.
+ * Counters: the link telemetry names (rx_ok, bad_chk, bad_parity,
+ * bad_plaus, bad_len, tx_retry, tx_fail, tx_recov, tx_drop), the data
+ * UART's rx_ovr and hw_ovr (0 unless bound), SITE.hit, SITE.fire, and the
+ * outcome counts SITE.det, SITE.esc, SITE.mask.
+ */
+#if SFI_ENABLED
+#define SFI_CAMP_COUNTERS 11U
+
+typedef struct
+{
+    sfi_link_t              *link;
+    const volatile uint32_t *nowMs;
+    const volatile uint32_t *ctr[SFI_CAMP_COUNTERS];
+    fic_ops_t                ops;   /* ctx = this adapter */
+} sfi_camp_t;
+
+/* Unattended spec run used by 'fi camp demo' and 'sfi_sim --campaign demo' */
+extern const char SfiCamp_Demo[];
+
+/* Bind the adapter to a link and clock and FICampaign_Init c with it.
+ * onResult / onDone are called with the adapter as ctx; may be NULL. */
+void SfiCamp_Init(sfi_camp_t *a, fic_campaign_t *c, sfi_link_t *link, const volatile uint32_t *nowMs,
+                  void (*onResult)(void *ctx, const fic_result_t *r), void (*onDone)(void *ctx));
+
+/* Point a driver counter (rx_ovr, hw_ovr) at its source. */
+bool SfiCamp_BindCounter(sfi_camp_t *a, const char *name, const volatile uint32_t *value);
+
+/* Fresh coverage, then FICampaign_Start. */
+void SfiCamp_Start(sfi_camp_t *a, fic_campaign_t *c);
+#endif
+
+#endif /* SFI_CAMP_H */
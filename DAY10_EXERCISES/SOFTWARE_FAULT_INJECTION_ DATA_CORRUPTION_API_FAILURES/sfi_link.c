@@ -0,0 +1,433 @@
+#include "sfi_link.h"
+
+/* RX sites: every 200th chunk gets 3 bits flipped; the post-parse
+ * tampers are armed from the CLI. */
+FI_SITE_REGISTER(s_siteRx, "rx", FI_SITE_RX_CORRUPT, FI_TRIG_EVERY_N, 200U, 3U, 0U);
+FI_SITE_REGISTER(s_siteLabel, "label", FI_SITE_A429_LABEL_TAMPER, FI_TRIG_OFF, 0U, 0U, 0U);
+FI_SITE_REGISTER(s_siteParity, "parity", FI_SITE_A429_PARITY_TAMPER, FI_TRIG_OFF, 0U, 0U, 0U);
+
+/* TX sites, decided here for any sfi_tx_ops_t: every 100th send refused,
+ * transfers 500..519 stall */
+FI_SITE_REGISTER(s_siteTxBusy, "txbusy", FI_SITE_TX_API_FAIL, FI_TRIG_EVERY_N, 100U, 0U, 0U);
+FI_SITE_REGISTER(s_siteTxStall, "txstall", FI_SITE_TX_STALL, FI_TRIG_HIT_WINDOW, 500U, 520U, 0U);
+
+static const char *const s_covBarrier[COV_B_COUNT] = {"chk", "len", "parity", "plaus", "stall", "retry"};
+
+/* -------------------------------
+ * FI outcome tracking (common/fi_outcome.h): each fire is linked to the
+ * barrier that caught it or counted as an escape.
+ *   rx       stream byte offset; checksum / length barriers, escaped once
+ *            the parser has judged its bytes without a rejection
+ *   label,   word index; parity / plausibility, escaped if the word is
+ *   parity   accepted (masked if the other tamper on it was caught)
+ *   txbusy   the TX path's retry is the barrier
+ *   txstall  the stall monitor; undetected after 1 s is an escape
+ * ------------------------------- */
+#if SFI_ENABLED
+enum
+{
+    COV_CH_RX = 0,
+    COV_CH_WORD,
+    COV_CH_TX,
+};
+
+static const fio_site_cfg_t s_covCfg[FI_SITE_COUNT] = {
+    [FI_SITE_RX_CORRUPT]         = {COV_CH_RX, (1U << COV_B_CHK) | (1U << COV_B_LEN), FIO_MASKED, 2000U},
+    [FI_SITE_A429_LABEL_TAMPER]  = {COV_CH_WORD, (1U << COV_B_PARITY) | (1U << COV_B_PLAUS), FIO_MASKED, 0U},
+    [FI_SITE_A429_PARITY_TAMPER] = {COV_CH_WORD, (1U << COV_B_PARITY) | (1U << COV_B_PLAUS), FIO_MASKED, 0U},
+    [FI_SITE_TX_API_FAIL]        = {COV_CH_TX, (1U << COV_B_RETRY), FIO_ESCAPED, 100U},
+    [FI_SITE_TX_STALL]           = {COV_CH_TX, (1U << COV_B_STALL), FIO_ESCAPED, 1000U},
+};
+#endif
+
+static void link_event(sfi_link_t *l, sfi_link_ev_t ev, uint32_t arg)
+{
+    if (l->event != NULL)
+    {
+        l->event(l->eventCtx, ev, arg);
+    }
+}
+
+static void cov_detect(sfi_link_t *l, cov_barrier_t barrier, uint32_t nowMs)
+{
+#if SFI_ENABLED
+    FIOutcome_Detected(&l->cov, barrier, nowMs);
+#else
+    (void)l;
+    (void)barrier;
+    (void)nowMs;
+#endif
+}
+
+const char *SfiLink_BarrierName(uint32_t barrier)
+{
+    return (barrier < COV_B_COUNT) ? s_covBarrier[barrier] : "?";
+}
+
+void SfiLink_Init(sfi_link_t *l, const sfi_tx_ops_t *tx, sfi_link_event_t event, void *eventCtx,
+                  uint32_t minLabelIntervalMs)
+{
+    A429_ParserInit(&l->parser);
+    A429Plaus_Init(&l->plaus, minLabelIntervalMs);
+
+    /* Allow-list example: change to your real labels. */
+    A429Plaus_Allow(&l->plaus, 0x01);
+    A429Plaus_Allow(&l->plaus, 0x02);
+    A429Plaus_Allow(&l->plaus, 0x03);
+    A429Plaus_Allow(&l->plaus, 0x04);
+
+    l->ackWr    = 0;
+    l->ackRd    = 0;
+    l->tx       = tx;
+    l->event    = event;
+    l->eventCtx = eventCtx;
+
+    l->rx_ok = 0;
+    l->rx_bad_chk = 0;
+    l->rx_bad_parity = 0;
+    l->rx_bad_plaus = 0;
+    l->rx_bad_len = 0;
+    l->tx_retries = 0;
+    l->tx_failures = 0;
+    l->tx_recoveries = 0;
+    l->tx_drops = 0;
+
+    l->lastGoodWord  = 0;
+    l->lastGoodValid = false;
+
+    l->txLastProgressMs = 0;
+    l->txLastSendCount  = 0;
+    l->txLastCheckedMs  = 0;
+
+#if SFI_ENABLED
+    FIOutcome_Init(&l->cov, s_covCfg, FI_SITE_COUNT);
+    l->rxPos     = 0;
+    l->rxWordSeq = 0;
+    {
+        static const uint32_t off[FICM_ARGS] = {0U, 0U, 0U, 0U};
+        (void)FICorrupt_Set(&l->rxModel, FICM_OFF, off);
+    }
+#endif
+}
+
+/* -------------------------------
+ * ACK queue
+ * ------------------------------- */
+bool SfiLink_AckPush(sfi_link_t *l, ack_reason_t r)
+{
+    uint32_t wr = l->ackWr;
+    uint32_t rd = l->ackRd;
+    if ((wr - rd) >= ACK_Q_DEPTH)
+    {
+        return false;
+    }
+
+    ack_msg_t *m = &l->ackQ[wr % ACK_Q_DEPTH];
+    m->b[0] = ACK_SYNC;
+    m->b[1] = (uint8_t)r;
+    m->len = 2;
+
+    l->ackWr = wr + 1;
+    return true;
+}
+
+static bool ack_peek(sfi_link_t *l, ack_msg_t *out)
+{
+    uint32_t rd = l->ackRd;
+    if (rd == l->ackWr) return false;
+    *out = l->ackQ[rd % ACK_Q_DEPTH];
+    return true;
+}
+
+static void ack_pop(sfi_link_t *l)
+{
+    if (l->ackRd != l->ackWr) l->ackRd++;
+}
+
+/* -------------------------------
+ * RX
+ * ------------------------------- */
+static void rx_handle_word(sfi_link_t *l, uint32_t word, uint32_t nowMs)
+{
+    /* Optional post-parse tampers */
+#if SFI_ENABLED
+    if (FICore_ShouldFire(FI_SITE_A429_LABEL_TAMPER))
+    {
+        FICore_LogDetail(FI_SITE_A429_LABEL_TAMPER, 0, word);
+        FIOutcome_Injected(&l->cov, FI_SITE_A429_LABEL_TAMPER, nowMs, l->rxWordSeq);
+        /* Flip MSB of label to push it out of allow-list deterministically. */
+        word ^= 0x00000080U;
+        link_event(l, SFI_EV_INJECT, 0);
+    }
+    if (FICore_ShouldFire(FI_SITE_A429_PARITY_TAMPER))
+    {
+        FICore_LogDetail(FI_SITE_A429_PARITY_TAMPER, 0, word);
+        FIOutcome_Injected(&l->cov, FI_SITE_A429_PARITY_TAMPER, nowMs, l->rxWordSeq);
+        /* Flip parity bit (bit31). */
+        word ^= 0x80000000U;
+        link_event(l, SFI_EV_INJECT, 0);
+    }
+#endif
+    bool accepted = false;
+
+    /* Barrier 2: odd parity */
+    if (!A429_CheckOddParity(word))
+    {
+        l->rx_bad_parity++;
+        link_event(l, SFI_EV_RX_BAD, 0);
+        (void)SfiLink_AckPush(l, ACK_BAD_PARITY);
+        cov_detect(l, COV_B_PARITY, nowMs);
+    }
+    else
+    {
+        /* Barrier 3: plausibility */
+        uint8_t label = A429_Label(word);
+        if (!A429Plaus_Accept(&l->plaus, label, nowMs))
+        {
+            l->rx_bad_plaus++;
+            link_event(l, SFI_EV_RX_BAD, 0);
+            (void)SfiLink_AckPush(l, ACK_BAD_PLAUS);
+            cov_detect(l, COV_B_PLAUS, nowMs);
+        }
+        else
+        {
+            l->rx_ok++;
+            l->lastGoodWord = word;
+            l->lastGoodValid = true;
+            link_event(l, SFI_EV_RX_OK, 0);
+            (void)SfiLink_AckPush(l, ACK_OK);
+            accepted = true;
+        }
+    }
+
+#if SFI_ENABLED
+    /* The word is judged: a tamper still open on it got through, or was
+     * shadowed by the other tamper's detection. */
+    FIOutcome_Settle(&l->cov, COV_CH_WORD, l->rxWordSeq + 1U, nowMs, accepted ? FIO_ESCAPED : FIO_MASKED);
+    l->rxWordSeq++;
+#else
+    (void)accepted;
+#endif
+}
+
+/* Parser and barriers over the bytes as received; the parser carries
+ * partial frames over. */
+static void rx_parse(sfi_link_t *l, const uint8_t *data, size_t len, uint32_t nowMs)
+{
+    uint32_t words[8];
+
+    while (len != 0U)
+    {
+        const uint32_t bad_len0 = l->parser.frames_bad_len;
+        const uint32_t bad_chk0 = l->parser.frames_bad_chk;
+        size_t used = 0;
+
+        uint32_t n = A429_ParserFeedBuf(&l->parser, data, len, words, 8U, &used);
+#if SFI_ENABLED
+        FIOutcome_Bytes(&l->cov, (uint32_t)used);
+#endif
+
+        for (uint32_t i = bad_len0; i != l->parser.frames_bad_len; i++)
+        {
+            l->rx_bad_len++;
+            (void)SfiLink_AckPush(l, ACK_BAD_LEN);
+            cov_detect(l, COV_B_LEN, nowMs);
+        }
+        for (uint32_t i = bad_chk0; i != l->parser.frames_bad_chk; i++)
+        {
+            l->rx_bad_chk++;
+            link_event(l, SFI_EV_RX_BAD, 0); /* solid indicates error observed */
+            (void)SfiLink_AckPush(l, ACK_BAD_CHK);
+            cov_detect(l, COV_B_CHK, nowMs);
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            rx_handle_word(l, words[i], nowMs);
+        }
+#if SFI_ENABLED
+        /* Bytes up to here are judged, except a frame head carried over */
+        l->rxPos += (uint32_t)used;
+        FIOutcome_Settle(&l->cov, COV_CH_RX, l->rxPos - l->parser.carry_len, nowMs, FIO_ESCAPED);
+#endif
+
+        data += used;
+        len -= used;
+    }
+}
+
+#if SFI_ENABLED
+/* A fired chunk through l->rxModel: in place, or through a bounce buffer
+ * parsed piece by piece if the model adds bytes. The injection opens
+ * before the piece with the first affected byte is parsed. Log detail:
+ * chunk length, model seed. */
+static void rx_model(sfi_link_t *l, uint8_t *data, size_t len, uint32_t nowMs)
+{
+    ficm_t *m = &l->rxModel;
+    const uint32_t seed = FICore_Rand32();
+    const uint32_t pos0 = l->rxPos;
+    uint8_t bounce[SFI_RX_BOUNCE];
+    bool opened = false;
+
+    FICore_LogDetail(FI_SITE_RX_CORRUPT, (uint32_t)len, seed);
+    link_event(l, SFI_EV_INJECT, 0);
+
+    FICorrupt_Begin(m, seed, len);
+    while (!FICorrupt_Done(m))
+    {
+        uint8_t *out = FICorrupt_Grows(m) ? bounce : data;
+        size_t used = 0;
+        const size_t n = FICorrupt_Run(m, data, len, &used, out, (out == bounce) ? sizeof(bounce) : len);
+
+        if (!opened && m->events != 0U)
+        {
+            FIOutcome_Injected(&l->cov, FI_SITE_RX_CORRUPT, nowMs, pos0 + m->first);
+            opened = true;
+        }
+        data += used;
+        len -= used;
+        rx_parse(l, out, n, nowMs);
+    }
+}
+#endif
+
+void SfiLink_RxChunk(sfi_link_t *l, uint8_t *data, size_t len, uint32_t nowMs)
+{
+#if SFI_ENABLED
+    /* RX corruption injection point: once per chunk, before the parser */
+    if (len != 0U && FICore_ShouldFire(FI_SITE_RX_CORRUPT))
+    {
+        if (l->rxModel.model != (uint8_t)FICM_OFF)
+        {
+            rx_model(l, data, len, nowMs);
+            return;
+        }
+
+        uint32_t at = FICore_Rand32() % (uint32_t)len;
+        const uint8_t was = data[at];
+        FICore_LogDetail(FI_SITE_RX_CORRUPT, (uint32_t)len, (uint32_t)data[at]);
+        link_event(l, SFI_EV_INJECT, 0);
+        data[at] = FI_CorruptByteDeterministic(data[at]);
+        /* An even bit count can flip a bit back: no fault to track */
+        if (data[at] != was)
+        {
+            FIOutcome_Injected(&l->cov, FI_SITE_RX_CORRUPT, nowMs, l->rxPos + at);
+        }
+    }
+#endif
+
+    rx_parse(l, data, len, nowMs);
+}
+
+/* -------------------------------
+ * TX
+ * ------------------------------- */
+static void tx_stall_monitor_10ms(sfi_link_t *l, uint32_t nowMs)
+{
+    /* Run at ~10ms cadence; do not call LPUART APIs inside PIT ISR. */
+    if ((nowMs - l->txLastCheckedMs) < 10U) return;
+    l->txLastCheckedMs = nowMs;
+
+    if (!l->tx->busy(l->tx->ctx)) return;
+
+    uint32_t cnt = 0;
+    if (l->tx->send_count(l->tx->ctx, &cnt))
+    {
+        if (cnt != l->txLastSendCount)
+        {
+            l->txLastSendCount = cnt;
+            l->txLastProgressMs = nowMs;
+        }
+        else
+        {
+            /* No progress */
+            if ((nowMs - l->txLastProgressMs) > 100U)
+            {
+                /* Stall detected */
+                l->tx_recoveries++;
+                cov_detect(l, COV_B_STALL, nowMs);
+                link_event(l, SFI_EV_TX_STALL, cnt);
+
+                l->tx->abort(l->tx->ctx);
+
+                /* Keep pending ACK in queue; next poll will resend. */
+                l->txLastProgressMs = nowMs;
+                l->txLastSendCount = 0;
+            }
+        }
+    }
+}
+
+/* The TX sites: an API failure refuses the send without touching the
+ * UART, a stall starts the transfer but loses its completion. */
+static sfi_tx_status_t tx_send(sfi_link_t *l, const uint8_t *data, size_t len, uint32_t nowMs)
+{
+    bool stall = false;
+
+#if SFI_ENABLED
+    if (FICore_ShouldFire(FI_SITE_TX_API_FAIL))
+    {
+        FICore_LogDetail(FI_SITE_TX_API_FAIL, (uint32_t)len, (uint32_t)(len ? data[0] : 0U));
+        FIOutcome_Injected(&l->cov, FI_SITE_TX_API_FAIL, nowMs, 0U);
+        return SFI_TX_BUSY;
+    }
+    stall = FICore_ShouldFire(FI_SITE_TX_STALL);
+    if (stall)
+    {
+        FICore_LogDetail(FI_SITE_TX_STALL, (uint32_t)len, (uint32_t)(len ? data[0] : 0U));
+        FIOutcome_Injected(&l->cov, FI_SITE_TX_STALL, nowMs, 0U);
+    }
+#else
+    (void)nowMs;
+#endif
+    return l->tx->send(l->tx->ctx, data, len, stall);
+}
+
+void SfiLink_TxPoll(sfi_link_t *l, uint32_t nowMs)
+{
+    /* --- TX path (exercise API failures + stall recovery) --- */
+    if (!l->tx->busy(l->tx->ctx))
+    {
+        ack_msg_t m;
+        if (ack_peek(l, &m))
+        {
+            sfi_tx_status_t st = tx_send(l, m.b, m.len, nowMs);
+            if (st == SFI_TX_STARTED)
+            {
+                ack_pop(l);
+                l->txLastProgressMs = nowMs;
+                l->txLastSendCount = 0;
+            }
+            else if (st == SFI_TX_BUSY)
+            {
+                /* Retry later */
+                l->tx_retries++;
+                cov_detect(l, COV_B_RETRY, nowMs);
+            }
+            else
+            {
+                /* Unexpected TX failure; drop this ACK */
+                l->tx_failures++;
+                ack_pop(l);
+            }
+        }
+    }
+    else
+    {
+        /* Maintain a moving 'progress' baseline even for normal transfers */
+        if (l->txLastProgressMs == 0U) l->txLastProgressMs = nowMs;
+    }
+
+    /* If ACK queue overflowed, record and (optionally) tell peer */
+    if ((l->ackWr - l->ackRd) >= ACK_Q_DEPTH)
+    {
+        if (SfiLink_AckPush(l, ACK_TX_DROP) == false)
+        {
+            l->tx_drops++;
+        }
+    }
+
+    tx_stall_monitor_10ms(l, nowMs);
+#if SFI_ENABLED
+    FIOutcome_Poll(&l->cov, nowMs);
+#endif
+}
@@ -0,0 +1,150 @@
+#ifndef SFI_LINK_H
+#define SFI_LINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fi.h"
+#include "a429_frame.h"
+#include "a429_plaus.h"
+#include "../common/fi_outcome.h"
+#include "../common/fi_corrupt.h"
+
+/*
+ * The link logic of the SFI exercise without the board: RX barriers
+ * (checksum/length in the parser, odd parity, plausibility), the ACK queue
+ * toward the peer, the TX retry path and stall monitor, the RX injection
+ * sites and outcome tracking. main.c drives it with the LPUART/eDMA data
+ * UART and the PIT tick; host/sfi_sim.c drives it with a simulated UART.
+ * Time is passed in (ms).
+ */
+
+/* Simple ACK on data UART to exercise TX path */
+#define ACK_SYNC 0xACU
+
+typedef enum
+{
+    ACK_OK = 0,
+    ACK_BAD_CHK = 1,
+    ACK_BAD_PARITY = 2,
+    ACK_BAD_PLAUS = 3,
+    ACK_BAD_LEN = 4,
+    ACK_TX_DROP = 5,
+} ack_reason_t;
+
+typedef struct
+{
+    uint8_t b[2];
+    uint8_t len;
+} ack_msg_t;
+
+#define ACK_Q_DEPTH 32
+
+/* RX corruption models that add bytes run through this much stack */
+#define SFI_RX_BOUNCE 64U
+
+/* Outcome barriers (fi_outcome.h) */
+typedef enum
+{
+    COV_B_CHK = 0,
+    COV_B_LEN,
+    COV_B_PARITY,
+    COV_B_PLAUS,
+    COV_B_STALL,
+    COV_B_RETRY,
+    COV_B_COUNT
+} cov_barrier_t;
+
+/* Data UART as seen by the TX path. The link decides the TX injections
+ * (txbusy, txstall); send only has to honour stall. */
+typedef enum
+{
+    SFI_TX_STARTED = 0,
+    SFI_TX_BUSY,        /* refused, retry later */
+    SFI_TX_FAILED,      /* refused, drop the message */
+} sfi_tx_status_t;
+
+typedef struct
+{
+    void *ctx;
+    /* stall: start the transfer but lose its completion, so busy stays
+     * true and send_count stops short until abort */
+    sfi_tx_status_t (*send)(void *ctx, const uint8_t *data, size_t len, bool stall);
+    bool (*busy)(void *ctx);                          /* transfer in flight */
+    bool (*send_count)(void *ctx, uint32_t *count);   /* bytes sent so far */
+    void (*abort)(void *ctx);
+} sfi_tx_ops_t;
+
+/* Things the board shows: LED, stall message. May be NULL. */
+typedef enum
+{
+    SFI_EV_RX_OK = 0,   /* LED off */
+    SFI_EV_RX_BAD,      /* LED on: barrier rejected */
+    SFI_EV_INJECT,      /* LED toggle */
+    SFI_EV_TX_STALL,    /* arg: send count when the stall was detected */
+} sfi_link_ev_t;
+
+typedef void (*sfi_link_event_t)(void *ctx, sfi_link_ev_t ev, uint32_t arg);
+
+typedef struct
+{
+    a429_uart_parser_t parser;
+    a429_plaus_t       plaus;
+
+    /* RX path produces, TX path consumes */
+    ack_msg_t         ackQ[ACK_Q_DEPTH];
+    volatile uint32_t ackWr;
+    volatile uint32_t ackRd;
+
+    const sfi_tx_ops_t *tx;
+    sfi_link_event_t    event;
+    void               *eventCtx;
+
+    /* Telemetry */
+    uint32_t rx_ok;
+    uint32_t rx_bad_chk;
+    uint32_t rx_bad_parity;
+    uint32_t rx_bad_plaus;
+    uint32_t rx_bad_len;
+    uint32_t tx_retries;
+    uint32_t tx_failures;
+    uint32_t tx_recoveries;
+    uint32_t tx_drops;
+
+    uint32_t lastGoodWord;
+    bool     lastGoodValid;
+
+    /* TX stall monitor */
+    uint32_t txLastProgressMs;
+    uint32_t txLastSendCount;
+    uint32_t txLastCheckedMs;
+
+#if SFI_ENABLED
+    fio_tracker_t cov;
+    uint32_t rxPos;       /* stream offset of the next byte to parse */
+    uint32_t rxWordSeq;   /* words judged */
+    ficm_t   rxModel;     /* what an rx fire does to the chunk; FICM_OFF: param bits in one byte */
+#endif
+} sfi_link_t;
+
+/* Parser, plausibility (allow-list + min interval), ACK queue, counters and
+ * coverage. */
+void SfiLink_Init(sfi_link_t *l, const sfi_tx_ops_t *tx, sfi_link_event_t event, void *eventCtx,
+                  uint32_t minLabelIntervalMs);
+
+/* One RX chunk as received: RX corruption site, parser, barriers, ACKs.
+ * The chunk may be modified in place. With an rx model set
+ * (FICorrupt_Set(&l->rxModel, ...)) a fire runs the whole chunk through
+ * it; it counts as one injection, opened at the first affected byte. */
+void SfiLink_RxChunk(sfi_link_t *l, uint8_t *chunk, size_t len, uint32_t nowMs);
+
+/* Send the next ACK if the UART is idle, stall monitor (10 ms cadence),
+ * outcome timeouts. */
+void SfiLink_TxPoll(sfi_link_t *l, uint32_t nowMs);
+
+bool SfiLink_AckPush(sfi_link_t *l, ack_reason_t r);
+
+const char *SfiLink_BarrierName(uint32_t barrier);
+
+#endif /* SFI_LINK_H */
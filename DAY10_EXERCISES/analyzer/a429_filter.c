@@ -0,0 +1,283 @@
+#include "a429_filter.h"
+
+#include <string.h>
+
+#define DATA_MAX A429_MAX(DATA)
+
+static void rebuild(a429_filter_t *f)
+{
+    for (uint32_t s = 0U; s < A429_FILTER_SLOTS; s++)
+    {
+        for (uint32_t i = 0U; i < 8U; i++)
+        {
+            f->pass[s][i] = f->channelOn[s] ? (f->allow[s][i] & ~f->deny[s][i]) : 0U;
+        }
+    }
+}
+
+void A429Filter_Reset(a429_filter_t *f)
+{
+    memset(f->allow, 0xFF, sizeof(f->allow));
+    memset(f->deny, 0, sizeof(f->deny));
+    for (uint32_t s = 0U; s < A429_FILTER_SLOTS; s++)
+    {
+        f->allowSet[s]  = false;
+        f->channelOn[s] = true;
+    }
+    f->sdiMask = 0x0FU;
+    f->ssmMask = 0x0FU;
+    f->dataMin = 0U;
+    f->dataMax = DATA_MAX;
+    rebuild(f);
+}
+
+bool A429Filter_IsOpen(const a429_filter_t *f)
+{
+    for (uint32_t s = 0U; s < A429_FILTER_SLOTS; s++)
+    {
+        for (uint32_t i = 0U; i < 8U; i++)
+        {
+            if (f->pass[s][i] != 0xFFFFFFFFUL)
+            {
+                return false;
+            }
+        }
+    }
+    return (f->sdiMask == 0x0FU) && (f->ssmMask == 0x0FU) && (f->dataMin == 0U) && (f->dataMax == DATA_MAX);
+}
+
+/* ---- tokenizer ---------------------------------------------------------- */
+
+static const char *skip_ws(const char *p)
+{
+    while ((*p == ' ') || (*p == '\t'))
+    {
+        p++;
+    }
+    return p;
+}
+
+static bool at_end(const char *p)
+{
+    return *skip_ws(p) == '\0';
+}
+
+/* Match keyword kw followed by whitespace or end. */
+static bool take_word(const char **pp, const char *kw)
+{
+    const char *p = skip_ws(*pp);
+    size_t n = strlen(kw);
+
+    if ((strncmp(p, kw, n) != 0) || ((p[n] != '\0') && (p[n] != ' ') && (p[n] != '\t')))
+    {
+        return false;
+    }
+    *pp = p + n;
+    return true;
+}
+
+static bool take_num(const char **pp, uint32_t base, uint32_t max, uint32_t *out)
+{
+    const char *p = skip_ws(*pp);
+    const char *start;
+    uint32_t v = 0U;
+
+    if ((base == 16U) && (p[0] == '0') && ((p[1] == 'x') || (p[1] == 'X')))
+    {
+        p += 2;
+    }
+    start = p;
+    for (;;)
+    {
+        uint32_t d;
+        char c = *p;
+
+        if ((c >= '0') && (c <= '9'))      { d = (uint32_t)(c - '0'); }
+        else if ((c >= 'a') && (c <= 'f')) { d = (uint32_t)(c - 'a') + 10U; }
+        else if ((c >= 'A') && (c <= 'F')) { d = (uint32_t)(c - 'A') + 10U; }
+        else                               { break; }
+
+        if ((d >= base) || (d > max) || (v > ((max - d) / base)))
+        {
+            return false; /* bad digit or out of range */
+        }
+        v = (v * base) + d;
+        p++;
+    }
+    if (p == start)
+    {
+        return false;
+    }
+    *out = v;
+    *pp = p;
+    return true;
+}
+
+/* Optional "chN" before a label list: returns slot range [first, last]. */
+static bool take_channel_scope(const char **pp, uint32_t *first, uint32_t *last)
+{
+    const char *p = skip_ws(*pp);
+    uint32_t ch;
+
+    if ((p[0] != 'c') || (p[1] != 'h'))
+    {
+        *first = 0U;
+        *last  = A429_FILTER_SLOTS - 1U;
+        return true;
+    }
+    p += 2;
+    if (!take_num(&p, 10U, A429_FILTER_SLOTS - 1U, &ch) || (ch == 0U))
+    {
+        return false;
+    }
+    *first = ch;
+    *last  = ch;
+    *pp = p;
+    return true;
+}
+
+/* "L" or "L-L" hex label ranges until end of line, into a 256-bit set. */
+static bool take_label_set(const char *p, uint32_t set[8])
+{
+    memset(set, 0, 8U * sizeof(uint32_t));
+    if (at_end(p))
+    {
+        return false;
+    }
+    while (!at_end(p))
+    {
+        uint32_t lo, hi;
+
+        if (!take_num(&p, 16U, 0xFFU, &lo))
+        {
+            return false;
+        }
+        hi = lo;
+        if (*p == '-')
+        {
+            p++;
+            if (!take_num(&p, 16U, 0xFFU, &hi) || (hi < lo))
+            {
+                return false;
+            }
+        }
+        for (uint32_t l = lo; l <= hi; l++)
+        {
+            set[l >> 5] |= 1UL << (l & 31U);
+        }
+    }
+    return true;
+}
+
+/* Decimal values 0..max until end of line, as a bitmask. */
+static bool take_value_mask(const char *p, uint32_t max, uint32_t *mask)
+{
+    *mask = 0U;
+    if (at_end(p))
+    {
+        return false;
+    }
+    while (!at_end(p))
+    {
+        uint32_t v;
+        if (!take_num(&p, 10U, max, &v))
+        {
+            return false;
+        }
+        *mask |= 1UL << v;
+    }
+    return true;
+}
+
+bool A429Filter_Command(a429_filter_t *f, const char *cmd)
+{
+    const char *p = cmd;
+    uint32_t set[8];
+    uint32_t first, last, mask;
+
+    if (take_word(&p, "off") && at_end(p))
+    {
+        A429Filter_Reset(f);
+        return true;
+    }
+
+    p = cmd;
+    if (take_word(&p, "allow"))
+    {
+        if (!take_channel_scope(&p, &first, &last) || !take_label_set(p, set))
+        {
+            return false;
+        }
+        for (uint32_t s = first; s <= last; s++)
+        {
+            if (!f->allowSet[s])
+            {
+                memset(f->allow[s], 0, sizeof(f->allow[s]));
+                f->allowSet[s] = true;
+            }
+            for (uint32_t i = 0U; i < 8U; i++)
+            {
+                f->allow[s][i] |= set[i];
+            }
+        }
+    }
+    else if (take_word(&p, "deny"))
+    {
+        if (!take_channel_scope(&p, &first, &last) || !take_label_set(p, set))
+        {
+            return false;
+        }
+        for (uint32_t s = first; s <= last; s++)
+        {
+            for (uint32_t i = 0U; i < 8U; i++)
+            {
+                f->deny[s][i] |= set[i];
+            }
+        }
+    }
+    else if (take_word(&p, "ch"))
+    {
+        if (!take_value_mask(p, A429_FILTER_SLOTS - 1U, &mask) || ((mask & 1U) != 0U))
+        {
+            return false; /* channel ids start at 1 */
+        }
+        for (uint32_t s = 0U; s < A429_FILTER_SLOTS; s++)
+        {
+            f->channelOn[s] = ((mask >> s) & 1U) != 0U;
+        }
+    }
+    else if (take_word(&p, "sdi"))
+    {
+        if (!take_value_mask(p, 3U, &mask))
+        {
+            return false;
+        }
+        f->sdiMask = (uint8_t)mask;
+    }
+    else if (take_word(&p, "ssm"))
+    {
+        if (!take_value_mask(p, 3U, &mask))
+        {
+            return false;
+        }
+        f->ssmMask = (uint8_t)mask;
+    }
+    else if (take_word(&p, "data"))
+    {
+        uint32_t lo, hi;
+        if (!take_num(&p, 16U, DATA_MAX, &lo) || !take_num(&p, 16U, DATA_MAX, &hi) ||
+            (hi < lo) || !at_end(p))
+        {
+            return false;
+        }
+        f->dataMin = lo;
+        f->dataMax = hi;
+    }
+    else
+    {
+        return false;
+    }
+
+    rebuild(f);
+    return true;
+}
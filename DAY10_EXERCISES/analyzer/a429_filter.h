@@ -0,0 +1,65 @@
+#ifndef A429_FILTER_H
+#define A429_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "label_stats.h"
+#include "../common/a429_word.h"
+
+/*
+ * Live-output filter: per-channel 256-bit label pass maps (allow & ~deny,
+ * precomputed on every change), SDI and SSM value masks and a DATA range.
+ * A429Filter_Match is branch-free: four table/bit tests ANDed together.
+ *
+ * Channel slot 0 covers channel ids outside 1..LABEL_STATS_CHANNELS.
+ */
+#define A429_FILTER_SLOTS   (LABEL_STATS_CHANNELS + 1U)
+
+typedef struct
+{
+    /* Effective map used per word */
+    uint32_t pass[A429_FILTER_SLOTS][8];
+
+    /* As configured */
+    uint32_t allow[A429_FILTER_SLOTS][8];
+    uint32_t deny[A429_FILTER_SLOTS][8];
+    bool     allowSet[A429_FILTER_SLOTS]; /* false: allow-list is "all labels" */
+    bool     channelOn[A429_FILTER_SLOTS];
+
+    uint8_t  sdiMask;   /* bit n: SDI value n passes */
+    uint8_t  ssmMask;   /* bit n: SSM value n passes */
+    uint32_t dataMin;
+    uint32_t dataMax;
+} a429_filter_t;
+
+void A429Filter_Reset(a429_filter_t *f);
+
+/* Apply one filter command (the text after "f "):
+ *   allow [chN] L[-L] ...   restrict to these labels (hex); first allow on a
+ *                           channel replaces "all labels"
+ *   deny  [chN] L[-L] ...   never pass these labels
+ *   ch N ...                only these channels
+ *   sdi V ...               only these SDI values (0..3)
+ *   ssm V ...               only these SSM values (0..3)
+ *   data MIN MAX            DATA field range (hex, inclusive)
+ *   off                     pass everything
+ * Returns false on a syntax or range error; the filter is then unchanged. */
+bool A429Filter_Command(a429_filter_t *f, const char *cmd);
+
+/* True if nothing is filtered (reset state). */
+bool A429Filter_IsOpen(const a429_filter_t *f);
+
+static inline bool A429Filter_Match(const a429_filter_t *f, uint8_t channel, uint32_t word)
+{
+    uint32_t slot = (channel < A429_FILTER_SLOTS) ? channel : 0U;
+    uint32_t lbl  = A429_GetLabel(word);
+    uint32_t data = A429_GetData(word);
+
+    return (((f->pass[slot][lbl >> 5] >> (lbl & 31U)) &
+             ((uint32_t)f->sdiMask >> A429_GetSdi(word)) &
+             ((uint32_t)f->ssmMask >> A429_GetSsm(word)) &
+             (uint32_t)((data - f->dataMin) <= (f->dataMax - f->dataMin))) & 1U) != 0U;
+}
+
+#endif /* A429_FILTER_H */
@@ -0,0 +1,131 @@
+#include "a429_text.h"
+#include "../common/a429_word.h"
+
+#include <string.h>
+
+/* Hex digit value + 1; 0 marks a non-hex character. */
+static const uint8_t s_hexTab[256] = {
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,
+    ['5'] = 6,  ['6'] = 7,  ['7'] = 8,  ['8'] = 9,  ['9'] = 10,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+};
+
+/* 1..maxDigits hex digits. */
+bool A429Text_TakeHex(a429_text_cursor_t *c, uint32_t maxDigits, uint32_t *out)
+{
+    const char *start = c->p;
+    const char *lim = ((size_t)(c->end - start) > maxDigits) ? (start + maxDigits) : c->end;
+    uint32_t acc = 0U;
+    uint32_t v;
+
+    while ((c->p < lim) && ((v = s_hexTab[(uint8_t)*c->p]) != 0U))
+    {
+        acc = (acc << 4) | (v - 1U);
+        c->p++;
+    }
+    /* Reject empty numbers and numbers longer than maxDigits. */
+    if ((c->p == start) || ((c->p < c->end) && (s_hexTab[(uint8_t)*c->p] != 0U)))
+    {
+        return false;
+    }
+    *out = acc;
+    return true;
+}
+
+/* 1..maxDigits decimal digits (maxDigits <= 9, no overflow). */
+bool A429Text_TakeDec(a429_text_cursor_t *c, uint32_t maxDigits, uint32_t *out)
+{
+    const char *start = c->p;
+    const char *lim = ((size_t)(c->end - start) > maxDigits) ? (start + maxDigits) : c->end;
+    uint32_t acc = 0U;
+    uint32_t d;
+
+    while ((c->p < lim) && ((d = (uint32_t)(uint8_t)*c->p - (uint32_t)'0') <= 9U))
+    {
+        acc = (acc * 10U) + d;
+        c->p++;
+    }
+    if ((c->p == start) || ((c->p < c->end) && ((uint32_t)(uint8_t)*c->p - (uint32_t)'0' <= 9U)))
+    {
+        return false;
+    }
+    *out = acc;
+    return true;
+}
+
+bool A429Text_TakeLit(a429_text_cursor_t *c, const char *lit, size_t n)
+{
+    if (((size_t)(c->end - c->p) < n) || (memcmp(c->p, lit, n) != 0))
+    {
+        return false;
+    }
+    c->p += n;
+    return true;
+}
+
+#define TAKE_LIT(c, s) A429Text_TakeLit((c), (s), sizeof(s) - 1U)
+
+/* "CH<ch> LBL=<hex> SDI=<d> DATA=<hex> SSM=<d> P=<d>" (after "CH") */
+static bool parse_ch_line(a429_text_cursor_t *c, a429_text_word_t *out)
+{
+    uint32_t ch, lbl, sdi, data, ssm, p;
+
+    bool ok = A429Text_TakeDec(c, 3U, &ch) &&
+              TAKE_LIT(c, " LBL=") && A429Text_TakeHex(c, 2U, &lbl) &&
+              TAKE_LIT(c, " SDI=") && A429Text_TakeDec(c, 1U, &sdi) &&
+              TAKE_LIT(c, " DATA=") && A429Text_TakeHex(c, 5U, &data) &&
+              TAKE_LIT(c, " SSM=") && A429Text_TakeDec(c, 1U, &ssm) &&
+              TAKE_LIT(c, " P=") && A429Text_TakeDec(c, 1U, &p);
+
+    /* Range checks folded into one test. */
+    if (!ok || (c->p != c->end) || (ch > 255U) ||
+        ((sdi | ssm) > A429_MAX(SDI)) || (p > 1U) || (data > A429_MAX(DATA)))
+    {
+        return false;
+    }
+
+    out->channel = (uint8_t)ch;
+    out->word = (lbl << A429_LABEL_SHIFT) | (sdi << A429_SDI_SHIFT) | (data << A429_DATA_SHIFT) |
+                (ssm << A429_SSM_SHIFT) | (p << A429_PARITY_SHIFT);
+    return true;
+}
+
+/* "R<rx>,<label hex>,<sdi>,<word hex>" (after "R") */
+static bool parse_csv_line(a429_text_cursor_t *c, a429_text_word_t *out)
+{
+    uint32_t rx, lbl, sdi, word;
+
+    bool ok = A429Text_TakeDec(c, 3U, &rx) &&
+              TAKE_LIT(c, ",") && A429Text_TakeHex(c, 2U, &lbl) &&
+              TAKE_LIT(c, ",") && A429Text_TakeDec(c, 1U, &sdi) &&
+              TAKE_LIT(c, ",") && A429Text_TakeHex(c, 8U, &word);
+
+    if (!ok || (c->p != c->end) || (rx > 255U) || (sdi > 3U))
+    {
+        return false;
+    }
+
+    /* The word is authoritative; label/SDI columns are only format-checked. */
+    (void)lbl;
+    out->channel = (uint8_t)rx;
+    out->word = word;
+    return true;
+}
+
+bool A429Text_ParseLine(const char *line, size_t len, a429_text_word_t *out)
+{
+    a429_text_cursor_t c = {line, line + len};
+
+    if (len >= 2U && line[0] == 'C' && line[1] == 'H')
+    {
+        c.p += 2;
+        return parse_ch_line(&c, out);
+    }
+    if (len >= 1U && line[0] == 'R')
+    {
+        c.p += 1;
+        return parse_csv_line(&c, out);
+    }
+    return false;
+}
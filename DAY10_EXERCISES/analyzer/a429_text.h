@@ -0,0 +1,45 @@
+#ifndef A429_TEXT_H
+#define A429_TEXT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Allocation-free ASCII fast path for the two text formats still on the wire:
+ *   Sniffer : "CH1 LBL=1F SDI=0 DATA=12345 SSM=1 P=1"
+ *   Holt CSV: "R1,1F,0,A0012345"   (R<rx>,<label hex>,<sdi>,<word hex>)
+ * Single pass over the line, table-driven hex digits, no sscanf.
+ */
+
+typedef struct
+{
+    uint8_t  channel;
+    uint32_t word;    /* raw 32-bit ARINC word incl. parity (bit31) */
+} a429_text_word_t;
+
+/* Parse line[0..len). Returns false for anything malformed: unknown prefix,
+ * missing/extra fields, empty or over-long numbers, out-of-range SDI/SSM/P
+ * or DATA wider than 19 bits, trailing garbage. */
+bool A429Text_ParseLine(const char *line, size_t len, a429_text_word_t *out);
+
+/* Field helpers the line parsers are built from, for other ASCII protocols
+ * (e.g. the arinc_sim bridge). They read at c->p, stop at c->end and
+ * advance c->p past what they took. */
+typedef struct
+{
+    const char *p;
+    const char *end;
+} a429_text_cursor_t;
+
+/* 1..maxDigits hex digits (maxDigits <= 8), no prefix. false for an empty
+ * number or one longer than maxDigits. */
+bool A429Text_TakeHex(a429_text_cursor_t *c, uint32_t maxDigits, uint32_t *out);
+
+/* 1..maxDigits decimal digits (maxDigits <= 9, no overflow). */
+bool A429Text_TakeDec(a429_text_cursor_t *c, uint32_t maxDigits, uint32_t *out);
+
+/* Exactly lit[0..n); nothing taken if it does not match. */
+bool A429Text_TakeLit(a429_text_cursor_t *c, const char *lit, size_t n);
+
+#endif /* A429_TEXT_H */
@@ -0,0 +1,198 @@
+#include "analyzer_core.h"
+#include "../common/a429_word.h"
+
+#include <stddef.h>
+
+void AnalyzerCore_ClearStats(analyzer_core_t *a)
+{
+    LabelStats_Clear(&a->stats);
+    LabelTiming_Clear(&a->timing);
+    a->totalWords        = 0U;
+    a->totalParityErrors = 0U;
+}
+
+void AnalyzerCore_Init(analyzer_core_t *a)
+{
+    AnalyzerCore_ClearStats(a);
+    A429Filter_Reset(&a->filter);
+}
+
+bool AnalyzerCore_ProcessWord(analyzer_core_t *a, uint8_t channel, uint32_t word,
+                              uint32_t timestampUs, bool *parityOk)
+{
+    uint8_t labelByte = (uint8_t)A429_GetLabel(word);
+    bool    ok        = A429_ParityOk(word);
+
+    a->totalWords++;
+    LabelStats_Record(&a->stats, word, channel, ok);
+    LabelTiming_Record(&a->timing, channel, labelByte, timestampUs);
+    if (!ok)
+    {
+        a->totalParityErrors++;
+    }
+
+    if (parityOk != NULL)
+    {
+        *parityOk = ok;
+    }
+
+    /* Apply filters for live output */
+    return A429Filter_Match(&a->filter, channel, word);
+}
+
+void AnalyzerCore_Merge(analyzer_core_t *dst, const analyzer_core_t *src)
+{
+    LabelStats_Merge(&dst->stats, &src->stats);
+    LabelTiming_Merge(&dst->timing, &src->timing);
+    dst->totalWords        += src->totalWords;
+    dst->totalParityErrors += src->totalParityErrors;
+}
+
+void AnalyzerCore_PrintSummary(const analyzer_core_t *a, analyzer_print_fn_t print)
+{
+    print("\r\n=== Summary ===\r\n");
+    print("Total words        : %u\r\n", (unsigned int)a->totalWords);
+    print("Total parity errors: %u\r\n", (unsigned int)a->totalParityErrors);
+}
+
+void AnalyzerCore_PrintLabelTable(const analyzer_core_t *a, analyzer_print_fn_t print)
+{
+    const label_stats_t *st = &a->stats;
+    uint32_t lbl;
+
+    print("\r\nLabel  Count  ");
+    for (uint32_t c = 0U; c < LABEL_STATS_CHANNELS; c++)
+    {
+        print("  CH%u ", (unsigned int)(c + 1U));
+    }
+    print("  ParErr  LastData   SDI SSM CH\r\n");
+
+    for (lbl = LabelStats_Next(st, 0U); lbl < LABEL_STATS_LABELS; lbl = LabelStats_Next(st, lbl + 1U))
+    {
+        uint32_t last = st->lastWord[lbl];
+
+        print("0x%02X  %6u ", (unsigned int)lbl, (unsigned int)st->total[lbl]);
+        for (uint32_t c = 0U; c < LABEL_STATS_CHANNELS; c++)
+        {
+            print("%5u ", (unsigned int)st->chCount[c][lbl]);
+        }
+        print("%7u  0x%05X    %u   %u  %u\r\n",
+              (unsigned int)st->parityErr[lbl],
+              (unsigned int)A429_GetData(last),
+              (unsigned int)A429_GetSdi(last),
+              (unsigned int)A429_GetSsm(last),
+              (unsigned int)st->lastChannel[lbl]);
+    }
+}
+
+void AnalyzerCore_PrintTiming(const analyzer_core_t *a, analyzer_print_fn_t print)
+{
+    const label_timing_t *tm = &a->timing;
+    uint32_t lbl;
+
+    /* One row per channel that carries the label; CH "-" is the slot for
+     * channel ids beyond LABEL_STATS_CHANNELS. */
+    print("\r\nLabel  CH  Periods  Rate/s  Min(us)   Mean(us)  Max(us)   Jitter%%  Histogram (>=us:count)\r\n");
+    for (lbl = LabelStats_Next(&a->stats, 0U); lbl < LABEL_STATS_LABELS; lbl = LabelStats_Next(&a->stats, lbl + 1U))
+    {
+        for (uint32_t s = 1U; s <= LABEL_TIMING_SLOTS; s++)
+        {
+            const uint32_t slot = s % LABEL_TIMING_SLOTS; /* slot 0 last */
+            uint32_t n = tm->periods[slot][lbl];
+            if (n == 0U)
+            {
+                continue;
+            }
+
+            uint64_t sum    = tm->sumUs[slot][lbl];
+            uint32_t mean   = (uint32_t)(sum / n);
+            uint32_t rate   = (sum != 0U) ? (uint32_t)(((uint64_t)n * 1000000U) / sum) : 0U;
+            uint32_t minUs  = tm->minUs[slot][lbl];
+            uint32_t maxUs  = tm->maxUs[slot][lbl];
+            uint32_t jitter = (mean != 0U) ? (uint32_t)(((uint64_t)(maxUs - minUs) * 100U) / mean) : 0U;
+
+            if (slot != 0U)
+            {
+                print("0x%02X  %2u  ", (unsigned int)lbl, (unsigned int)slot);
+            }
+            else
+            {
+                print("0x%02X   -  ", (unsigned int)lbl);
+            }
+            print("%7u  %6u  %-8u  %-8u  %-8u  %-7u ",
+                  (unsigned int)n, (unsigned int)rate,
+                  (unsigned int)minUs, (unsigned int)mean, (unsigned int)maxUs, (unsigned int)jitter);
+            for (uint32_t k = 0U; k < LABEL_TIMING_BUCKETS; k++)
+            {
+                if (tm->hist[slot][lbl][k] != 0U)
+                {
+                    print(" %u:%u", (unsigned int)LabelTiming_BucketFloorUs(k), (unsigned int)tm->hist[slot][lbl][k]);
+                }
+            }
+            print("\r\n");
+        }
+    }
+}
+
+/* Print a run-length list of set bits in a 256-bit map, e.g. "01-0F 1F". */
+static void print_label_ranges(const uint32_t map[8], analyzer_print_fn_t print)
+{
+    uint32_t lbl = 0U;
+    uint32_t runs = 0U;
+
+    while (lbl < 256U)
+    {
+        if (((map[lbl >> 5] >> (lbl & 31U)) & 1U) == 0U)
+        {
+            lbl++;
+            continue;
+        }
+        uint32_t start = lbl;
+        while ((lbl < 256U) && (((map[lbl >> 5] >> (lbl & 31U)) & 1U) != 0U))
+        {
+            lbl++;
+        }
+        if (start == (lbl - 1U))
+        {
+            print(" %02X", (unsigned int)start);
+        }
+        else
+        {
+            print(" %02X-%02X", (unsigned int)start, (unsigned int)(lbl - 1U));
+        }
+        runs++;
+    }
+    if (runs == 0U)
+    {
+        print(" none");
+    }
+}
+
+void AnalyzerCore_PrintFilter(const analyzer_core_t *a, analyzer_print_fn_t print)
+{
+    const a429_filter_t *f = &a->filter;
+
+    if (A429Filter_IsOpen(f))
+    {
+        print("\r\nFilter: off (all words shown)\r\n");
+        return;
+    }
+
+    print("\r\nFilter:\r\n");
+    for (uint32_t s = 0U; s < A429_FILTER_SLOTS; s++)
+    {
+        if (s == 0U)
+        {
+            print("  other CH labels:");
+        }
+        else
+        {
+            print("  CH%u labels     :", (unsigned int)s);
+        }
+        print_label_ranges(f->pass[s], print);
+        print("\r\n");
+    }
+    print("  SDI mask 0x%X, SSM mask 0x%X, DATA 0x%05X..0x%05X\r\n",
+          (unsigned int)f->sdiMask, (unsigned int)f->ssmMask,
+          (unsigned int)f->dataMin, (unsigned int)f->dataMax);
+}
@@ -0,0 +1,53 @@
+#ifndef ANALYZER_CORE_H
+#define ANALYZER_CORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "label_stats.h"
+#include "label_timing.h"
+#include "a429_filter.h"
+
+/*
+ * Board-independent analyzer core: parity check, label statistics, timing
+ * and live-output filters. No LPUART or console dependency; reports go
+ * through a printf-compatible function (PRINTF on target, printf on host),
+ * so the on-target 's'/'l'/'t' output and the host tool match.
+ *
+ * Word layout (Holt/our convention):
+ *   bits 0..7   : LABEL
+ *   bits 8..9   : SDI
+ *   bits 10..28 : DATA (19 bits)
+ *   bits 29..30 : SSM
+ *   bit  31     : parity
+ */
+typedef int (*analyzer_print_fn_t)(const char *fmt, ...);
+
+typedef struct
+{
+    label_stats_t  stats;
+    label_timing_t timing;
+    uint32_t       totalWords;
+    uint32_t       totalParityErrors;
+
+    /* Live-output filter */
+    a429_filter_t  filter;
+} analyzer_core_t;
+
+void AnalyzerCore_Init(analyzer_core_t *a);       /* stats and filters */
+void AnalyzerCore_ClearStats(analyzer_core_t *a); /* keeps filters */
+
+/* Account one word. Returns true if it passes the live-output filters;
+ * *parityOk (optional) reports the parity check. */
+bool AnalyzerCore_ProcessWord(analyzer_core_t *a, uint8_t channel, uint32_t word,
+                              uint32_t timestampUs, bool *parityOk);
+
+/* Fold a shard into dst (counters add, timing combines). */
+void AnalyzerCore_Merge(analyzer_core_t *dst, const analyzer_core_t *src);
+
+void AnalyzerCore_PrintSummary(const analyzer_core_t *a, analyzer_print_fn_t print);
+void AnalyzerCore_PrintLabelTable(const analyzer_core_t *a, analyzer_print_fn_t print);
+void AnalyzerCore_PrintTiming(const analyzer_core_t *a, analyzer_print_fn_t print);
+void AnalyzerCore_PrintFilter(const analyzer_core_t *a, analyzer_print_fn_t print);
+
+#endif /* ANALYZER_CORE_H */
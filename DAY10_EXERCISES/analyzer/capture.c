@@ -0,0 +1,114 @@
+#include "capture.h"
+#include "../common/crc32.h"
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void Capture_WriterInit(capture_writer_t *w, capture_sink_t sink, void *user)
+{
+    w->count    = 0U;
+    w->seq      = 0U;
+    w->lastTsUs = 0U;
+    w->sink     = sink;
+    w->user     = user;
+    w->blocks   = 0U;
+    w->words    = 0U;
+}
+
+void Capture_Flush(capture_writer_t *w)
+{
+    size_t body;
+
+    if (w->count == 0U)
+    {
+        return;
+    }
+
+    body = CAPTURE_HDR_LEN + ((size_t)w->count * CAPTURE_REC_LEN);
+    w->buf[12] = (uint8_t)w->count;
+    w->buf[13] = (uint8_t)(w->count >> 8);
+    Crc32_BlockSeal(w->buf, body);
+
+    w->sink(w->buf, body + CAPTURE_CRC_LEN, w->user);
+    w->blocks++;
+    w->seq++;
+    w->count = 0U;
+}
+
+void Capture_Record(capture_writer_t *w, uint8_t channel, uint32_t word, uint32_t tsUs)
+{
+    uint32_t dt = tsUs - w->lastTsUs;
+
+    if ((w->count != 0U) && (dt > CAPTURE_DT_MAX))
+    {
+        Capture_Flush(w);
+    }
+
+    if (w->count == 0U)
+    {
+        put_le32(&w->buf[0], CAPTURE_MAGIC);
+        put_le32(&w->buf[4], w->seq);
+        put_le32(&w->buf[8], tsUs);
+        w->buf[14] = 0U;
+        w->buf[15] = 0U;
+        dt = 0U;
+    }
+
+    uint8_t *r = &w->buf[CAPTURE_HDR_LEN + ((size_t)w->count * CAPTURE_REC_LEN)];
+    put_le32(&r[0], word);
+    put_le32(&r[4], dt | ((uint32_t)channel << 24));
+
+    w->lastTsUs = tsUs;
+    w->words++;
+    if (++w->count >= CAPTURE_BLOCK_RECORDS)
+    {
+        Capture_Flush(w);
+    }
+}
+
+int32_t Capture_ParseBlock(const uint8_t *buf, size_t len, capture_block_t *out)
+{
+    uint16_t count;
+    size_t   body;
+
+    if (Crc32_BlockMagic(buf, len, CAPTURE_MAGIC) < 0)
+    {
+        return -1;
+    }
+    if (len < CAPTURE_HDR_LEN)
+    {
+        return 0;
+    }
+
+    count = (uint16_t)(buf[12] | ((uint16_t)buf[13] << 8));
+    if ((count == 0U) || (count > CAPTURE_BLOCK_RECORDS))
+    {
+        return -1;
+    }
+
+    body = CAPTURE_HDR_LEN + ((size_t)count * CAPTURE_REC_LEN);
+    if (len < (body + CAPTURE_CRC_LEN))
+    {
+        return 0;
+    }
+    if (!Crc32_BlockValid(buf, body))
+    {
+        return -1;
+    }
+
+    out->seq       = get_le32(&buf[4]);
+    out->firstTsUs = get_le32(&buf[8]);
+    out->count     = count;
+    out->records   = &buf[CAPTURE_HDR_LEN];
+    return (int32_t)(body + CAPTURE_CRC_LEN);
+}
@@ -0,0 +1,73 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Append-only ARINC capture stream: a sequence of self-contained blocks.
+ *
+ *   Block  = [header 16][record 8 * count][CRC32 4]
+ *   Header = magic "A4CP" | seq u32 | first_ts_us u32 | count u16 | flags u16
+ *   Record = word u32 | meta u32 (dt_us in bits 0..23, channel in 24..31)
+ *   All fields little-endian. CRC32 (IEEE, reflected) covers header+records.
+ *
+ * dt_us is relative to the previous record of the block (0 for the first),
+ * so a block header is the index entry: seq and first timestamp let a
+ * reader seek without decoding records. A gap > 16.7 s starts a new block.
+ */
+#define CAPTURE_MAGIC           0x50433441UL /* "A4CP" */
+#define CAPTURE_HDR_LEN         16U
+#define CAPTURE_REC_LEN         8U
+#define CAPTURE_CRC_LEN         4U
+#define CAPTURE_DT_MAX          0x00FFFFFFUL
+
+#ifndef CAPTURE_BLOCK_RECORDS
+#define CAPTURE_BLOCK_RECORDS   64U
+#endif
+#define CAPTURE_BLOCK_MAX       (CAPTURE_HDR_LEN + (CAPTURE_BLOCK_RECORDS * CAPTURE_REC_LEN) + CAPTURE_CRC_LEN)
+
+/* Receives each finished block; the buffer is reused after return. */
+typedef void (*capture_sink_t)(const uint8_t *block, size_t len, void *user);
+
+typedef struct
+{
+    uint8_t        buf[CAPTURE_BLOCK_MAX];
+    uint16_t       count;
+    uint32_t       seq;
+    uint32_t       lastTsUs;
+    capture_sink_t sink;
+    void          *user;
+
+    /* Stats */
+    uint32_t blocks;
+    uint32_t words;
+} capture_writer_t;
+
+typedef struct
+{
+    uint32_t       seq;
+    uint32_t       firstTsUs;
+    uint16_t       count;
+    const uint8_t *records;
+} capture_block_t;
+
+void Capture_WriterInit(capture_writer_t *w, capture_sink_t sink, void *user);
+void Capture_Record(capture_writer_t *w, uint8_t channel, uint32_t word, uint32_t tsUs);
+void Capture_Flush(capture_writer_t *w); /* emits a partial block, if any */
+
+/* Validate the block at buf[0..len); resync contract in common/crc32.h. */
+int32_t Capture_ParseBlock(const uint8_t *buf, size_t len, capture_block_t *out);
+
+static inline void Capture_GetRecord(const capture_block_t *b, uint32_t i,
+                                     uint8_t *channel, uint32_t *word, uint32_t *dtUs)
+{
+    const uint8_t *r = &b->records[i * CAPTURE_REC_LEN];
+
+    *word    = (uint32_t)r[0] | ((uint32_t)r[1] << 8) | ((uint32_t)r[2] << 16) | ((uint32_t)r[3] << 24);
+    *dtUs    = (uint32_t)r[4] | ((uint32_t)r[5] << 8) | ((uint32_t)r[6] << 16);
+    *channel = r[7];
+}
+
+#endif /* CAPTURE_H */
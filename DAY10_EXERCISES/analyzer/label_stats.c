@@ -0,0 +1,55 @@
+#include "label_stats.h"
+
+#include <string.h>
+
+void LabelStats_Clear(label_stats_t *s)
+{
+    memset(s, 0, sizeof(*s));
+}
+
+uint32_t LabelStats_Next(const label_stats_t *s, uint32_t from)
+{
+    uint32_t idx;
+    uint32_t bits;
+
+    if (from >= LABEL_STATS_LABELS)
+    {
+        return LABEL_STATS_LABELS;
+    }
+
+    idx  = from >> 5;
+    bits = s->occupied[idx] & (0xFFFFFFFFUL >> (from & 31U));
+
+    for (;;)
+    {
+        if (bits != 0U)
+        {
+            /* Single CLZ instruction on Cortex-M7 */
+            return (idx << 5) + (uint32_t)__builtin_clz(bits);
+        }
+        if (++idx >= LABEL_STATS_WORDS)
+        {
+            return LABEL_STATS_LABELS;
+        }
+        bits = s->occupied[idx];
+    }
+}
+
+void LabelStats_Merge(label_stats_t *dst, const label_stats_t *src)
+{
+    for (uint32_t lbl = LabelStats_Next(src, 0U); lbl < LABEL_STATS_LABELS; lbl = LabelStats_Next(src, lbl + 1U))
+    {
+        dst->total[lbl] += src->total[lbl];
+        for (uint32_t c = 0U; c < LABEL_STATS_CHANNELS; c++)
+        {
+            dst->chCount[c][lbl] += src->chCount[c][lbl];
+        }
+        dst->parityErr[lbl]  += src->parityErr[lbl];
+        dst->lastWord[lbl]    = src->lastWord[lbl];
+        dst->lastChannel[lbl] = src->lastChannel[lbl];
+    }
+    for (uint32_t i = 0U; i < LABEL_STATS_WORDS; i++)
+    {
+        dst->occupied[i] |= src->occupied[i];
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef LABEL_STATS_H
+#define LABEL_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Per-label statistics, split by access pattern instead of one struct per
+ * label:
+ *   hot  : total / per-channel counters and the occupancy bitmap, touched by
+ *          every word (separate dense arrays, one channel = one array)
+ *   warm : parity-error counter, touched only on bad words
+ *   cold : last raw word / channel, written per word but only read by the
+ *          label listing
+ * Listing walks the occupancy bitmap with CLZ instead of scanning 256 rows.
+ */
+#define LABEL_STATS_LABELS  256U
+#define LABEL_STATS_WORDS   (LABEL_STATS_LABELS / 32U)
+
+/* Receiver channels counted individually (channel ids 1..N); also the
+ * channel slots of the filters, dedup and timing. It sizes tables in
+ * several sources, so override it project-wide only. */
+#ifndef LABEL_STATS_CHANNELS
+#define LABEL_STATS_CHANNELS 2U
+#endif
+
+typedef struct
+{
+    /* hot */
+    uint32_t total[LABEL_STATS_LABELS];
+    uint32_t chCount[LABEL_STATS_CHANNELS][LABEL_STATS_LABELS];
+    uint32_t occupied[LABEL_STATS_WORDS]; /* label L -> bit (31 - L%32), MSB first for CLZ */
+
+    /* warm */
+    uint32_t parityErr[LABEL_STATS_LABELS];
+
+    /* cold */
+    uint32_t lastWord[LABEL_STATS_LABELS];
+    uint8_t  lastChannel[LABEL_STATS_LABELS];
+} label_stats_t;
+
+void LabelStats_Clear(label_stats_t *s);
+
+/* First occupied label >= from, or LABEL_STATS_LABELS when there is none. */
+uint32_t LabelStats_Next(const label_stats_t *s, uint32_t from);
+
+/* Add src into dst (sharded analysis). Last-value fields are taken from src
+ * where src saw the label. */
+void LabelStats_Merge(label_stats_t *dst, const label_stats_t *src);
+
+/* Per-word update; inline because it sits on the ingest hot path. */
+static inline void LabelStats_Record(label_stats_t *s, uint32_t word, uint8_t channel, bool parityOk)
+{
+    uint32_t lbl   = word & 0xFFU;
+    uint32_t chIdx = (uint32_t)channel - 1U; /* channel 0 wraps and is not counted */
+
+    s->total[lbl]++;
+    s->occupied[lbl >> 5] |= 0x80000000UL >> (lbl & 31U);
+    if (chIdx < LABEL_STATS_CHANNELS)
+    {
+        s->chCount[chIdx][lbl]++;
+    }
+    if (!parityOk)
+    {
+        s->parityErr[lbl]++;
+    }
+
+    s->lastWord[lbl]    = word;
+    s->lastChannel[lbl] = channel;
+}
+
+#endif /* LABEL_STATS_H */
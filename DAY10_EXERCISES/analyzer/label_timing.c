@@ -0,0 +1,97 @@
+#include "label_timing.h"
+
+#include <string.h>
+
+void LabelTiming_Clear(label_timing_t *t)
+{
+    memset(t, 0, sizeof(*t));
+}
+
+static uint32_t bucket_of(uint32_t periodUs)
+{
+    uint32_t k;
+
+    if (periodUs < (2UL << LABEL_TIMING_SHIFT))
+    {
+        return 0U;
+    }
+    k = 31U - (uint32_t)__builtin_clz(periodUs) - LABEL_TIMING_SHIFT;
+    return (k < LABEL_TIMING_BUCKETS) ? k : (LABEL_TIMING_BUCKETS - 1U);
+}
+
+void LabelTiming_Record(label_timing_t *t, uint8_t channel, uint8_t label, uint32_t nowUs)
+{
+    const uint32_t slot = LabelTiming_Slot(channel);
+    uint32_t bit = 1UL << (label & 31U);
+    uint32_t *seen = &t->seen[slot][label >> 5];
+
+    if ((*seen & bit) == 0U)
+    {
+        /* First sighting: only a reference point, no period yet */
+        *seen |= bit;
+        t->lastUs[slot][label] = nowUs;
+        t->minUs[slot][label]  = UINT32_MAX;
+        return;
+    }
+
+    uint32_t period = nowUs - t->lastUs[slot][label];
+    t->lastUs[slot][label] = nowUs;
+
+    if (period < t->minUs[slot][label])
+    {
+        t->minUs[slot][label] = period;
+    }
+    if (period > t->maxUs[slot][label])
+    {
+        t->maxUs[slot][label] = period;
+    }
+    t->sumUs[slot][label] += period;
+    t->periods[slot][label]++;
+
+    uint16_t *h = &t->hist[slot][label][bucket_of(period)];
+    if (*h != UINT16_MAX)
+    {
+        (*h)++;
+    }
+}
+
+void LabelTiming_Merge(label_timing_t *dst, const label_timing_t *src)
+{
+    for (uint32_t s = 0U; s < LABEL_TIMING_SLOTS; s++)
+    {
+        for (uint32_t lbl = 0U; lbl < LABEL_TIMING_LABELS; lbl++)
+        {
+            uint32_t bit = 1UL << (lbl & 31U);
+
+            if ((src->seen[s][lbl >> 5] & bit) == 0U)
+            {
+                continue;
+            }
+            if ((dst->seen[s][lbl >> 5] & bit) == 0U)
+            {
+                dst->seen[s][lbl >> 5] |= bit;
+                dst->lastUs[s][lbl] = src->lastUs[s][lbl];
+                dst->minUs[s][lbl]  = UINT32_MAX;
+            }
+
+            if (src->periods[s][lbl] != 0U)
+            {
+                if (src->minUs[s][lbl] < dst->minUs[s][lbl])
+                {
+                    dst->minUs[s][lbl] = src->minUs[s][lbl];
+                }
+                if (src->maxUs[s][lbl] > dst->maxUs[s][lbl])
+                {
+                    dst->maxUs[s][lbl] = src->maxUs[s][lbl];
+                }
+                dst->sumUs[s][lbl]   += src->sumUs[s][lbl];
+                dst->periods[s][lbl] += src->periods[s][lbl];
+                for (uint32_t k = 0U; k < LABEL_TIMING_BUCKETS; k++)
+                {
+                    uint32_t h = (uint32_t)dst->hist[s][lbl][k] + src->hist[s][lbl][k];
+                    dst->hist[s][lbl][k] = (uint16_t)((h > UINT16_MAX) ? UINT16_MAX : h);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef LABEL_TIMING_H
+#define LABEL_TIMING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "label_stats.h"
+
+/*
+ * Per-(channel, label) inter-arrival statistics, O(1) per word:
+ *   last timestamp, min/max/sum of periods and a log2 histogram.
+ * Timestamps are microseconds on a free-running 32-bit clock (wrap-safe
+ * subtraction). Each receiver channel has its own entries, so a label
+ * carried on several channels gets one period stream per channel.
+ *
+ * Key = channel slot x label, slots as in word_dedup.h: slot c for channel
+ * id c in 1..LABEL_STATS_CHANNELS, slot 0 for all other channel ids.
+ *
+ * Histogram bucket k counts periods in [2^(k+8), 2^(k+9)) us; bucket 0 also
+ * takes everything below 512 us and the last bucket everything above.
+ */
+#define LABEL_TIMING_LABELS   256U
+#define LABEL_TIMING_BUCKETS  16U
+#define LABEL_TIMING_SHIFT    8U
+#define LABEL_TIMING_SLOTS    (LABEL_STATS_CHANNELS + 1U)
+
+typedef struct
+{
+    uint32_t lastUs[LABEL_TIMING_SLOTS][LABEL_TIMING_LABELS];
+    uint32_t minUs[LABEL_TIMING_SLOTS][LABEL_TIMING_LABELS];
+    uint32_t maxUs[LABEL_TIMING_SLOTS][LABEL_TIMING_LABELS];
+    uint64_t sumUs[LABEL_TIMING_SLOTS][LABEL_TIMING_LABELS];
+    uint32_t periods[LABEL_TIMING_SLOTS][LABEL_TIMING_LABELS];
+    uint16_t hist[LABEL_TIMING_SLOTS][LABEL_TIMING_LABELS][LABEL_TIMING_BUCKETS]; /* saturating */
+    uint32_t seen[LABEL_TIMING_SLOTS][LABEL_TIMING_LABELS / 32U];                 /* lastUs valid */
+} label_timing_t;
+
+/* Slot of a channel id */
+static inline uint32_t LabelTiming_Slot(uint8_t channel)
+{
+    return (((uint32_t)channel - 1U) < LABEL_STATS_CHANNELS) ? (uint32_t)channel : 0U;
+}
+
+void LabelTiming_Clear(label_timing_t *t);
+void LabelTiming_Record(label_timing_t *t, uint8_t channel, uint8_t label, uint32_t nowUs);
+
+/* Combine period statistics of two independently fed tables (e.g. one per
+ * channel shard). No period is formed across the two streams, so shard by
+ * slot (LabelTiming_Slot), not by channel id, to get the same result as a
+ * single table. */
+void LabelTiming_Merge(label_timing_t *dst, const label_timing_t *src);
+
+/* Lower bound of bucket k in microseconds (0 for the first bucket). */
+static inline uint32_t LabelTiming_BucketFloorUs(uint32_t k)
+{
+    return (k == 0U) ? 0U : (1UL << (k + LABEL_TIMING_SHIFT));
+}
+
+#endif /* LABEL_TIMING_H */
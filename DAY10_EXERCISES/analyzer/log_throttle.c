@@ -0,0 +1,119 @@
+#include "log_throttle.h"
+
+#include <string.h>
+
+#define LOG_THROTTLE_WINDOW_US  1000000U
+
+void LogThrottle_ResetCounters(log_throttle_t *t)
+{
+    t->passed        = 0U;
+    t->droppedSample = 0U;
+    t->droppedQuota  = 0U;
+    t->droppedRate   = 0U;
+    t->windowPassed  = 0U;
+    t->windowDropped = 0U;
+}
+
+void LogThrottle_Init(log_throttle_t *t, uint32_t ratePerSec, uint32_t burst,
+                      uint16_t labelQuota, uint16_t sampleN, uint32_t nowUs)
+{
+    t->ratePerSec    = ratePerSec;
+    t->burst         = burst;
+    t->labelQuota    = labelQuota;
+    t->sampleN       = sampleN;
+    t->windowUs      = LOG_THROTTLE_WINDOW_US;
+    t->tokensMilli   = burst * 1000U;
+    t->lastUs        = nowUs;
+    t->windowStartUs = nowUs;
+    t->sampleCount   = 0U;
+    t->summaryMode   = false;
+    memset(t->labelUsed, 0, sizeof(t->labelUsed));
+    LogThrottle_ResetCounters(t);
+}
+
+static void refill(log_throttle_t *t, uint32_t nowUs)
+{
+    uint32_t capMilli = t->burst * 1000U;
+    uint32_t elapsed  = nowUs - t->lastUs;
+
+    /* rate * elapsed / 1000 in milli-lines; clamp elapsed so it cannot overflow */
+    if (elapsed > LOG_THROTTLE_WINDOW_US)
+    {
+        elapsed = LOG_THROTTLE_WINDOW_US;
+    }
+    uint32_t add = (uint32_t)(((uint64_t)t->ratePerSec * elapsed) / 1000U);
+
+    /* Only advance time by what was credited, so slow trickles still add up */
+    if (add != 0U)
+    {
+        t->lastUs = nowUs;
+        t->tokensMilli = ((capMilli - t->tokensMilli) > add) ? (t->tokensMilli + add) : capMilli;
+    }
+}
+
+bool LogThrottle_Allow(log_throttle_t *t, uint8_t label, uint32_t nowUs)
+{
+    if (t->sampleN > 1U)
+    {
+        if (++t->sampleCount < t->sampleN)
+        {
+            t->droppedSample++;
+            return false; /* sampling is intentional: not a budget overrun */
+        }
+        t->sampleCount = 0U;
+    }
+
+    if ((t->labelQuota != 0U) && (t->labelUsed[label] >= t->labelQuota))
+    {
+        t->droppedQuota++;
+        t->windowDropped++;
+        t->summaryMode = true;
+        return false;
+    }
+
+    if (t->ratePerSec != 0U)
+    {
+        refill(t, nowUs);
+        if (t->tokensMilli < 1000U)
+        {
+            t->droppedRate++;
+            t->windowDropped++;
+            t->summaryMode = true;
+            return false;
+        }
+        t->tokensMilli -= 1000U;
+    }
+
+    if (t->labelQuota != 0U)
+    {
+        t->labelUsed[label]++;
+    }
+    t->passed++;
+    t->windowPassed++;
+    return true;
+}
+
+bool LogThrottle_SummaryDue(log_throttle_t *t, uint32_t nowUs, uint32_t *passed, uint32_t *dropped)
+{
+    bool due;
+
+    if ((nowUs - t->windowStartUs) < t->windowUs)
+    {
+        return false;
+    }
+
+    due      = t->summaryMode;
+    *passed  = t->windowPassed;
+    *dropped = t->windowDropped;
+
+    /* Leave summary mode after a clean window */
+    t->summaryMode   = (t->windowDropped != 0U);
+    t->windowStartUs = nowUs;
+    t->windowPassed  = 0U;
+    t->windowDropped = 0U;
+    if (t->labelQuota != 0U)
+    {
+        memset(t->labelUsed, 0, sizeof(t->labelUsed));
+    }
+    return due;
+}
@@ -0,0 +1,60 @@
+#ifndef LOG_THROTTLE_H
+#define LOG_THROTTLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Output rate limiter for the live word print:
+ *   1. sampling      : only every Nth candidate line is considered
+ *   2. label quota   : at most Q lines per label per window
+ *   3. token bucket  : global lines/s with a burst allowance
+ * Once lines are dropped the limiter is "in summary mode": the caller prints
+ * one aggregate line per window (LogThrottle_SummaryDue) until a window
+ * passes without drops. O(1) per line except a 256-entry reset per window.
+ * Time is caller-supplied microseconds (wrap-safe).
+ */
+typedef struct
+{
+    /* Config (0 disables the stage) */
+    uint32_t ratePerSec;
+    uint32_t burst;
+    uint16_t labelQuota;   /* lines per label per window */
+    uint16_t sampleN;      /* print 1 in N */
+    uint32_t windowUs;
+
+    /* State */
+    uint32_t tokensMilli;  /* 1000 = one line */
+    uint32_t lastUs;
+    uint32_t windowStartUs;
+    uint16_t sampleCount;
+    uint16_t labelUsed[256];
+    bool     summaryMode;
+
+    /* Counters: lifetime, and since the last summary */
+    uint32_t passed;
+    uint32_t droppedSample;
+    uint32_t droppedQuota;
+    uint32_t droppedRate;
+    uint32_t windowPassed;
+    uint32_t windowDropped;
+} log_throttle_t;
+
+void LogThrottle_Init(log_throttle_t *t, uint32_t ratePerSec, uint32_t burst,
+                      uint16_t labelQuota, uint16_t sampleN, uint32_t nowUs);
+void LogThrottle_ResetCounters(log_throttle_t *t);
+
+/* True if the line for this label may be printed now. */
+bool LogThrottle_Allow(log_throttle_t *t, uint8_t label, uint32_t nowUs);
+
+/* Poll once per main-loop pass. Closes the window when it has elapsed and
+ * returns true if the caller should print an aggregate line for it;
+ * passed and dropped then hold that window's totals. */
+bool LogThrottle_SummaryDue(log_throttle_t *t, uint32_t nowUs, uint32_t *passed, uint32_t *dropped);
+
+static inline uint32_t LogThrottle_Dropped(const log_throttle_t *t)
+{
+    return t->droppedSample + t->droppedQuota + t->droppedRate;
+}
+
+#endif /* LOG_THROTTLE_H */
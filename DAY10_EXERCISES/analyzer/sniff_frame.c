@@ -0,0 +1,193 @@
+#include "sniff_frame.h"
+
+#include <string.h>
+
+/* CRC-8/MAXIM (same polynomial as the FI lab link frame), table driven. */
+static const uint8_t s_crc8Table[256] = {
+    0x00U, 0x5EU, 0xBCU, 0xE2U, 0x61U, 0x3FU, 0xDDU, 0x83U,
+    0xC2U, 0x9CU, 0x7EU, 0x20U, 0xA3U, 0xFDU, 0x1FU, 0x41U,
+    0x9DU, 0xC3U, 0x21U, 0x7FU, 0xFCU, 0xA2U, 0x40U, 0x1EU,
+    0x5FU, 0x01U, 0xE3U, 0xBDU, 0x3EU, 0x60U, 0x82U, 0xDCU,
+    0x23U, 0x7DU, 0x9FU, 0xC1U, 0x42U, 0x1CU, 0xFEU, 0xA0U,
+    0xE1U, 0xBFU, 0x5DU, 0x03U, 0x80U, 0xDEU, 0x3CU, 0x62U,
+    0xBEU, 0xE0U, 0x02U, 0x5CU, 0xDFU, 0x81U, 0x63U, 0x3DU,
+    0x7CU, 0x22U, 0xC0U, 0x9EU, 0x1DU, 0x43U, 0xA1U, 0xFFU,
+    0x46U, 0x18U, 0xFAU, 0xA4U, 0x27U, 0x79U, 0x9BU, 0xC5U,
+    0x84U, 0xDAU, 0x38U, 0x66U, 0xE5U, 0xBBU, 0x59U, 0x07U,
+    0xDBU, 0x85U, 0x67U, 0x39U, 0xBAU, 0xE4U, 0x06U, 0x58U,
+    0x19U, 0x47U, 0xA5U, 0xFBU, 0x78U, 0x26U, 0xC4U, 0x9AU,
+    0x65U, 0x3BU, 0xD9U, 0x87U, 0x04U, 0x5AU, 0xB8U, 0xE6U,
+    0xA7U, 0xF9U, 0x1BU, 0x45U, 0xC6U, 0x98U, 0x7AU, 0x24U,
+    0xF8U, 0xA6U, 0x44U, 0x1AU, 0x99U, 0xC7U, 0x25U, 0x7BU,
+    0x3AU, 0x64U, 0x86U, 0xD8U, 0x5BU, 0x05U, 0xE7U, 0xB9U,
+    0x8CU, 0xD2U, 0x30U, 0x6EU, 0xEDU, 0xB3U, 0x51U, 0x0FU,
+    0x4EU, 0x10U, 0xF2U, 0xACU, 0x2FU, 0x71U, 0x93U, 0xCDU,
+    0x11U, 0x4FU, 0xADU, 0xF3U, 0x70U, 0x2EU, 0xCCU, 0x92U,
+    0xD3U, 0x8DU, 0x6FU, 0x31U, 0xB2U, 0xECU, 0x0EU, 0x50U,
+    0xAFU, 0xF1U, 0x13U, 0x4DU, 0xCEU, 0x90U, 0x72U, 0x2CU,
+    0x6DU, 0x33U, 0xD1U, 0x8FU, 0x0CU, 0x52U, 0xB0U, 0xEEU,
+    0x32U, 0x6CU, 0x8EU, 0xD0U, 0x53U, 0x0DU, 0xEFU, 0xB1U,
+    0xF0U, 0xAEU, 0x4CU, 0x12U, 0x91U, 0xCFU, 0x2DU, 0x73U,
+    0xCAU, 0x94U, 0x76U, 0x28U, 0xABU, 0xF5U, 0x17U, 0x49U,
+    0x08U, 0x56U, 0xB4U, 0xEAU, 0x69U, 0x37U, 0xD5U, 0x8BU,
+    0x57U, 0x09U, 0xEBU, 0xB5U, 0x36U, 0x68U, 0x8AU, 0xD4U,
+    0x95U, 0xCBU, 0x29U, 0x77U, 0xF4U, 0xAAU, 0x48U, 0x16U,
+    0xE9U, 0xB7U, 0x55U, 0x0BU, 0x88U, 0xD6U, 0x34U, 0x6AU,
+    0x2BU, 0x75U, 0x97U, 0xC9U, 0x4AU, 0x14U, 0xF6U, 0xA8U,
+    0x74U, 0x2AU, 0xC8U, 0x96U, 0x15U, 0x4BU, 0xA9U, 0xF7U,
+    0xB6U, 0xE8U, 0x0AU, 0x54U, 0xD7U, 0x89U, 0x6BU, 0x35U,
+};
+
+static uint8_t crc8(const uint8_t *d, size_t n)
+{
+    uint8_t c = 0U;
+    while (n--)
+    {
+        c = s_crc8Table[c ^ *d++];
+    }
+    return c;
+}
+
+static inline uint32_t rd_le32(const uint8_t *b)
+{
+    return ((uint32_t)b[0]) | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static inline void wr_le32(uint8_t *b, uint32_t v)
+{
+    b[0] = (uint8_t)v;
+    b[1] = (uint8_t)(v >> 8);
+    b[2] = (uint8_t)(v >> 16);
+    b[3] = (uint8_t)(v >> 24);
+}
+
+void SniffFrame_ParserInit(sniff_parser_t *p)
+{
+    memset(p, 0, sizeof(*p));
+}
+
+size_t SniffFrame_Encode(uint8_t out[SNIFF_FRAME_LEN], uint8_t channel, uint32_t word, uint32_t ts_us)
+{
+    out[0] = SNIFF_SYNC0;
+    out[1] = SNIFF_SYNC1;
+    out[2] = channel;
+    wr_le32(&out[3], word);
+    wr_le32(&out[7], ts_us);
+    out[11] = crc8(&out[2], 9U);
+    return SNIFF_FRAME_LEN;
+}
+
+typedef enum
+{
+    FRAME_NEED_MORE = 0,
+    FRAME_OK,
+    FRAME_BAD,
+} frame_check_t;
+
+/* f[0] == SYNC0; have = bytes available from f. */
+static frame_check_t check_frame(sniff_parser_t *p, const uint8_t *f, size_t have,
+                                 sniff_word_cb_t cb, void *user)
+{
+    if (have >= 2U && f[1] != SNIFF_SYNC1)
+    {
+        p->resyncs++;
+        return FRAME_BAD;
+    }
+    if (have < SNIFF_FRAME_LEN)
+    {
+        return FRAME_NEED_MORE;
+    }
+    if (crc8(&f[2], 9U) != f[11])
+    {
+        p->frames_bad_crc++;
+        return FRAME_BAD;
+    }
+
+    sniff_word_t w;
+    w.channel = f[2];
+    w.word    = rd_le32(&f[3]);
+    w.ts_us   = rd_le32(&f[7]);
+    p->frames_ok++;
+    cb(&w, user);
+    return FRAME_OK;
+}
+
+uint32_t SniffFrame_Parse(sniff_parser_t *p, const uint8_t *buf, size_t len,
+                          sniff_word_cb_t cb, void *user)
+{
+    size_t pos = 0;
+    uint32_t n = 0;
+
+    /* 1) Complete a frame carried over from the previous span. */
+    while (p->carry_len != 0U)
+    {
+        const size_t old = p->carry_len;
+        size_t take = SNIFF_FRAME_LEN - old;
+        if (take > len) take = len;
+
+        memcpy(&p->carry[old], buf, take);
+        const size_t have = old + take;
+
+        frame_check_t r = check_frame(p, p->carry, have, cb, user);
+        if (r == FRAME_NEED_MORE)
+        {
+            p->carry_len = (uint8_t)have;
+            return n;
+        }
+        if (r == FRAME_OK)
+        {
+            n++;
+            p->carry_len = 0;
+            pos = take;
+            break;
+        }
+
+        const uint8_t *s = (const uint8_t *)memchr(&p->carry[1], SNIFF_SYNC0, have - 1U);
+        if (s == NULL)
+        {
+            p->carry_len = 0;
+            pos = take;
+            break;
+        }
+        const size_t k = (size_t)(s - p->carry);
+        if (k >= old)
+        {
+            p->carry_len = 0;
+            pos = k - old;
+            break;
+        }
+        memmove(p->carry, &p->carry[k], old - k);
+        p->carry_len = (uint8_t)(old - k);
+    }
+
+    /* 2) Frames validated straight from the span. */
+    while (pos < len)
+    {
+        const uint8_t *s = (const uint8_t *)memchr(&buf[pos], SNIFF_SYNC0, len - pos);
+        if (s == NULL)
+        {
+            break;
+        }
+        pos = (size_t)(s - buf);
+
+        const size_t avail = len - pos;
+        frame_check_t r = check_frame(p, &buf[pos], (avail < SNIFF_FRAME_LEN) ? avail : SNIFF_FRAME_LEN, cb, user);
+        if (r == FRAME_NEED_MORE)
+        {
+            memcpy(p->carry, &buf[pos], avail);
+            p->carry_len = (uint8_t)avail;
+            break;
+        }
+        if (r == FRAME_OK)
+        {
+            n++;
+            pos += SNIFF_FRAME_LEN;
+        }
+        else
+        {
+            pos += 1U;
+        }
+    }
+
+    return n;
+}
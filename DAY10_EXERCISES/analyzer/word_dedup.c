@@ -0,0 +1,53 @@
+#include "word_dedup.h"
+
+#include <string.h>
+
+void WordDedup_Clear(word_dedup_t *d)
+{
+    memset(d->seen, 0, sizeof(d->seen));
+    d->changed    = 0U;
+    d->heartbeats = 0U;
+    d->suppressed = 0U;
+}
+
+void WordDedup_Init(word_dedup_t *d, uint32_t heartbeatMs)
+{
+    d->heartbeatUs = heartbeatMs * 1000U;
+    WordDedup_Clear(d);
+}
+
+bool WordDedup_Check(word_dedup_t *d, uint8_t channel, uint32_t word, uint32_t nowUs)
+{
+    uint32_t slot = (channel < WORD_DEDUP_SLOTS) ? channel : 0U;
+    uint32_t key  = word & (WORD_DEDUP_KEYS - 1U);
+    uint32_t bit  = 1UL << (key & 31U);
+
+    if (((d->seen[slot][key >> 5] & bit) != 0U) &&
+        (((d->last[slot][key] ^ word) & WORD_DEDUP_VALUE_MASK) == 0U) &&
+        ((d->heartbeatUs == 0U) || ((nowUs - d->sentUs[slot][key]) < d->heartbeatUs)))
+    {
+        d->suppressed++;
+        return false;
+    }
+    return true;
+}
+
+void WordDedup_Commit(word_dedup_t *d, uint8_t channel, uint32_t word, uint32_t nowUs)
+{
+    uint32_t slot = (channel < WORD_DEDUP_SLOTS) ? channel : 0U;
+    uint32_t key  = word & (WORD_DEDUP_KEYS - 1U);
+    uint32_t bit  = 1UL << (key & 31U);
+    uint32_t *seen = &d->seen[slot][key >> 5];
+
+    if (((*seen & bit) != 0U) && (((d->last[slot][key] ^ word) & WORD_DEDUP_VALUE_MASK) == 0U))
+    {
+        d->heartbeats++;
+    }
+    else
+    {
+        *seen |= bit;
+        d->changed++;
+        d->last[slot][key] = word;
+    }
+    d->sentUs[slot][key] = nowUs;
+}
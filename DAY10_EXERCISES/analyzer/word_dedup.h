@@ -0,0 +1,53 @@
+#ifndef WORD_DEDUP_H
+#define WORD_DEDUP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "label_stats.h"
+#include "../common/a429_word.h"
+
+/*
+ * Change-only reporting: remembers the last word per (channel, SDI, label)
+ * and passes a word only if its DATA, SSM or parity bit differs from the
+ * previous one, or if the key has not been passed for heartbeatUs (periodic
+ * refresh of unchanged values). The parity bit is part of the compare so a
+ * parity glitch and its recovery are always reported.
+ *
+ * Key = channel slot x word bits 0..9 (label + SDI), a direct table index.
+ * Channel slot 0 covers channel ids outside 1..LABEL_STATS_CHANNELS.
+ * Time is caller-supplied microseconds (wrap-safe).
+ */
+#define WORD_DEDUP_SLOTS      (LABEL_STATS_CHANNELS + 1U)
+#define WORD_DEDUP_KEYS       (1UL << (A429_LABEL_WIDTH + A429_SDI_WIDTH)) /* SDI:label */
+#define WORD_DEDUP_VALUE_MASK (A429_MASK(DATA) | A429_MASK(SSM) | A429_MASK(PARITY))
+
+typedef struct
+{
+    uint32_t heartbeatUs;   /* 0: never refresh unchanged values */
+
+    uint32_t last[WORD_DEDUP_SLOTS][WORD_DEDUP_KEYS];
+    uint32_t sentUs[WORD_DEDUP_SLOTS][WORD_DEDUP_KEYS];
+    uint32_t seen[WORD_DEDUP_SLOTS][WORD_DEDUP_KEYS / 32U];
+
+    uint32_t changed;       /* passed: first sighting or new value */
+    uint32_t heartbeats;    /* passed: unchanged, refresh due */
+    uint32_t suppressed;    /* repeats not passed */
+} word_dedup_t;
+
+void WordDedup_Init(word_dedup_t *d, uint32_t heartbeatMs);
+
+/* Forget all remembered words (the next word of every key passes) and zero
+ * the counters. */
+void WordDedup_Clear(word_dedup_t *d);
+
+/* True if this word should be reported (counts it as suppressed if not).
+ * Nothing is remembered yet: call WordDedup_Commit once the word has
+ * actually been reported, so a word that a later stage (log throttle)
+ * drops is still new to the next check. */
+bool WordDedup_Check(word_dedup_t *d, uint8_t channel, uint32_t word, uint32_t nowUs);
+
+/* Remember word as reported at nowUs. */
+void WordDedup_Commit(word_dedup_t *d, uint8_t channel, uint32_t word, uint32_t nowUs);
+
+#endif /* WORD_DEDUP_H */
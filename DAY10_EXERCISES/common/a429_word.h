@@ -0,0 +1,104 @@
+#ifndef A429_WORD_H
+#define A429_WORD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * ARINC 429 word layout: the one definition used by the analyzer, the FI and
+ * SFI labs and the host tools (include it relative to the including file,
+ * e.g. "../common/a429_word.h").
+ *
+ *   bit  0..7  : label (as transmitted, no bit reversal)
+ *   bit  8..9  : SDI
+ *   bit 10..28 : data (19 bits)
+ *   bit 29..30 : SSM
+ *   bit 31     : parity, odd over all 32 bits
+ *
+ * A429_WORD_FIELDS(X) expands X(Name, NAME, lsb, width) once per field and
+ * generates A429_<NAME>_SHIFT / A429_<NAME>_WIDTH, A429_MAX(NAME) and
+ * A429_MASK(NAME) (constant expressions), and inline A429_Get<Name>() /
+ * A429_Set<Name>(). The static asserts below reject overlapping fields,
+ * gaps and a layout that is not exactly 32 bits.
+ */
+#define A429_WORD_FIELDS(X)         \
+    X(Label,  LABEL,   0U,  8U)     \
+    X(Sdi,    SDI,     8U,  2U)     \
+    X(Data,   DATA,   10U, 19U)     \
+    X(Ssm,    SSM,    29U,  2U)     \
+    X(Parity, PARITY, 31U,  1U)
+
+#define A429_X_ENUM(Name, NAME, lsb, width) A429_##NAME##_SHIFT = (lsb), A429_##NAME##_WIDTH = (width),
+enum
+{
+    A429_WORD_FIELDS(A429_X_ENUM)
+};
+#undef A429_X_ENUM
+
+#define A429_MAX(NAME)  ((1UL << A429_##NAME##_WIDTH) - 1UL)
+#define A429_MASK(NAME) (A429_MAX(NAME) << A429_##NAME##_SHIFT)
+
+#define A429_X_WIDTH(Name, NAME, lsb, width) + (width)
+#define A429_X_MASK(Name, NAME, lsb, width)  | A429_MASK(NAME)
+#define A429_X_FITS(Name, NAME, lsb, width) \
+    _Static_assert(((lsb) + (width)) <= 32U, "A429 field " #NAME " runs past bit 31");
+A429_WORD_FIELDS(A429_X_FITS)
+_Static_assert((0U A429_WORD_FIELDS(A429_X_WIDTH)) == 32U, "A429 fields must add up to 32 bits");
+_Static_assert((0UL A429_WORD_FIELDS(A429_X_MASK)) == 0xFFFFFFFFUL, "A429 fields overlap or leave a gap");
+_Static_assert(A429_PARITY_SHIFT == 31U, "A429 parity must be the MSB");
+#undef A429_X_WIDTH
+#undef A429_X_MASK
+#undef A429_X_FITS
+
+#define A429_X_ACCESSORS(Name, NAME, lsb, width)                                 \
+    static inline uint32_t A429_Get##Name(uint32_t word)                         \
+    {                                                                            \
+        return (word >> A429_##NAME##_SHIFT) & A429_MAX(NAME);                   \
+    }                                                                            \
+    static inline uint32_t A429_Set##Name(uint32_t word, uint32_t value)         \
+    {                                                                            \
+        return (word & ~A429_MASK(NAME)) | ((value & A429_MAX(NAME)) << A429_##NAME##_SHIFT); \
+    }
+A429_WORD_FIELDS(A429_X_ACCESSORS)
+#undef A429_X_ACCESSORS
+
+/* 1 if v has an odd number of set bits. Cortex-M7 has no popcount
+   instruction, so GCC lowers __builtin_parity to libgcc's __paritysi2 (an
+   xor fold). Define A429_PARITY_INLINE_FOLD to inline the fold instead;
+   host/a429_bench times the variants. */
+static inline uint32_t A429_Parity32(uint32_t v)
+{
+#if defined(__GNUC__) && !defined(A429_PARITY_INLINE_FOLD)
+    return (uint32_t)__builtin_parity(v);
+#else
+    v ^= v >> 16;
+    v ^= v >> 8;
+    v ^= v >> 4;
+    return (0x6996U >> (v & 0xFU)) & 1U;
+#endif
+}
+
+/* Parity bit that makes the word odd (bit 31 of the input is ignored). */
+static inline uint32_t A429_ParityBitFor(uint32_t word)
+{
+    return A429_Parity32(word & ~A429_MASK(PARITY)) ^ 1U;
+}
+
+static inline bool A429_ParityOk(uint32_t word)
+{
+    return A429_Parity32(word) != 0U;
+}
+
+/* Assemble a word from its fields (values masked to field width) and set
+   odd parity. */
+static inline uint32_t A429_Pack(uint32_t label, uint32_t sdi, uint32_t data, uint32_t ssm)
+{
+    uint32_t word = ((label & A429_MAX(LABEL)) << A429_LABEL_SHIFT) |
+                    ((sdi & A429_MAX(SDI)) << A429_SDI_SHIFT) |
+                    ((data & A429_MAX(DATA)) << A429_DATA_SHIFT) |
+                    ((ssm & A429_MAX(SSM)) << A429_SSM_SHIFT);
+
+    return word | (A429_ParityBitFor(word) << A429_PARITY_SHIFT);
+}
+
+#endif /* A429_WORD_H */
@@ -0,0 +1,51 @@
+#include "crc32.h"
+
+static const uint32_t s_crcNibble[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+};
+
+uint32_t Crc32_Compute(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (size_t i = 0U; i < len; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ s_crcNibble[crc & 0x0FU];
+        crc = (crc >> 4) ^ s_crcNibble[crc & 0x0FU];
+    }
+    return crc ^ 0xFFFFFFFFUL;
+}
+
+int32_t Crc32_BlockMagic(const uint8_t *buf, size_t len, uint32_t magic)
+{
+    for (size_t i = 0U; (i < len) && (i < 4U); i++)
+    {
+        if (buf[i] != (uint8_t)(magic >> (8U * i)))
+        {
+            return -1;
+        }
+    }
+    return (len >= 4U) ? 1 : 0;
+}
+
+void Crc32_BlockSeal(uint8_t *buf, size_t body)
+{
+    const uint32_t crc = Crc32_Compute(buf, body);
+
+    buf[body]      = (uint8_t)crc;
+    buf[body + 1U] = (uint8_t)(crc >> 8);
+    buf[body + 2U] = (uint8_t)(crc >> 16);
+    buf[body + 3U] = (uint8_t)(crc >> 24);
+}
+
+bool Crc32_BlockValid(const uint8_t *buf, size_t body)
+{
+    const uint32_t crc = (uint32_t)buf[body] | ((uint32_t)buf[body + 1U] << 8) |
+                         ((uint32_t)buf[body + 2U] << 16) | ((uint32_t)buf[body + 3U] << 24);
+
+    return crc == Crc32_Compute(buf, body);
+}
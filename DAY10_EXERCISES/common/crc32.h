@@ -0,0 +1,34 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * CRC32 (IEEE 802.3, reflected 0xEDB88320) and the block framing shared
+ * by the analyzer capture stream (analyzer/capture.h) and the FI log
+ * stream (fi_logstream.h): a little-endian magic u32 first, the CRC32 of
+ * everything before it last.
+ *
+ * Both streams may be interleaved with other bytes (console text, a
+ * capture started mid-block), so their ParseBlock functions share one
+ * resync contract: return the block length, 0 if more bytes are needed,
+ * or -1 if buf does not start with a valid block (bad magic, count or
+ * CRC); on -1 the reader skips a byte and retries.
+ */
+#define CRC32_LEN 4U
+
+/* Nibble table: 64 bytes of table instead of 1 KB, two lookups per byte */
+uint32_t Crc32_Compute(const uint8_t *data, size_t len);
+
+/* Magic check for ParseBlock: 1 if buf starts with magic, 0 if the bytes
+ * there so far match its prefix, -1 if not (rejected early so resync does
+ * not stall on a short buffer). */
+int32_t Crc32_BlockMagic(const uint8_t *buf, size_t len, uint32_t magic);
+
+/* Append / check the CRC of buf[0..body) at buf[body]. */
+void Crc32_BlockSeal(uint8_t *buf, size_t body);
+bool Crc32_BlockValid(const uint8_t *buf, size_t body);
+
+#endif /* CRC32_H */
@@ -0,0 +1,526 @@
+#include "fi_campaign.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FIC_LINE_MAX  96U
+#define FIC_TOK_MAX   8U
+#define FIC_STEP_LEN  16U
+#define FIC_HDR_LEN   8U
+
+static const char *const s_opName[FIC_OP_COUNT] = {
+    "at", "wait", "arm", "disarm", "set", "snap", "expect", "until", "repeat"
+};
+static const char *const s_cmpName[FIC_CMP_COUNT] = {"==", "!=", "<", "<=", ">", ">="};
+
+const char *FICampaign_OpName(uint8_t op)
+{
+    return (op < FIC_OP_COUNT) ? s_opName[op] : "?";
+}
+
+const char *FICampaign_CmpName(uint8_t cmp)
+{
+    return (cmp < FIC_CMP_COUNT) ? s_cmpName[cmp] : "?";
+}
+
+void FICampaign_Init(fic_campaign_t *c, const fic_ops_t *ops)
+{
+    memset(c, 0, sizeof(*c));
+    c->ops = ops;
+}
+
+void FICampaign_Clear(fic_campaign_t *c)
+{
+    c->running   = false;
+    c->stepCount = 0;
+    c->refCount  = 0;
+}
+
+/* ---- Text compiler ---- */
+
+static int lookup(const char *const *names, uint32_t n, const char *s)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (strcmp(names[i], s) == 0)
+            return (int)i;
+    }
+    return -1;
+}
+
+static bool parse_u32(const char *s, uint32_t *out)
+{
+    char *end;
+    unsigned long v;
+
+    if (s == NULL || *s == '\0' || *s == '-')
+        return false;
+    v = strtoul(s, &end, 0);
+    if (*end != '\0' || v > UINT32_MAX)
+        return false;
+    *out = (uint32_t)v;
+    return true;
+}
+
+/* Reference index for a counter name, adding it to the table if new. */
+static int ref_index(fic_campaign_t *c, const char *name)
+{
+    int id = c->ops->counter_id(c->ops->ctx, name);
+    if (id < 0 || id > UINT16_MAX)
+        return -1;
+    for (uint32_t i = 0; i < c->refCount; i++)
+    {
+        if (c->refId[i] == (uint16_t)id)
+            return (int)i;
+    }
+    if (c->refCount >= FIC_MAX_REFS)
+        return -1;
+    c->refId[c->refCount] = (uint16_t)id;
+    return (int)c->refCount++;
+}
+
+/* Compile one step (tok[0] is the op); appends to c->steps on success. */
+static bool compile_step(fic_campaign_t *c, char **tok, uint32_t n)
+{
+    const fic_ops_t *ops = c->ops;
+    fic_step_t s;
+    int op = lookup(s_opName, FIC_OP_COUNT, tok[0]);
+    int id;
+
+    if (op < 0 || c->stepCount >= FIC_MAX_STEPS)
+        return false;
+    if (c->stepCount != 0U && c->steps[c->stepCount - 1U].op == FIC_OP_REPEAT)
+        return false; /* repeat must stay last */
+
+    memset(&s, 0, sizeof(s));
+    s.op = (uint8_t)op;
+
+    switch ((fic_op_t)op)
+    {
+        case FIC_OP_AT:
+        case FIC_OP_WAIT:
+            if (n != 2U || !parse_u32(tok[1], &s.v[0]))
+                return false;
+            break;
+
+        case FIC_OP_ARM:
+        {
+            int pol;
+            if (n < 3U || n > 6U)
+                return false;
+            id  = ops->site_id(ops->ctx, tok[1]);
+            pol = ops->policy_id(ops->ctx, tok[2]);
+            if (id < 0 || id > UINT16_MAX || pol < 0 || pol > UINT8_MAX)
+                return false;
+            s.id  = (uint16_t)id;
+            s.arg = (uint8_t)pol;
+            for (uint32_t i = 3U; i < n; i++)
+            {
+                if (!parse_u32(tok[i], &s.v[i - 3U]))
+                    return false;
+            }
+            break;
+        }
+
+        case FIC_OP_DISARM:
+            if (n != 2U)
+                return false;
+            id = ops->site_id(ops->ctx, tok[1]);
+            if (id < 0 || id > UINT16_MAX)
+                return false;
+            s.id = (uint16_t)id;
+            break;
+
+        case FIC_OP_SET:
+            if (n != 3U || ops->param_id == NULL || ops->set == NULL)
+                return false;
+            id = ops->param_id(ops->ctx, tok[1]);
+            if (id < 0 || id > UINT16_MAX || !parse_u32(tok[2], &s.v[0]))
+                return false;
+            s.id = (uint16_t)id;
+            break;
+
+        case FIC_OP_SNAP:
+            if (n != 1U)
+                return false;
+            break;
+
+        case FIC_OP_EXPECT:
+        case FIC_OP_UNTIL:
+        {
+            int cmp;
+            uint32_t want = (op == FIC_OP_UNTIL) ? 5U : 4U;
+            if (n != want && !(op == FIC_OP_UNTIL && n == 4U))
+                return false;
+            cmp = lookup(s_cmpName, FIC_CMP_COUNT, tok[2]);
+            if (cmp < 0 || !parse_u32(tok[3], &s.v[0]))
+                return false;
+            s.v[1] = FIC_UNTIL_DEFAULT_MS;
+            if (n == 5U && !parse_u32(tok[4], &s.v[1]))
+                return false;
+            id = ref_index(c, tok[1]);
+            if (id < 0)
+                return false;
+            s.arg = (uint8_t)cmp;
+            s.id  = (uint16_t)id;
+            break;
+        }
+
+        case FIC_OP_REPEAT:
+            if (n > 2U || (n == 2U && !parse_u32(tok[1], &s.v[0])))
+                return false;
+            break;
+
+        default:
+            return false;
+    }
+
+    c->steps[c->stepCount++] = s;
+    return true;
+}
+
+/* Split one step in place; returns the token count. */
+static uint32_t tokenize(char *p, char **tok)
+{
+    uint32_t n = 0;
+
+    for (;;)
+    {
+        while (*p == ' ' || *p == '\t')
+            p++;
+        if (*p == '\0' || *p == '#')
+            return n;
+        if (n == FIC_TOK_MAX)
+            return FIC_TOK_MAX + 1U; /* too many */
+        tok[n++] = p;
+        while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '#')
+            p++;
+        if (*p == '#')
+        {
+            *p = '\0';
+            return n;
+        }
+        if (*p != '\0')
+            *p++ = '\0';
+    }
+}
+
+bool FICampaign_Compile(fic_campaign_t *c, const char *text, uint32_t *errLine)
+{
+    const uint8_t steps0 = c->stepCount;
+    const uint8_t refs0  = c->refCount;
+    uint32_t line = 1;
+
+    while (*text != '\0')
+    {
+        char buf[FIC_LINE_MAX];
+        char *tok[FIC_TOK_MAX];
+        uint32_t len = 0;
+        uint32_t n;
+
+        while (text[len] != '\0' && text[len] != '\n' && text[len] != '\r' && text[len] != ';')
+            len++;
+
+        if (len >= sizeof(buf))
+            goto fail;
+        memcpy(buf, text, len);
+        buf[len] = '\0';
+
+        n = tokenize(buf, tok);
+        if (n > FIC_TOK_MAX || (n != 0U && !compile_step(c, tok, n)))
+            goto fail;
+
+        text += len;
+        if (*text != '\0')
+            text++;
+        line++;
+    }
+    return true;
+
+fail:
+    c->stepCount = steps0;
+    c->refCount  = refs0;
+    if (errLine != NULL)
+        *errLine = line;
+    return false;
+}
+
+/* ---- Binary form ---- */
+
+static void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+static size_t refs_len(uint32_t refs)
+{
+    return ((refs * 2U) + 3U) & ~(size_t)3U;
+}
+
+size_t FICampaign_Encode(const fic_campaign_t *c, uint8_t *out, size_t cap)
+{
+    size_t len = FIC_HDR_LEN + refs_len(c->refCount) + ((size_t)c->stepCount * FIC_STEP_LEN);
+    uint8_t *p = out;
+
+    if (len > cap)
+        return 0;
+
+    memset(out, 0, len);
+    put_u32(p, FIC_MAGIC);
+    p[4] = c->stepCount;
+    p[5] = c->refCount;
+    p += FIC_HDR_LEN;
+
+    for (uint32_t i = 0; i < c->refCount; i++)
+        put_u16(p + (i * 2U), c->refId[i]);
+    p += refs_len(c->refCount);
+
+    for (uint32_t i = 0; i < c->stepCount; i++, p += FIC_STEP_LEN)
+    {
+        const fic_step_t *s = &c->steps[i];
+        p[0] = s->op;
+        p[1] = s->arg;
+        put_u16(p + 2, s->id);
+        put_u32(p + 4, s->v[0]);
+        put_u32(p + 8, s->v[1]);
+        put_u32(p + 12, s->v[2]);
+    }
+    return len;
+}
+
+bool FICampaign_Load(fic_campaign_t *c, const uint8_t *blob, size_t len)
+{
+    uint32_t steps, refs;
+    const uint8_t *p;
+
+    if (len < FIC_HDR_LEN || get_u32(blob) != FIC_MAGIC)
+        return false;
+    steps = blob[4];
+    refs  = blob[5];
+    if (steps > FIC_MAX_STEPS || refs > FIC_MAX_REFS ||
+        len != FIC_HDR_LEN + refs_len(refs) + (steps * FIC_STEP_LEN))
+        return false;
+
+    /* Validate before touching the loaded script */
+    p = blob + FIC_HDR_LEN + refs_len(refs);
+    for (uint32_t i = 0; i < steps; i++, p += FIC_STEP_LEN)
+    {
+        uint8_t op = p[0];
+        if (op >= FIC_OP_COUNT)
+            return false;
+        if ((op == FIC_OP_EXPECT || op == FIC_OP_UNTIL) &&
+            (p[1] >= FIC_CMP_COUNT || get_u16(p + 2) >= refs))
+            return false;
+        if (op == FIC_OP_REPEAT && i != steps - 1U)
+            return false;
+        if (op == FIC_OP_SET && c->ops->set == NULL)
+            return false;
+    }
+
+    FICampaign_Clear(c);
+    p = blob + FIC_HDR_LEN;
+    for (uint32_t i = 0; i < refs; i++)
+        c->refId[i] = get_u16(p + (i * 2U));
+    p += refs_len(refs);
+    for (uint32_t i = 0; i < steps; i++, p += FIC_STEP_LEN)
+    {
+        fic_step_t *s = &c->steps[i];
+        s->op   = p[0];
+        s->arg  = p[1];
+        s->id   = get_u16(p + 2);
+        s->v[0] = get_u32(p + 4);
+        s->v[1] = get_u32(p + 8);
+        s->v[2] = get_u32(p + 12);
+    }
+    c->refCount  = (uint8_t)refs;
+    c->stepCount = (uint8_t)steps;
+    return true;
+}
+
+/* ---- Runner ---- */
+
+static void snap(fic_campaign_t *c)
+{
+    for (uint32_t i = 0; i < c->refCount; i++)
+        c->refBase[i] = c->ops->counter(c->ops->ctx, c->refId[i]);
+}
+
+static void begin_iteration(fic_campaign_t *c, uint32_t now)
+{
+    c->pc          = 0;
+    c->iterT0      = now;
+    c->stepEntered = false;
+    snap(c);
+}
+
+static void record(fic_campaign_t *c, const fic_step_t *s, bool pass, uint32_t delta, uint32_t now)
+{
+    fic_result_t r;
+
+    r.iteration = c->iterations;
+    r.step      = c->pc;
+    r.op        = s->op;
+    r.pass      = pass;
+    r.counter   = (s->op == FIC_OP_EXPECT || s->op == FIC_OP_UNTIL) ? c->refId[s->id] : s->id;
+    r.delta     = delta;
+    r.tMs       = now - c->iterT0;
+
+    if (pass)
+    {
+        c->passed++;
+    }
+    else if (c->failed++ == 0U)
+    {
+        c->firstFail = r;
+    }
+    if (c->ops->on_result != NULL)
+        c->ops->on_result(c->ops->ctx, &r);
+}
+
+static bool compare(uint8_t cmp, uint32_t a, uint32_t b)
+{
+    switch (cmp)
+    {
+        case FIC_CMP_EQ: return a == b;
+        case FIC_CMP_NE: return a != b;
+        case FIC_CMP_LT: return a < b;
+        case FIC_CMP_LE: return a <= b;
+        case FIC_CMP_GT: return a > b;
+        default:         return a >= b;
+    }
+}
+
+void FICampaign_Start(fic_campaign_t *c)
+{
+    const fic_step_t *last = (c->stepCount != 0U) ? &c->steps[c->stepCount - 1U] : NULL;
+
+    c->iterations = 0;
+    c->passed     = 0;
+    c->failed     = 0;
+    memset(&c->firstFail, 0, sizeof(c->firstFail));
+    c->repeatsLeft = (last != NULL && last->op == FIC_OP_REPEAT) ? last->v[0] : 0U;
+    c->running     = true;
+    begin_iteration(c, c->ops->now_ms(c->ops->ctx));
+}
+
+void FICampaign_Stop(fic_campaign_t *c)
+{
+    c->running = false;
+}
+
+static void finish(fic_campaign_t *c)
+{
+    c->running = false;
+    if (c->ops->on_done != NULL)
+        c->ops->on_done(c->ops->ctx);
+}
+
+bool FICampaign_Poll(fic_campaign_t *c)
+{
+    const fic_ops_t *ops = c->ops;
+    uint32_t now;
+
+    if (!c->running)
+        return false;
+    now = ops->now_ms(ops->ctx);
+
+    /* Bounded: a script of only instant steps and "repeat" must not spin */
+    for (uint32_t budget = FIC_MAX_STEPS; budget != 0U && c->running; budget--)
+    {
+        const fic_step_t *s;
+        bool pass;
+        uint32_t delta;
+
+        if (c->pc >= c->stepCount)
+        {
+            c->iterations++;
+            finish(c);
+            break;
+        }
+        s = &c->steps[c->pc];
+
+        if (!c->stepEntered)
+        {
+            c->stepEntered = true;
+            c->stepT0      = now;
+        }
+
+        switch ((fic_op_t)s->op)
+        {
+            case FIC_OP_AT:
+                if ((now - c->iterT0) < s->v[0])
+                    return true;
+                break;
+
+            case FIC_OP_WAIT:
+                if ((now - c->stepT0) < s->v[0])
+                    return true;
+                break;
+
+            case FIC_OP_ARM:
+                if (!ops->arm(ops->ctx, s->id, s->arg, s->v))
+                    record(c, s, false, 0, now);
+                break;
+
+            case FIC_OP_DISARM:
+                ops->disarm(ops->ctx, s->id);
+                break;
+
+            case FIC_OP_SET:
+                if (!ops->set(ops->ctx, s->id, s->v[0]))
+                    record(c, s, false, s->v[0], now);
+                break;
+
+            case FIC_OP_SNAP:
+                snap(c);
+                break;
+
+            case FIC_OP_EXPECT:
+            case FIC_OP_UNTIL:
+                delta = ops->counter(ops->ctx, c->refId[s->id]) - c->refBase[s->id];
+                pass  = compare(s->arg, delta, s->v[0]);
+                if (!pass && s->op == FIC_OP_UNTIL && (now - c->stepT0) < s->v[1])
+                    return true;
+                record(c, s, pass, delta, now);
+                break;
+
+            case FIC_OP_REPEAT:
+                c->iterations++;
+                if (s->v[0] != 0U)
+                {
+                    if (c->repeatsLeft == 0U)
+                    {
+                        finish(c);
+                        return false;
+                    }
+                    c->repeatsLeft--;
+                }
+                begin_iteration(c, now);
+                continue;
+
+            default:
+                break;
+        }
+
+        c->pc++;
+        c->stepEntered = false;
+    }
+    return c->running;
+}
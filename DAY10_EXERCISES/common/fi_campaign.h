@@ -0,0 +1,163 @@
+#ifndef FI_CAMPAIGN_H
+#define FI_CAMPAIGN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * FI campaign engine: runs a script of timed steps against an FI framework
+ * through a small ops table, so the same script runs on target (SFI lab,
+ * FI lab) and on a host simulation (host/sfi_sim --campaign, through the
+ * SFI lab's sfi_camp.c adapter). Non-blocking: FICampaign_Poll executes
+ * steps until one has to wait and returns.
+ *
+ * Text form, one step per line or ';'-separated, '#' starts a comment:
+ *   at MS                       wait until MS after iteration start
+ *   wait MS                     wait MS after the previous step
+ *   arm SITE POLICY [A0 A1 A2]  framework policy and arguments
+ *   disarm SITE
+ *   set PARAM VALUE             framework parameter (probability, ...)
+ *   snap                        new counter baseline
+ *   expect CNT OP VALUE         check now, record pass/fail
+ *   until CNT OP VALUE [MS]     wait for the condition, fail after MS
+ *   repeat [N]                  restart from the top N more times (0/none:
+ *                               forever); must be the last step
+ * OP is one of == != < <= > >=. Counters are compared as deltas since the
+ * last snap; every iteration starts with an implicit snap. SITE, POLICY,
+ * PARAM and CNT names are resolved by the ops at compile time.
+ *
+ * Binary form (FICampaign_Encode / FICampaign_Load), all little-endian:
+ *   magic "FIC1" | steps u8 | refs u8 | 0 u16 | ref ids u16 * refs
+ *   (padded to 4) | step 16 * steps = op u8 | arg u8 | id u16 | v u32 * 3
+ * Ids are the framework's, so a binary script is tied to the build family
+ * that encoded it; the text form is the portable one.
+ */
+#ifndef FIC_MAX_STEPS
+#define FIC_MAX_STEPS      32U
+#endif
+#ifndef FIC_MAX_REFS
+#define FIC_MAX_REFS       8U   /* distinct counters per script */
+#endif
+#ifndef FIC_UNTIL_DEFAULT_MS
+#define FIC_UNTIL_DEFAULT_MS 10000U
+#endif
+#define FIC_MAGIC          0x31434946UL /* "FIC1" */
+
+typedef enum
+{
+    FIC_OP_AT = 0,
+    FIC_OP_WAIT,
+    FIC_OP_ARM,
+    FIC_OP_DISARM,
+    FIC_OP_SET,
+    FIC_OP_SNAP,
+    FIC_OP_EXPECT,
+    FIC_OP_UNTIL,
+    FIC_OP_REPEAT,
+    FIC_OP_COUNT
+} fic_op_t;
+
+typedef enum
+{
+    FIC_CMP_EQ = 0,
+    FIC_CMP_NE,
+    FIC_CMP_LT,
+    FIC_CMP_LE,
+    FIC_CMP_GT,
+    FIC_CMP_GE,
+    FIC_CMP_COUNT
+} fic_cmp_t;
+
+/* ARM: arg = policy, id = site, v = arguments
+ * DISARM: id = site      SET: id = param, v[0] = value
+ * AT / WAIT: v[0] = ms   REPEAT: v[0] = count (0 = forever)
+ * EXPECT / UNTIL: arg = cmp, id = ref index, v[0] = value, v[1] = timeout */
+typedef struct
+{
+    uint8_t  op;
+    uint8_t  arg;
+    uint16_t id;
+    uint32_t v[3];
+} fic_step_t;
+
+typedef struct
+{
+    uint32_t iteration;
+    uint16_t step;
+    uint8_t  op;        /* EXPECT / UNTIL; ARM / SET if the framework refused */
+    bool     pass;
+    uint16_t counter;   /* framework counter id (site / param for ARM / SET) */
+    uint32_t delta;     /* counter delta when decided */
+    uint32_t tMs;       /* ms since iteration start */
+} fic_result_t;
+
+/* Name lookups return -1 if unknown. */
+typedef struct
+{
+    void *ctx;
+    uint32_t (*now_ms)(void *ctx);
+
+    int  (*site_id)(void *ctx, const char *name);
+    int  (*policy_id)(void *ctx, const char *name);
+    int  (*param_id)(void *ctx, const char *name);     /* may be NULL */
+    int  (*counter_id)(void *ctx, const char *name);
+
+    bool (*arm)(void *ctx, uint16_t site, uint8_t policy, const uint32_t v[3]);
+    void (*disarm)(void *ctx, uint16_t site);
+    bool (*set)(void *ctx, uint16_t param, uint32_t value); /* may be NULL */
+    uint32_t (*counter)(void *ctx, uint16_t id);
+
+    void (*on_result)(void *ctx, const fic_result_t *r);    /* may be NULL */
+    void (*on_done)(void *ctx);                             /* may be NULL */
+} fic_ops_t;
+
+typedef struct
+{
+    const fic_ops_t *ops;
+
+    fic_step_t steps[FIC_MAX_STEPS];
+    uint16_t   refId[FIC_MAX_REFS];
+    uint32_t   refBase[FIC_MAX_REFS];
+    uint8_t    stepCount;
+    uint8_t    refCount;
+
+    /* Run state */
+    bool       running;
+    uint8_t    pc;
+    uint32_t   iterT0;      /* iteration start */
+    uint32_t   stepT0;      /* WAIT / UNTIL entry */
+    bool       stepEntered;
+    uint32_t   repeatsLeft;
+
+    /* Totals since FICampaign_Start */
+    uint32_t   iterations;  /* completed */
+    uint32_t   passed;
+    uint32_t   failed;
+    fic_result_t firstFail; /* valid if failed != 0 */
+} fic_campaign_t;
+
+void FICampaign_Init(fic_campaign_t *c, const fic_ops_t *ops);
+
+/* Drop the script (stops a running campaign). */
+void FICampaign_Clear(fic_campaign_t *c);
+
+/* Append steps from text (lines and/or ';'-separated). On error nothing is
+ * appended and *errLine (if given) is the 1-based failing line/step. */
+bool FICampaign_Compile(fic_campaign_t *c, const char *text, uint32_t *errLine);
+
+/* Binary form; Encode returns the length written, 0 if cap is too small.
+ * Load replaces the script and validates ops, ids and repeat placement. */
+size_t FICampaign_Encode(const fic_campaign_t *c, uint8_t *out, size_t cap);
+bool   FICampaign_Load(fic_campaign_t *c, const uint8_t *blob, size_t len);
+
+void FICampaign_Start(fic_campaign_t *c);
+void FICampaign_Stop(fic_campaign_t *c);
+
+/* Run ready steps; returns true while the campaign is running. */
+bool FICampaign_Poll(fic_campaign_t *c);
+
+const char *FICampaign_OpName(uint8_t op);
+const char *FICampaign_CmpName(uint8_t cmp);
+
+#endif /* FI_CAMPAIGN_H */
@@ -0,0 +1,769 @@
+#include "fi_core.h"
+
+#include <string.h>
+
+enum
+{
+    ARM_TIME = FI_TRIG_COUNT,
+    ARM_ALWAYS,
+    ARM_COUNT
+};
+
+static const char *const s_armName[ARM_COUNT] = {
+    "off", "prob", "every", "nth", "window", "burst", "time", "always"
+};
+
+FI_CORE_TLS volatile uint32_t g_fiActive;
+
+static FI_CORE_TLS fi_core_site_t s_site[FI_CORE_SITES];
+static FI_CORE_TLS uint32_t s_armed;
+static FI_CORE_TLS uint32_t s_mask;
+static FI_CORE_TLS bool     s_enabled;
+static FI_CORE_TLS uint32_t s_rng;
+static FI_CORE_TLS uint32_t s_nowMs;
+static FI_CORE_TLS uint32_t (*s_clock)(void);
+
+/* Single-producer (one context) / single-consumer (FICore_LogRead) ring:
+ * wr is written by the producer only, rd and nothing else by the reader.
+ * patch is odd while FICore_LogDetail rewrites the newest record. */
+typedef struct
+{
+    fi_core_event_t rec[FI_CORE_LOG_DEPTH];
+    uint32_t wr;
+    uint32_t rd;
+    uint32_t drops;
+    uint32_t patch;
+    bool     lastLogged;   /* the producer's latest fire is rec[wr - 1] */
+} fi_log_ring_t;
+
+static FI_CORE_TLS fi_log_ring_t s_log[FI_CORE_LOG_CTX];
+
+/* Record / replay state (stream format in fi_core.h) */
+#define RR_HDR_LEN      8U
+#define RR_FIRE_MAX     14U                               /* varint 10 + rng 4 */
+#define RR_TRAILER_MAX  (1U + 4U + (FI_CORE_SITES * 5U))
+
+typedef struct
+{
+    uint8_t        mode;
+    bool           overflow;
+    uint8_t       *wbuf;
+    const uint8_t *rbuf;
+    uint32_t       cap;
+    uint32_t       len;
+    uint32_t       fires;
+    uint32_t       recFires;
+    uint32_t       diverged;
+    uint32_t       calls[FI_CORE_SITES];
+    uint32_t       mark[FI_CORE_SITES];    /* record: call of the last fire; replay: of the next, 0 none */
+    uint32_t       pos[FI_CORE_SITES];     /* replay: offset of that fire's rng */
+    uint32_t       total[FI_CORE_SITES];   /* replay: recorded calls */
+} fi_rr_t;
+
+static FI_CORE_TLS fi_rr_t s_rr;
+
+static void update_active(void)
+{
+    /* Record / replay see every call of every site */
+    if (s_rr.mode != FI_CORE_RR_OFF)
+        g_fiActive = 0xFFFFFFFFU;
+    else
+        g_fiActive = s_enabled ? (s_mask & s_armed) : 0U;
+}
+
+void FICore_Init(uint32_t seed)
+{
+    memset(s_site, 0, sizeof(s_site));
+    for (uint32_t i = 0; i < FI_CORE_SITES; i++)
+    {
+        s_site[i].cfg.pct = 100U;
+    }
+    s_armed   = 0U;
+    s_mask    = 0xFFFFFFFFU;
+    s_enabled = true;
+    memset(s_log, 0, sizeof(s_log));
+    memset(&s_rr, 0, sizeof(s_rr));
+    FICore_SetSeed(seed);
+    update_active();
+}
+
+void FICore_SetClock(uint32_t (*nowMs)(void)) { s_clock = nowMs; }
+void FICore_SetNowMs(uint32_t nowMs) { s_nowMs = nowMs; }
+
+uint32_t FICore_NowMs(void)
+{
+    return (s_clock != NULL) ? s_clock() : s_nowMs;
+}
+
+void FICore_SetEnabled(bool en)
+{
+    s_enabled = en;
+    update_active();
+}
+
+bool FICore_IsEnabled(void) { return s_enabled; }
+
+void FICore_SetMask(uint32_t mask)
+{
+    s_mask = mask;
+    update_active();
+}
+
+uint32_t FICore_GetMask(void) { return s_mask; }
+
+void FICore_SetSeed(uint32_t seed)
+{
+    s_rng = (seed != 0U) ? seed : 0xA5A5A5A5U;
+}
+
+uint32_t FICore_Rand32(void)
+{
+    /* xorshift32: deterministic per seed, no multiply */
+    uint32_t x = s_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rng = x;
+    return x;
+}
+
+/* 0..99 from the high bits (multiply-high, no divide) */
+uint8_t FICore_RandPct(void)
+{
+    return (uint8_t)(((uint64_t)FICore_Rand32() * 100U) >> 32);
+}
+
+void FICore_Arm(uint32_t site, const fi_core_cfg_t *cfg)
+{
+    fi_core_site_t *s;
+
+    if (site >= FI_CORE_SITES)
+        return;
+    s = &s_site[site];
+    s->cfg = *cfg;
+    s->cfg.flags &= (uint8_t)~FI_CORE_F_NTH_DONE;
+    if ((cfg->trig == FI_TRIG_EVERY_N || cfg->trig == FI_TRIG_BURST) && cfg->n == 0U)
+        s->cfg.trig = FI_TRIG_OFF;
+    s->phase = (s->cfg.trig == FI_TRIG_EVERY_N) ? s->cfg.n : 0U;
+
+    if (s->cfg.trig != FI_TRIG_OFF && s->cfg.trig < FI_TRIG_COUNT)
+        s_armed |= 1UL << site;
+    else
+        s_armed &= ~(1UL << site);
+    update_active();
+}
+
+void FICore_Disarm(uint32_t site)
+{
+    if (site >= FI_CORE_SITES)
+        return;
+    s_site[site].cfg.trig = FI_TRIG_OFF;
+    s_armed &= ~(1UL << site);
+    update_active();
+}
+
+void FICore_DisarmAll(void)
+{
+    for (uint32_t i = 0; i < FI_CORE_SITES; i++)
+        s_site[i].cfg.trig = FI_TRIG_OFF;
+    s_armed = 0U;
+    update_active();
+}
+
+void FICore_SetPct(uint32_t site, uint8_t pct)
+{
+    if (site < FI_CORE_SITES)
+        s_site[site].cfg.pct = pct;
+}
+
+void FICore_SetTimeGate(uint32_t site, bool on, uint32_t t0, uint32_t t1)
+{
+    fi_core_cfg_t *c;
+
+    if (site >= FI_CORE_SITES)
+        return;
+    c = &s_site[site].cfg;
+    c->t0 = t0;
+    c->t1 = t1;
+    if (on)
+        c->flags |= FI_CORE_F_TIME_GATE;
+    else
+        c->flags &= (uint8_t)~FI_CORE_F_TIME_GATE;
+}
+
+const fi_core_site_t *FICore_Site(uint32_t site)
+{
+    return (site < FI_CORE_SITES) ? &s_site[site] : NULL;
+}
+
+void FICore_ArmDefault(const fi_site_desc_t *d, uint8_t pct, uint8_t flags)
+{
+    if (d->id >= FI_CORE_SITES)
+        return;
+    s_site[d->id].cfg.pct   = pct;
+    s_site[d->id].cfg.flags = flags;
+    (void)FICore_ArmArgs(d->id, (int)d->policy, d->arg);
+}
+
+int FICore_ArmPolicyId(const char *name)
+{
+    for (int i = 0; i < (int)ARM_COUNT; i++)
+    {
+        if (name != NULL && strcmp(s_armName[i], name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+const char *FICore_ArmPolicyName(int id)
+{
+    return (id >= 0 && id < (int)ARM_COUNT) ? s_armName[id] : "?";
+}
+
+const char *FICore_TrigName(uint8_t trig)
+{
+    return (trig < FI_TRIG_COUNT) ? s_armName[trig] : "?";
+}
+
+bool FICore_ArmArgs(uint32_t site, int policy, const uint32_t v[3])
+{
+    fi_core_site_t *s;
+    fi_core_cfg_t c;
+    uint32_t now;
+
+    if (site >= FI_CORE_SITES)
+        return false;
+    s = &s_site[site];
+
+    /* Gates change in place: the trigger keeps its state */
+    if (policy == ARM_TIME)
+    {
+        if (v[1] < v[0])
+            return false;
+        now = FICore_NowMs();
+        FICore_SetTimeGate(site, true, now + v[0], now + v[1]);
+        return true;
+    }
+    if (policy == ARM_ALWAYS)
+    {
+        FICore_SetTimeGate(site, false, 0U, 0U);
+        FICore_SetPct(site, 100U);
+        return true;
+    }
+
+    /* Triggers keep pct, gate and flags; param only if given */
+    c = s->cfg;
+    switch (policy)
+    {
+        case FI_TRIG_OFF:
+            FICore_Disarm(site);
+            return true;
+        case FI_TRIG_PROB:
+            if (v[0] > 100U)
+                return false;
+            if (v[0] != 0U)
+                c.pct = (uint8_t)v[0];
+            break;
+        case FI_TRIG_EVERY_N:
+            if (v[0] == 0U)
+                return false;
+            c.n = v[0];
+            if (v[1] != 0U)
+                c.param = (uint8_t)v[1];
+            break;
+        case FI_TRIG_NTH:
+            if (v[0] == 0U)
+                return false;
+            c.n = v[0];
+            break;
+        case FI_TRIG_HIT_WINDOW:
+            if (v[1] < v[0])
+                return false;
+            c.a = s->hits + v[0];
+            c.b = s->hits + v[1];
+            if (v[2] != 0U)
+                c.param = (uint8_t)v[2];
+            break;
+        case FI_TRIG_BURST:
+            if (v[0] == 0U || v[1] > v[0])
+                return false;
+            c.n = v[0];
+            c.a = v[1];
+            break;
+        default:
+            return false;
+    }
+    c.trig = (uint8_t)policy;
+    FICore_Arm(site, &c);
+    return true;
+}
+
+void FICore_NotifyEvent(uint32_t site)
+{
+    if (site < FI_CORE_SITES)
+        s_site[site].events++;
+}
+
+static void log_fire(uint32_t site, uint32_t hit)
+{
+    const uint32_t ctx = FI_CORE_CONTEXT();
+    fi_log_ring_t *r = &s_log[ctx];
+    const uint32_t wr = r->wr;
+    fi_core_event_t *e;
+
+    if ((wr - __atomic_load_n(&r->rd, __ATOMIC_ACQUIRE)) >= FI_CORE_LOG_DEPTH)
+    {
+        r->drops++;
+        r->lastLogged = false;
+        return;
+    }
+    e = &r->rec[wr & (FI_CORE_LOG_DEPTH - 1U)];
+    e->tsMs  = FICore_NowMs();
+    e->site  = (uint8_t)site;
+    e->ctx   = (uint8_t)ctx;
+    e->extra = 0U;
+    e->hit   = hit;
+    e->data  = 0U;
+    r->lastLogged = true;
+    __atomic_store_n(&r->wr, wr + 1U, __ATOMIC_RELEASE);
+}
+
+/* Triggers, gates and RNG for an active site */
+static bool decide(uint32_t site)
+{
+    fi_core_site_t *s = &s_site[site];
+    fi_core_cfg_t *c = &s->cfg;
+    uint32_t hit = ++s->hits;
+
+    if ((c->flags & FI_CORE_F_TIME_GATE) != 0U &&
+        (FICore_NowMs() - c->t0) >= (c->t1 - c->t0))
+        return false;
+
+    switch (c->trig)
+    {
+        case FI_TRIG_PROB:
+            break;
+        case FI_TRIG_EVERY_N:
+            if (--s->phase != 0U)
+                return false;
+            s->phase = c->n;
+            break;
+        case FI_TRIG_NTH:
+            if ((c->flags & FI_CORE_F_NTH_DONE) != 0U ||
+                (((c->flags & FI_CORE_F_EVENTS) != 0U) ? s->events : hit) != c->n)
+                return false;
+            c->flags |= FI_CORE_F_NTH_DONE;
+            break;
+        case FI_TRIG_HIT_WINDOW:
+            if ((hit - c->a) >= (c->b - c->a))
+                return false;
+            break;
+        case FI_TRIG_BURST:
+        {
+            uint32_t pos = s->phase;
+            s->phase = (pos + 1U < c->n) ? (pos + 1U) : 0U;
+            if (pos >= c->a)
+                return false;
+            break;
+        }
+        default:
+            return false;
+    }
+
+    if (c->pct < 100U && FICore_RandPct() >= c->pct)
+        return false;
+
+    s->fires++;
+    log_fire(site, hit);
+    return true;
+}
+
+/* --- record / replay --- */
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t put_varint(uint8_t *p, uint64_t v)
+{
+    uint32_t n = 0U;
+
+    while (v >= 0x80U)
+    {
+        p[n++] = (uint8_t)(v | 0x80U);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+/* NULL if the varint runs past end or over 64 bits */
+static const uint8_t *get_varint(const uint8_t *p, const uint8_t *end, uint64_t *v)
+{
+    uint64_t x = 0U;
+
+    for (uint32_t shift = 0U; (p < end) && (shift < 64U); shift += 7U)
+    {
+        const uint8_t b = *p++;
+        x |= (uint64_t)(b & 0x7FU) << shift;
+        if ((b & 0x80U) == 0U)
+        {
+            *v = x;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+static bool record_decide(uint32_t site)
+{
+    const uint32_t active = s_enabled ? (s_mask & s_armed) : 0U;
+    const uint32_t call = ++s_rr.calls[site];
+
+    if (((active >> site) & 1U) == 0U || !decide(site))
+        return false;
+
+    /* Room for this fire and the trailer, or the recording ends here */
+    if (s_rr.overflow || (s_rr.len + RR_FIRE_MAX + RR_TRAILER_MAX) > s_rr.cap)
+    {
+        s_rr.overflow = true;
+        return true;
+    }
+    s_rr.len += put_varint(&s_rr.wbuf[s_rr.len], ((uint64_t)(call - s_rr.mark[site]) << 5) | site);
+    put_u32(&s_rr.wbuf[s_rr.len], s_rng);
+    s_rr.len += 4U;
+    s_rr.mark[site] = call;
+    s_rr.fires++;
+    return true;
+}
+
+/* Next fire of site from the stream offset off (the stream parsed at start) */
+static void replay_seek(uint32_t site, uint32_t off)
+{
+    const uint8_t *p = &s_rr.rbuf[off];
+    const uint8_t *end = &s_rr.rbuf[s_rr.len];
+    const uint32_t prev = s_rr.mark[site];
+    uint64_t v;
+
+    s_rr.mark[site] = 0U;
+    while ((p < end) && (*p != 0U) && ((p = get_varint(p, end, &v)) != NULL))
+    {
+        if ((v & 31U) == site)
+        {
+            s_rr.mark[site] = prev + (uint32_t)(v >> 5);
+            s_rr.pos[site]  = (uint32_t)(p - s_rr.rbuf);
+            return;
+        }
+        p += 4;
+    }
+}
+
+static bool replay_decide(uint32_t site)
+{
+    fi_core_site_t *s = &s_site[site];
+    const uint32_t call = ++s_rr.calls[site];
+
+    s->hits = call;
+    if (call > s_rr.total[site])
+        s_rr.diverged |= 1UL << site;
+    if (s_rr.mark[site] != call)
+        return false;
+
+    s_rng = get_u32(&s_rr.rbuf[s_rr.pos[site]]);
+    replay_seek(site, s_rr.pos[site] + 4U);
+    s_rr.fires++;
+    s->fires++;
+    log_fire(site, call);
+    return true;
+}
+
+bool FICore_Decide(uint32_t site)
+{
+    switch (s_rr.mode)
+    {
+        case FI_CORE_RR_RECORD:
+            return record_decide(site);
+        case FI_CORE_RR_REPLAY:
+            return replay_decide(site);
+        default:
+            return decide(site);
+    }
+}
+
+bool FICore_RecordStart(uint8_t *buf, uint32_t cap)
+{
+    if (buf == NULL || cap < (RR_HDR_LEN + RR_TRAILER_MAX + RR_FIRE_MAX))
+        return false;
+    memset(&s_rr, 0, sizeof(s_rr));
+    s_rr.wbuf = buf;
+    s_rr.cap  = cap;
+    put_u32(&buf[0], FI_CORE_RR_MAGIC);
+    put_u32(&buf[4], s_rng);
+    s_rr.len  = RR_HDR_LEN;
+    s_rr.mode = FI_CORE_RR_RECORD;
+    update_active();
+    return true;
+}
+
+uint32_t FICore_RecordStop(void)
+{
+    uint32_t mask = 0U;
+
+    if (s_rr.mode != FI_CORE_RR_RECORD)
+        return 0U;
+    for (uint32_t i = 0; i < FI_CORE_SITES; i++)
+    {
+        if (s_rr.calls[i] != 0U)
+            mask |= 1UL << i;
+    }
+    s_rr.wbuf[s_rr.len++] = 0U;
+    put_u32(&s_rr.wbuf[s_rr.len], mask);
+    s_rr.len += 4U;
+    for (uint32_t i = 0; i < FI_CORE_SITES; i++)
+    {
+        if (s_rr.calls[i] != 0U)
+            s_rr.len += put_varint(&s_rr.wbuf[s_rr.len], s_rr.calls[i]);
+    }
+    s_rr.mode = FI_CORE_RR_OFF;
+    update_active();
+    return s_rr.len;
+}
+
+bool FICore_ReplayStart(const uint8_t *buf, uint32_t len)
+{
+    fi_core_rr_iter_t it;
+    fi_core_rr_fire_t f;
+    uint32_t rng0, fires = 0U;
+    uint32_t total[FI_CORE_SITES];
+
+    if (!FICore_RRIterInit(&it, buf, len, &rng0))
+        return false;
+    while (FICore_RRIterNext(&it, &f))
+        fires++;
+    /* Only a valid stream replaces the current state (and a recording) */
+    if (!FICore_RRIterTotals(&it, total))
+        return false;
+
+    memset(&s_rr, 0, sizeof(s_rr));
+    memcpy(s_rr.total, total, sizeof(s_rr.total));
+    s_rr.rbuf     = buf;
+    s_rr.len      = len;
+    s_rr.recFires = fires;
+    for (uint32_t i = 0; i < FI_CORE_SITES; i++)
+    {
+        s_site[i].hits = 0U;
+        replay_seek(i, RR_HDR_LEN);
+    }
+    s_rng = rng0;
+    s_rr.mode = FI_CORE_RR_REPLAY;
+    update_active();
+    return true;
+}
+
+void FICore_ReplayStop(void)
+{
+    if (s_rr.mode == FI_CORE_RR_REPLAY)
+    {
+        s_rr.mode = FI_CORE_RR_OFF;
+        update_active();
+    }
+}
+
+static int hex_nibble(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+bool FICore_RRLoadHex(uint8_t *buf, uint32_t cap, uint32_t *len, uint32_t off, const char *hex)
+{
+    size_t digits;
+    uint32_t n;
+
+    if (buf == NULL || hex == NULL)
+        return false;
+    digits = strlen(hex);
+    if (digits == 0U || (digits & 1U) != 0U || off > cap || (digits / 2U) > (size_t)(cap - off))
+        return false;
+    for (size_t i = 0; i < digits; i++)
+    {
+        if (hex_nibble(hex[i]) < 0)
+            return false;
+    }
+
+    /* buf is about to change under a replay or recording of it */
+    if ((s_rr.mode == FI_CORE_RR_REPLAY && s_rr.rbuf == buf) ||
+        (s_rr.mode == FI_CORE_RR_RECORD && s_rr.wbuf == buf))
+    {
+        s_rr.mode = FI_CORE_RR_OFF;
+        update_active();
+    }
+
+    n = (uint32_t)(digits / 2U);
+    for (uint32_t i = 0; i < n; i++)
+        buf[off + i] = (uint8_t)((hex_nibble(hex[2U * i]) << 4) | hex_nibble(hex[(2U * i) + 1U]));
+    if (off + n > *len)
+        *len = off + n;
+    return true;
+}
+
+void FICore_RRStat(fi_core_rr_stat_t *out)
+{
+    out->mode     = s_rr.mode;
+    out->overflow = s_rr.overflow;
+    out->len      = s_rr.len;
+    out->fires    = s_rr.fires;
+    out->pending  = (s_rr.mode == FI_CORE_RR_REPLAY) ? (s_rr.recFires - s_rr.fires) : 0U;
+    out->diverged = s_rr.diverged;
+}
+
+bool FICore_RRIterInit(fi_core_rr_iter_t *it, const uint8_t *buf, uint32_t len, uint32_t *rng0)
+{
+    memset(it, 0, sizeof(*it));
+    if (buf == NULL || len < (RR_HDR_LEN + 5U) || get_u32(buf) != FI_CORE_RR_MAGIC)
+    {
+        it->err = true;
+        return false;
+    }
+    it->p   = &buf[RR_HDR_LEN];
+    it->end = &buf[len];
+    if (rng0 != NULL)
+        *rng0 = get_u32(&buf[4]);
+    return true;
+}
+
+bool FICore_RRIterNext(fi_core_rr_iter_t *it, fi_core_rr_fire_t *out)
+{
+    const uint8_t *p;
+    uint64_t v;
+
+    if (it->err || it->p >= it->end || *it->p == 0U)
+        return false;
+    p = get_varint(it->p, it->end, &v);
+    if (p == NULL || (it->end - p) < 4 || (v >> 5) == 0U || (v >> 37) != 0U)
+    {
+        it->err = true;
+        return false;
+    }
+    out->site = (uint8_t)(v & 31U);
+    out->call = it->calls[out->site] + (uint32_t)(v >> 5);
+    out->rng  = get_u32(p);
+    it->calls[out->site] = out->call;
+    it->p = p + 4;
+    return true;
+}
+
+bool FICore_RRIterTotals(fi_core_rr_iter_t *it, uint32_t totals[FI_CORE_SITES])
+{
+    const uint8_t *p = it->p;
+    uint32_t mask;
+    uint64_t v;
+
+    if (it->err || (it->end - p) < 5 || *p != 0U)
+        return false;
+    mask = get_u32(p + 1);
+    p += 5;
+    for (uint32_t i = 0; i < FI_CORE_SITES; i++)
+    {
+        totals[i] = 0U;
+        if ((mask & (1UL << i)) == 0U)
+        {
+            if (it->calls[i] != 0U)
+                return false;
+            continue;
+        }
+        p = get_varint(p, it->end, &v);
+        if (p == NULL || v > 0xFFFFFFFFU || v < it->calls[i])
+            return false;
+        totals[i] = (uint32_t)v;
+    }
+    return true;
+}
+
+void FICore_LogDetail(uint32_t site, uint32_t extra, uint32_t data)
+{
+    fi_log_ring_t *r = &s_log[FI_CORE_CONTEXT()];
+    uint32_t wr = r->wr;
+    fi_core_event_t *e;
+
+    /* Runs in the writer's context, so only "already read" can change */
+    if (!r->lastLogged || wr == __atomic_load_n(&r->rd, __ATOMIC_ACQUIRE))
+        return;
+    e = &r->rec[(wr - 1U) & (FI_CORE_LOG_DEPTH - 1U)];
+    if (e->site == site)
+    {
+        __atomic_store_n(&r->patch, r->patch + 1U, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        e->extra = (uint16_t)extra;
+        e->data  = data;
+        __atomic_store_n(&r->patch, r->patch + 1U, __ATOMIC_RELEASE);
+    }
+}
+
+bool FICore_LogRead(fi_core_event_t *out)
+{
+    fi_log_ring_t *best = NULL;
+    const fi_core_event_t *head = NULL;
+
+    for (uint32_t i = 0; i < FI_CORE_LOG_CTX; i++)
+    {
+        fi_log_ring_t *r = &s_log[i];
+        const fi_core_event_t *e;
+
+        if (__atomic_load_n(&r->wr, __ATOMIC_ACQUIRE) == r->rd)
+            continue;
+        e = &r->rec[r->rd & (FI_CORE_LOG_DEPTH - 1U)];
+        if (head == NULL || (int32_t)(e->tsMs - head->tsMs) < 0)
+        {
+            best = r;
+            head = e;
+        }
+    }
+    if (best == NULL)
+        return false;
+
+    /* A patch can only come from a context that interrupted this copy and
+     * has finished by the time it resumes: copy until none overlapped. */
+    for (;;)
+    {
+        const uint32_t seq = __atomic_load_n(&best->patch, __ATOMIC_ACQUIRE);
+        *out = *head;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if ((seq & 1U) == 0U && seq == __atomic_load_n(&best->patch, __ATOMIC_RELAXED))
+            break;
+    }
+    __atomic_store_n(&best->rd, best->rd + 1U, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t FICore_LogPending(void)
+{
+    uint32_t n = 0U;
+
+    for (uint32_t i = 0; i < FI_CORE_LOG_CTX; i++)
+        n += __atomic_load_n(&s_log[i].wr, __ATOMIC_ACQUIRE) - s_log[i].rd;
+    return n;
+}
+
+uint32_t FICore_LogDrops(void)
+{
+    uint32_t n = 0U;
+
+    for (uint32_t i = 0; i < FI_CORE_LOG_CTX; i++)
+        n += s_log[i].drops;
+    return n;
+}
@@ -0,0 +1,269 @@
+#ifndef FI_CORE_H
+#define FI_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fi_site.h"
+
+/*
+ * FI core shared by the FI lab (feature bits) and the SFI lab (site enum):
+ * up to 32 sites, each with one trigger plus two optional gates, one
+ * decision function and one event log.
+ *
+ *   decision = enabled & mask & armed          (one bit test, inline)
+ *            & time gate   [t0, t1) ms          (FI_CORE_F_TIME_GATE)
+ *            & trigger     (table below)
+ *            & pct gate    rand < pct           (pct < 100 only)
+ *
+ *   trigger       n            a / b
+ *   PROB          -            -                every hit
+ *   EVERY_N       period       -                hits n, 2n, ... after arming
+ *   NTH           count        -                once, when hits (or events
+ *                                               with FI_CORE_F_EVENTS) == n
+ *   HIT_WINDOW    -            [a, b) hits      hit counter since FICore_Init
+ *   BURST         period       a = length       first a hits of every n
+ *
+ * Hits are counted only while a site is active (enabled, unmasked and
+ * armed), so a disabled site costs the inline test and nothing else.
+ * Every fire is logged (time, site, hit); the call site may attach two
+ * words of detail with FICore_LogDetail.
+ *
+ * Log: one ring per execution context (FI_CORE_CONTEXT), each with a
+ * single writer, so a fire never takes a lock or masks interrupts. A full
+ * ring drops the new record and counts it. FICore_LogRead is the single
+ * reader: it merges the rings oldest first by timestamp. Call it from
+ * thread context (main loop). FICore_LogDetail patches a record that is
+ * already published; a per-ring sequence count makes the reader copy it
+ * again if a patch from an interrupting context overlapped the copy.
+ */
+#define FI_CORE_SITES      32U
+#ifndef FI_CORE_LOG_DEPTH
+#define FI_CORE_LOG_DEPTH  64U    /* records per context, power of two */
+#endif
+#ifndef FI_CORE_LOG_CTX
+#define FI_CORE_LOG_CTX    2U
+#endif
+
+/* Ring index of the caller, < FI_CORE_LOG_CTX. Default: Cortex-M thread
+ * mode 0, handler mode 1 (fires from handlers must then come from one
+ * priority level; map priorities to more rings otherwise). */
+#ifndef FI_CORE_CONTEXT
+#if defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'M')
+static inline uint32_t FICore_Context(void)
+{
+    uint32_t ipsr;
+    __asm volatile("mrs %0, ipsr" : "=r"(ipsr));
+    return (ipsr != 0U) ? 1U : 0U;
+}
+#define FI_CORE_CONTEXT() FICore_Context()
+#else
+#define FI_CORE_CONTEXT() 0U
+#endif
+#endif
+
+typedef enum
+{
+    FI_TRIG_OFF = 0,
+    FI_TRIG_PROB,
+    FI_TRIG_EVERY_N,
+    FI_TRIG_NTH,
+    FI_TRIG_HIT_WINDOW,
+    FI_TRIG_BURST,
+    FI_TRIG_COUNT
+} fi_trig_t;
+
+#define FI_CORE_F_TIME_GATE  0x01U
+#define FI_CORE_F_EVENTS     0x02U   /* NTH counts FICore_NotifyEvent */
+#define FI_CORE_F_NTH_DONE   0x80U   /* state: NTH already fired */
+
+typedef struct
+{
+    uint8_t  trig;    /* fi_trig_t */
+    uint8_t  pct;     /* probability gate, >= 100: always */
+    uint8_t  flags;   /* FI_CORE_F_* */
+    uint8_t  param;   /* site-specific (bits to flip, ...) */
+    uint32_t n;
+    uint32_t a;
+    uint32_t b;
+    uint32_t t0;      /* time gate, ms */
+    uint32_t t1;
+} fi_core_cfg_t;
+
+typedef struct
+{
+    fi_core_cfg_t cfg;
+    uint32_t hits;
+    uint32_t events;
+    uint32_t fires;
+    uint32_t phase;   /* EVERY_N countdown, BURST position */
+} fi_core_site_t;
+
+/* 16-byte log record (fi_logstream.h has the wire form) */
+typedef struct
+{
+    uint32_t tsMs;
+    uint8_t  site;
+    uint8_t  ctx;     /* FI_CORE_CONTEXT of the fire */
+    uint16_t extra;   /* FICore_LogDetail */
+    uint32_t hit;
+    uint32_t data;    /* FICore_LogDetail */
+} fi_core_event_t;
+
+/* Storage class of all core state. Empty on the target (one core per
+ * image); a host harness running one simulated board per thread defines
+ * it as _Thread_local, so every thread has its own sites, RNG, clock and
+ * log. */
+#ifndef FI_CORE_TLS
+#define FI_CORE_TLS
+#endif
+
+/* enabled ? mask & armed : 0 -- read by the inline fast path */
+extern FI_CORE_TLS volatile uint32_t g_fiActive;
+
+/* Resets sites (all OFF, pct 100), counters, log and enable/mask (enabled,
+ * all unmasked), and ends a recording or replay. A zero seed selects a
+ * fixed non-zero one. */
+void FICore_Init(uint32_t seed);
+
+/* Time source for gates and the log; NULL: the value of FICore_SetNowMs. */
+void     FICore_SetClock(uint32_t (*nowMs)(void));
+void     FICore_SetNowMs(uint32_t nowMs);
+uint32_t FICore_NowMs(void);
+
+void     FICore_SetEnabled(bool en);
+bool     FICore_IsEnabled(void);
+void     FICore_SetMask(uint32_t mask);
+uint32_t FICore_GetMask(void);
+
+void     FICore_SetSeed(uint32_t seed);
+uint32_t FICore_Rand32(void);
+uint8_t  FICore_RandPct(void);   /* 0..99 */
+
+/* Arm a site with cfg (copied; trigger state restarts). */
+void FICore_Arm(uint32_t site, const fi_core_cfg_t *cfg);
+void FICore_Disarm(uint32_t site);
+void FICore_DisarmAll(void);
+
+/* Gates, changed in place (the trigger keeps its state). The time gate is
+ * absolute FICore_NowMs time, t0 <= now < t1. */
+void FICore_SetPct(uint32_t site, uint8_t pct);
+void FICore_SetTimeGate(uint32_t site, bool on, uint32_t t0, uint32_t t1);
+const fi_core_site_t *FICore_Site(uint32_t site);  /* NULL if out of range */
+
+/* Registered default: d->policy is an FICore_ArmArgs policy (fi_trig_t
+ * values), d->arg its arguments, applied over the given pct and flags. */
+void FICore_ArmDefault(const fi_site_desc_t *d, uint8_t pct, uint8_t flags);
+
+/* Arming by name for CLIs and campaign scripts, windows relative to now:
+ *   off | prob PCT | every N [PARAM] | nth N | window A B [PARAM] (hits
+ *   from now) | burst N LEN | time T0 T1 (ms from now, gates the current
+ *   trigger) | always (drop the gates)
+ * Returns -1 / false if unknown or invalid. Keeps FI_CORE_F_EVENTS. */
+int  FICore_ArmPolicyId(const char *name);
+const char *FICore_ArmPolicyName(int id);
+bool FICore_ArmArgs(uint32_t site, int policy, const uint32_t v[3]);
+
+const char *FICore_TrigName(uint8_t trig);
+
+void FICore_NotifyEvent(uint32_t site);
+
+/* Slow path of FICore_ShouldFire, for an active site. */
+bool FICore_Decide(uint32_t site);
+
+static inline bool FICore_ShouldFire(uint32_t site)
+{
+    return ((g_fiActive >> site) & 1U) != 0U && FICore_Decide(site);
+}
+
+/* Attach detail to the record of the caller's latest fire if it belongs
+ * to site and is not read yet; nothing if that fire was dropped (ring
+ * full). Call right after the fire; extra is truncated to 16 bits. */
+void FICore_LogDetail(uint32_t site, uint32_t extra, uint32_t data);
+
+/* Reader side: next record of all rings, oldest first (ties: lower
+ * context first); false if every ring is empty. */
+bool     FICore_LogRead(fi_core_event_t *out);
+uint32_t FICore_LogPending(void);
+uint32_t FICore_LogDrops(void);   /* records lost to full rings */
+
+/*
+ * Decision record / replay. A recording numbers every FICore_ShouldFire
+ * call per site, armed or not, and keeps the call numbers that fired.
+ * Replay takes the decisions from a recording instead of triggers, gates
+ * and RNG, so a run that depended on timing, CLI input or the RNG fires
+ * at exactly the same calls again, on target or on a host build, as long
+ * as the code reaches each site the same number of times in between.
+ * While either is on every site takes the slow path (g_fiActive = all).
+ *
+ *   Stream = magic "FIR1" u32 | rng u32 | fire* | 0x00 | mask u32 | total*
+ *   fire   = varint(delta << 5 | site) | rng u32
+ *   total  = varint(calls), one per mask bit, lowest site first
+ *
+ * delta is the site's calls since its previous fire (>= 1), rng the
+ * FICore_Rand32 state after the decision: replay restores it, so what the
+ * call site draws for the injection (bit, offset) is the same as well.
+ * mask has a bit per site with calls. u32 little-endian, varint LEB128.
+ * In replay a site's hit counter counts its calls.
+ */
+#define FI_CORE_RR_MAGIC  0x31524946UL /* "FIR1" */
+
+typedef enum
+{
+    FI_CORE_RR_OFF = 0,
+    FI_CORE_RR_RECORD,
+    FI_CORE_RR_REPLAY,
+} fi_core_rr_mode_t;
+
+typedef struct
+{
+    uint8_t  mode;       /* fi_core_rr_mode_t */
+    bool     overflow;   /* record: buffer full, later fires not recorded */
+    uint32_t len;        /* stream bytes written / being replayed */
+    uint32_t fires;      /* recorded / replayed */
+    uint32_t pending;    /* replay: recorded fires not reached yet */
+    uint32_t diverged;   /* replay: site bits called more often than recorded */
+} fi_core_rr_stat_t;
+
+/* Start recording into buf (cap >= 256). */
+bool     FICore_RecordStart(uint8_t *buf, uint32_t cap);
+/* Finish the stream; returns its length (0 if not recording). */
+uint32_t FICore_RecordStop(void);
+
+/* Replay a finished stream from here on; false if it does not parse.
+ * buf must stay valid until FICore_ReplayStop. */
+bool     FICore_ReplayStart(const uint8_t *buf, uint32_t len);
+void     FICore_ReplayStop(void);
+
+void     FICore_RRStat(fi_core_rr_stat_t *out);
+
+/* One 'rec load OFF HEX' console line into buf[cap]: an even number of hex
+ * digits at byte offset off; *len grows to cover them. Checked in full
+ * before anything is written (false: buf and *len untouched). Ends a
+ * replay or recording of buf, which is about to change. */
+bool     FICore_RRLoadHex(uint8_t *buf, uint32_t cap, uint32_t *len, uint32_t off, const char *hex);
+
+/* Walking a stream (host tools): Init checks the header, Next returns the
+ * fires in recorded order until false; then Totals reads the trailer.
+ * err is set if the stream is malformed. */
+typedef struct
+{
+    const uint8_t *p;
+    const uint8_t *end;
+    bool           err;
+    uint32_t       calls[FI_CORE_SITES];   /* call of the site's last fire */
+} fi_core_rr_iter_t;
+
+typedef struct
+{
+    uint8_t  site;
+    uint32_t call;
+    uint32_t rng;
+} fi_core_rr_fire_t;
+
+bool FICore_RRIterInit(fi_core_rr_iter_t *it, const uint8_t *buf, uint32_t len, uint32_t *rng0);
+bool FICore_RRIterNext(fi_core_rr_iter_t *it, fi_core_rr_fire_t *out);
+bool FICore_RRIterTotals(fi_core_rr_iter_t *it, uint32_t totals[FI_CORE_SITES]);
+
+#endif /* FI_CORE_H */
@@ -0,0 +1,302 @@
+#include "fi_corrupt.h"
+
+#include <string.h>
+
+#define FICM_PPM        1000000U
+#define FICM_IDLE_FRAME 0x3FFU      /* line idle: all ones */
+
+static const char *const s_modelName[FICM_MODEL_COUNT] = {"off", "ge", "stuck", "drop", "ins", "dup", "slip"};
+
+int FICorrupt_ModelId(const char *name)
+{
+    for (int i = 0; i < (int)FICM_MODEL_COUNT; i++)
+    {
+        if (strcmp(name, s_modelName[i]) == 0) return i;
+    }
+    return -1;
+}
+
+const char *FICorrupt_ModelName(int id)
+{
+    return ((id >= 0) && (id < (int)FICM_MODEL_COUNT)) ? s_modelName[id] : NULL;
+}
+
+/* ppm -> threshold for a 32-bit draw */
+static uint32_t ppm_p32(uint32_t ppm)
+{
+    return (ppm >= FICM_PPM) ? UINT32_MAX : (uint32_t)(((uint64_t)ppm << 32) / FICM_PPM);
+}
+
+bool FICorrupt_Set(ficm_t *m, int model, const uint32_t v[FICM_ARGS])
+{
+    ficm_t c;
+
+    memset(&c, 0, sizeof(c));
+    switch (model)
+    {
+    case FICM_OFF:
+        break;
+    case FICM_GE:
+        if ((v[0] > FICM_PPM) || (v[1] > FICM_PPM) || (v[2] > FICM_PPM) || (v[3] > FICM_PPM)) return false;
+        c.pGB    = ppm_p32(v[0]);
+        c.pBG    = ppm_p32(v[1]);
+        c.pEvent = ppm_p32((v[2] != 0U) ? v[2] : (FICM_PPM / 2U));
+        c.pGood  = ppm_p32(v[3]);
+        break;
+    case FICM_STUCK:
+        if ((v[0] == 0U) || (v[0] > 0xFFU) || (v[1] > 0xFFU)) return false;
+        c.mask  = (uint8_t)v[0];
+        c.value = (uint8_t)v[1];
+        c.span  = v[2];
+        break;
+    case FICM_DROP:
+    case FICM_INSERT:
+    case FICM_DUP:
+        if (v[0] > FICM_PPM) return false;
+        c.pEvent = (v[0] != 0U) ? ppm_p32(v[0]) : 0U;
+        break;
+    case FICM_SLIP:
+        if ((v[0] == 0U) || (v[0] > 9U)) return false;
+        c.shift = (uint8_t)v[0];
+        c.span  = v[1];
+        break;
+    default:
+        return false;
+    }
+    c.model = (uint8_t)model;
+    memcpy(c.args, v, sizeof(c.args));
+    *m = c;
+    return true;
+}
+
+static uint32_t rnd(ficm_t *m)
+{
+    uint32_t x = m->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    m->rng = x;
+    return x;
+}
+
+/* Input index of the next byte a rate model hits, from 'from' on (len if
+ * none). Draws for exactly the bytes it walks, so every byte gets its draws
+ * once however the call is split. */
+static uint32_t find_next(ficm_t *m, uint32_t from)
+{
+    uint32_t k;
+
+    switch (m->model)
+    {
+    case FICM_GE:
+        for (k = from; k < m->len; k++)
+        {
+            const uint32_t pT = m->bad ? m->pBG : m->pGB;
+            uint32_t pE;
+
+            if ((pT != 0U) && (rnd(m) < pT)) m->bad = !m->bad;
+            pE = m->bad ? m->pEvent : m->pGood;
+            if ((pE != 0U) && (rnd(m) < pE)) return k;
+        }
+        return m->len;
+
+    case FICM_DROP:
+    case FICM_INSERT:
+    case FICM_DUP:
+        if (m->pEvent != 0U)
+        {
+            for (k = from; k < m->len; k++)
+            {
+                if (rnd(m) < m->pEvent) return k;
+            }
+        }
+        return m->len;
+
+    default:
+        return m->len;
+    }
+}
+
+void FICorrupt_Begin(ficm_t *m, uint32_t seed, size_t len)
+{
+    m->rng    = (seed != 0U) ? seed : 0x9E3779B9U;
+    m->held   = false;
+    m->len    = (uint32_t)len;
+    m->in     = 0U;
+    m->out    = 0U;
+    m->left   = 0U;
+    m->events = 0U;
+    m->first  = 0U;
+
+    switch (m->model)
+    {
+    case FICM_STUCK:
+    case FICM_SLIP:
+        m->next = m->len;
+        if (m->len != 0U)
+        {
+            const uint32_t at = rnd(m) % m->len;
+            m->left = ((m->span != 0U) && (m->span < (m->len - at))) ? m->span : (m->len - at);
+            m->next = at;
+        }
+        break;
+
+    case FICM_DROP:
+    case FICM_INSERT:
+    case FICM_DUP:
+        if (m->pEvent == 0U)
+        {
+            m->next = (m->len != 0U) ? (rnd(m) % m->len) : 0U;
+            break;
+        }
+        m->next = find_next(m, 0U);
+        break;
+
+    default:
+        m->next = find_next(m, 0U);
+        break;
+    }
+}
+
+static void event(ficm_t *m, uint32_t outIndex)
+{
+    if (m->events == 0U) m->first = outIndex;
+    m->events++;
+}
+
+/* UART frame as the line carries it, LSB first: start 0, data, stop 1 */
+static uint32_t uart_frame(uint8_t b)
+{
+    return 0x200U | ((uint32_t)b << 1);
+}
+
+/* Run, or with patch set Patch: stop in front of the next clean byte */
+static size_t run(ficm_t *m, const uint8_t *in, size_t inLen, size_t *used, uint8_t *out, size_t outCap, bool patch)
+{
+    const uint32_t base = m->out;
+    size_t i = 0U;
+    size_t o = 0U;
+
+    for (;;)
+    {
+        if (m->held)
+        {
+            if (o >= outCap) break;
+            out[o++] = m->hold;
+            m->held = false;
+            continue;
+        }
+        if ((i >= inLen) || (m->in >= m->len)) break;
+
+        /* Clean up to the next affected byte */
+        if (m->in < m->next)
+        {
+            if (patch) break;
+
+            size_t n = m->next - m->in;
+            if (n > (inLen - i)) n = inLen - i;
+            if (n > (outCap - o)) n = outCap - o;
+            if (n == 0U) break;
+            if (&out[o] != &in[i]) memmove(&out[o], &in[i], n);
+            i += n;
+            o += n;
+            m->in += (uint32_t)n;
+            continue;
+        }
+
+        if ((o >= outCap) && (m->model != (uint8_t)FICM_DROP)) break;
+
+        const uint8_t b = in[i];
+        uint8_t r = b;
+
+        switch (m->model)
+        {
+        case FICM_DROP:
+            event(m, base + (uint32_t)o);
+            i++;
+            m->in++;
+            m->next = find_next(m, m->in);
+            continue;
+
+        case FICM_INSERT:
+            /* the byte itself goes out clean after the inserted one */
+            event(m, base + (uint32_t)o);
+            out[o++] = (uint8_t)rnd(m);
+            m->next = find_next(m, m->in + 1U);
+            continue;
+
+        case FICM_DUP:
+            event(m, base + (uint32_t)o + 1U);
+            out[o++] = b;
+            m->hold = b;
+            m->held = true;
+            i++;
+            m->in++;
+            m->next = find_next(m, m->in);
+            continue;
+
+        case FICM_GE:
+            if (m->bad)
+            {
+                const uint8_t x = (uint8_t)rnd(m);
+                r = (uint8_t)(b ^ ((x != 0U) ? x : 0x01U));
+            }
+            else
+            {
+                r = (uint8_t)(b ^ (1U << (rnd(m) & 7U)));
+            }
+            break;
+
+        case FICM_STUCK:
+            r = (uint8_t)((b & (uint8_t)~m->mask) | (m->value & m->mask));
+            break;
+
+        case FICM_SLIP:
+        {
+            const uint32_t next = (((m->in + 1U) < m->len) && ((i + 1U) < inLen)) ? uart_frame(in[i + 1U])
+                                                                                  : FICM_IDLE_FRAME;
+            r = (uint8_t)(((uart_frame(b) | (next << 10)) >> m->shift) >> 1);
+            break;
+        }
+
+        default:
+            break;
+        }
+
+        out[o] = r;
+        if (r != b) event(m, base + (uint32_t)o);
+        o++;
+        i++;
+        m->in++;
+
+        if ((m->model == (uint8_t)FICM_STUCK) || (m->model == (uint8_t)FICM_SLIP))
+        {
+            m->left--;
+            m->next = (m->left != 0U) ? m->in : m->len;
+        }
+        else
+        {
+            m->next = find_next(m, m->in);
+        }
+    }
+
+    m->out += (uint32_t)o;
+    *used = i;
+    return o;
+}
+
+size_t FICorrupt_Run(ficm_t *m, const uint8_t *in, size_t inLen, size_t *used, uint8_t *out, size_t outCap)
+{
+    return run(m, in, inLen, used, out, outCap, false);
+}
+
+size_t FICorrupt_Patch(ficm_t *m, const uint8_t *in, size_t inLen, size_t *used, uint8_t *out, size_t outCap)
+{
+    return run(m, in, inLen, used, out, outCap, true);
+}
+
+void FICorrupt_Skip(ficm_t *m, size_t n)
+{
+    m->in += (uint32_t)n;
+    m->out += (uint32_t)n;
+}
@@ -0,0 +1,127 @@
+#ifndef FI_CORRUPT_H
+#define FI_CORRUPT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Corruption models for byte streams (UART payloads, RX chunks): what a
+ * fired corruption site does to the buffer, beyond flipping random bits.
+ *
+ *   model  args (ppm = per million bytes)   effect
+ *   ge     PGB PBG [EBAD [EGOOD]]            Gilbert-Elliott burst channel:
+ *                                            good/bad state per byte, errors
+ *                                            with EBAD (default 500000) /
+ *                                            EGOOD ppm; a bad-state error is
+ *                                            a random burst over the byte, a
+ *                                            good-state one a single bit
+ *   stuck  MASK VALUE [LEN]                  bits in MASK read as VALUE for
+ *                                            LEN bytes (0: to the end) from a
+ *                                            random offset
+ *   drop   [PPM]                             bytes lost
+ *   ins    [PPM]                             random bytes inserted
+ *   dup    [PPM]                             bytes received twice
+ *   slip   BITS [LEN]                        receiver off by BITS (1..9) bit
+ *                                            times for LEN bytes (0: to the
+ *                                            end) from a random offset, then
+ *                                            resynced: every byte is sampled
+ *                                            across the 10-bit frames (start,
+ *                                            8 data, stop) of two bytes
+ *
+ * drop/ins/dup with PPM 0 hit one byte at a random offset per call.
+ *
+ * One call = FICorrupt_Begin with the buffer length and a seed, then
+ * FICorrupt_Run until FICorrupt_Done. Run makes a single pass over the
+ * input: clean stretches up to the next affected byte are moved with one
+ * memmove (nothing at all in place), RNG draws only where a rate has to be
+ * sampled. The output is whatever fits in out; call again with the rest
+ * of the input (in must always be the whole remainder) and fresh output
+ * space. out may be in itself unless FICorrupt_Grows (ins, dup).
+ *
+ * Zero-copy senders instead alternate FICorrupt_Clean / FICorrupt_Skip
+ * (bytes that pass unchanged: send them from the caller's buffer) with
+ * FICorrupt_Patch (the affected bytes only, into a small patch buffer).
+ *
+ * Everything drawn comes from the seed given to Begin, so a call is
+ * reproducible from (model, seed, input); the call sites pass
+ * FICore_Rand32(), which makes models deterministic per FI seed and exact
+ * under decision replay. Only the Gilbert-Elliott state carries over from
+ * one call to the next (bursts span buffers); FICorrupt_Set resets it.
+ */
+typedef enum
+{
+    FICM_OFF = 0,   /* no model: the site's own corruption */
+    FICM_GE,
+    FICM_STUCK,
+    FICM_DROP,
+    FICM_INSERT,
+    FICM_DUP,
+    FICM_SLIP,
+    FICM_MODEL_COUNT
+} ficm_model_t;
+
+#define FICM_ARGS   4U
+
+typedef struct
+{
+    /* Configuration (FICorrupt_Set) */
+    uint8_t  model;       /* ficm_model_t */
+    uint8_t  mask;        /* stuck */
+    uint8_t  value;       /* stuck */
+    uint8_t  shift;       /* slip, bit times */
+    uint32_t span;        /* stuck / slip window, 0: to the end */
+    uint32_t pEvent;      /* per byte, 2^-32 units; 0: one per call. ge: bad-state error */
+    uint32_t pGood;       /* ge: good-state error */
+    uint32_t pGB;         /* ge: good -> bad */
+    uint32_t pBG;         /* ge: bad -> good */
+    uint32_t args[FICM_ARGS];
+
+    /* Current call */
+    uint32_t rng;
+    bool     bad;         /* ge state, kept across calls */
+    bool     held;        /* dup: copy still to be output */
+    uint8_t  hold;
+    uint32_t len;         /* input bytes of the call */
+    uint32_t in;          /* consumed */
+    uint32_t out;         /* produced */
+    uint32_t next;        /* input index of the next affected byte, len: none */
+    uint32_t left;        /* stuck / slip: window bytes left */
+    uint32_t events;      /* bytes changed, dropped, inserted or duplicated */
+    uint32_t first;       /* output index of the first event */
+} ficm_t;
+
+/* By name for CLIs: -1 / NULL if unknown. */
+int         FICorrupt_ModelId(const char *name);
+const char *FICorrupt_ModelName(int id);
+
+/* Configure from CLI arguments (table above; missing ones 0). false if
+ * invalid, m unchanged then. */
+bool FICorrupt_Set(ficm_t *m, int model, const uint32_t v[FICM_ARGS]);
+
+void   FICorrupt_Begin(ficm_t *m, uint32_t seed, size_t len);
+size_t FICorrupt_Run(ficm_t *m, const uint8_t *in, size_t inLen, size_t *used, uint8_t *out, size_t outCap);
+
+/* Like Run, but stops in front of the next clean input byte. */
+size_t FICorrupt_Patch(ficm_t *m, const uint8_t *in, size_t inLen, size_t *used, uint8_t *out, size_t outCap);
+
+static inline bool FICorrupt_Done(const ficm_t *m)
+{
+    return (m->in >= m->len) && !m->held;
+}
+
+/* Input bytes from here on that the model passes unchanged */
+static inline size_t FICorrupt_Clean(const ficm_t *m)
+{
+    return (m->held || (m->in >= m->next)) ? 0U : (size_t)(m->next - m->in);
+}
+
+/* Consume n <= FICorrupt_Clean bytes the caller passed on itself */
+void FICorrupt_Skip(ficm_t *m, size_t n);
+
+static inline bool FICorrupt_Grows(const ficm_t *m)
+{
+    return (m->model == (uint8_t)FICM_INSERT) || (m->model == (uint8_t)FICM_DUP);
+}
+
+#endif /* FI_CORRUPT_H */
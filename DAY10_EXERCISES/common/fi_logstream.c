@@ -0,0 +1,130 @@
+#include "fi_logstream.h"
+#include "crc32.h"
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void FILog_Encode(const fi_core_event_t *e, uint8_t out[FILOG_REC_LEN])
+{
+    put_le32(&out[0], e->tsMs);
+    out[4] = e->site;
+    out[5] = e->ctx;
+    out[6] = (uint8_t)e->extra;
+    out[7] = (uint8_t)(e->extra >> 8);
+    put_le32(&out[8], e->hit);
+    put_le32(&out[12], e->data);
+}
+
+void FILog_Decode(const uint8_t in[FILOG_REC_LEN], fi_core_event_t *e)
+{
+    e->tsMs  = get_le32(&in[0]);
+    e->site  = in[4];
+    e->ctx   = in[5];
+    e->extra = (uint16_t)(in[6] | ((uint16_t)in[7] << 8));
+    e->hit   = get_le32(&in[8]);
+    e->data  = get_le32(&in[12]);
+}
+
+void FILog_DrainInit(filog_drain_t *d)
+{
+    d->len     = 0U;
+    d->pos     = 0U;
+    d->seq     = 0U;
+    d->blocks  = 0U;
+    d->records = 0U;
+}
+
+static bool build_block(filog_drain_t *d)
+{
+    fi_core_event_t e;
+    uint32_t count = 0U;
+    size_t body;
+
+    while ((count < FILOG_BLOCK_RECORDS) && FICore_LogRead(&e))
+    {
+        FILog_Encode(&e, &d->buf[FILOG_HDR_LEN + (count * FILOG_REC_LEN)]);
+        count++;
+    }
+    if (count == 0U)
+    {
+        return false;
+    }
+
+    put_le32(&d->buf[0], FILOG_MAGIC);
+    d->buf[4] = (uint8_t)d->seq;
+    d->buf[5] = (uint8_t)(d->seq >> 8);
+    d->buf[6] = (uint8_t)count;
+    d->buf[7] = (uint8_t)FI_CORE_LOG_CTX;
+    put_le32(&d->buf[8], FICore_LogDrops());
+
+    body = FILOG_HDR_LEN + (count * FILOG_REC_LEN);
+    Crc32_BlockSeal(d->buf, body);
+
+    d->len = (uint16_t)(body + FILOG_CRC_LEN);
+    d->pos = 0U;
+    d->seq++;
+    d->blocks++;
+    d->records += count;
+    return true;
+}
+
+bool FILog_DrainPoll(filog_drain_t *d, filog_write_t write, void *user)
+{
+    if ((d->pos >= d->len) && !build_block(d))
+    {
+        d->len = 0U;
+        d->pos = 0U;
+        return false;
+    }
+
+    d->pos += (uint16_t)write(user, &d->buf[d->pos], (size_t)(d->len - d->pos));
+    return true;
+}
+
+int32_t FILog_ParseBlock(const uint8_t *buf, size_t len, filog_block_t *out)
+{
+    uint8_t count;
+    size_t  body;
+
+    if (Crc32_BlockMagic(buf, len, FILOG_MAGIC) < 0)
+    {
+        return -1;
+    }
+    if (len < FILOG_HDR_LEN)
+    {
+        return 0;
+    }
+
+    count = buf[6];
+    if ((count == 0U) || (count > FILOG_BLOCK_RECORDS))
+    {
+        return -1;
+    }
+
+    body = FILOG_HDR_LEN + ((size_t)count * FILOG_REC_LEN);
+    if (len < (body + FILOG_CRC_LEN))
+    {
+        return 0;
+    }
+    if (!Crc32_BlockValid(buf, body))
+    {
+        return -1;
+    }
+
+    out->seq     = (uint16_t)(buf[4] | ((uint16_t)buf[5] << 8));
+    out->count   = count;
+    out->ctxs    = buf[7];
+    out->drops   = get_le32(&buf[8]);
+    out->records = &buf[FILOG_HDR_LEN];
+    return (int32_t)(body + FILOG_CRC_LEN);
+}
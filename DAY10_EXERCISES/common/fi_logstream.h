@@ -0,0 +1,82 @@
+#ifndef FI_LOGSTREAM_H
+#define FI_LOGSTREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fi_core.h"
+
+/*
+ * Binary FI log stream: fi_core log records packed into self-contained
+ * blocks, drained a few bytes at a time so a campaign trace can go out
+ * over a console UART without blocking the application.
+ *
+ *   Block  = [header 12][record 16 * count][CRC32 4]
+ *   Header = magic "FIL1" | seq u16 | count u8 | ctxs u8 | drops u32
+ *   Record = ts_ms u32 | site u8 | ctx u8 | extra u16 | hit u32 | data u32
+ *   All fields little-endian. CRC32 (IEEE, reflected) covers header+records.
+ *
+ * seq counts blocks since FILog_DrainInit (a gap means a block was lost on
+ * the way), drops is FICore_LogDrops() when the block was built. Blocks may
+ * be interleaved with console text; a reader resyncs on magic + CRC.
+ */
+#define FILOG_MAGIC          0x314C4946UL /* "FIL1" */
+#define FILOG_HDR_LEN        12U
+#define FILOG_REC_LEN        16U
+#define FILOG_CRC_LEN        4U
+
+#ifndef FILOG_BLOCK_RECORDS
+#define FILOG_BLOCK_RECORDS  8U
+#endif
+#define FILOG_BLOCK_MAX      (FILOG_HDR_LEN + (FILOG_BLOCK_RECORDS * FILOG_REC_LEN) + FILOG_CRC_LEN)
+
+/* Writes up to n bytes without blocking; returns how many it took. */
+typedef size_t (*filog_write_t)(void *user, const uint8_t *p, size_t n);
+
+typedef struct
+{
+    uint8_t  buf[FILOG_BLOCK_MAX];
+    uint16_t len;     /* current block, 0: none */
+    uint16_t pos;     /* bytes of it already written */
+    uint16_t seq;
+
+    /* Stats */
+    uint32_t blocks;
+    uint32_t records;
+} filog_drain_t;
+
+typedef struct
+{
+    uint16_t       seq;
+    uint8_t        count;
+    uint8_t        ctxs;
+    uint32_t       drops;
+    const uint8_t *records;
+} filog_block_t;
+
+void FILog_DrainInit(filog_drain_t *d);
+
+/* Continue the current block, or build the next one from FICore_LogRead.
+ * Returns true while bytes are still pending (call again), false when the
+ * log is empty and the last block is fully written. */
+bool FILog_DrainPoll(filog_drain_t *d, filog_write_t write, void *user);
+
+/* A block is partially written: other output now would split it */
+static inline bool FILog_DrainBusy(const filog_drain_t *d)
+{
+    return d->pos < d->len;
+}
+
+void FILog_Encode(const fi_core_event_t *e, uint8_t out[FILOG_REC_LEN]);
+void FILog_Decode(const uint8_t in[FILOG_REC_LEN], fi_core_event_t *e);
+
+/* Validate the block at buf[0..len); resync contract in crc32.h. */
+int32_t FILog_ParseBlock(const uint8_t *buf, size_t len, filog_block_t *out);
+
+static inline void FILog_GetRecord(const filog_block_t *b, uint32_t i, fi_core_event_t *e)
+{
+    FILog_Decode(&b->records[i * FILOG_REC_LEN], e);
+}
+
+#endif /* FI_LOGSTREAM_H */
@@ -0,0 +1,168 @@
+#include "fi_outcome.h"
+
+#include <string.h>
+
+static const char *const s_outcomeName[FIO_OUTCOME_COUNT] = {"detected", "escaped", "masked"};
+
+void FIOutcome_Init(fio_tracker_t *t, const fio_site_cfg_t *cfg, uint32_t nSites)
+{
+    t->cfg    = cfg;
+    t->nSites = (nSites < FIO_MAX_SITES) ? nSites : FIO_MAX_SITES;
+    FIOutcome_Reset(t);
+}
+
+void FIOutcome_Reset(fio_tracker_t *t)
+{
+    t->openCount = 0U;
+    t->bytes     = 0U;
+    memset(t->site, 0, sizeof(t->site));
+    memset(t->falseAlarms, 0, sizeof(t->falseAlarms));
+}
+
+void FIOutcome_Bytes(fio_tracker_t *t, uint32_t n)
+{
+    t->bytes += n;
+}
+
+/* Close open[i] and keep the list in age order. */
+static void close_open(fio_tracker_t *t, uint32_t i, fio_outcome_t outcome, int32_t barrier, uint32_t nowMs)
+{
+    const fio_open_t *o = &t->open[i];
+    fio_site_stats_t *s = &t->site[o->site];
+
+    s->outcome[outcome]++;
+    if (barrier >= 0)
+    {
+        const uint32_t ms    = nowMs - o->tMs;
+        const uint32_t bytes = t->bytes - o->bytes;
+
+        s->byBarrier[barrier]++;
+        s->latMsSum += ms;
+        s->latBytesSum += bytes;
+        if (ms > s->latMsMax) s->latMsMax = ms;
+        if (bytes > s->latBytesMax) s->latBytesMax = bytes;
+    }
+
+    t->openCount--;
+    memmove(&t->open[i], &t->open[i + 1U], (t->openCount - i) * sizeof(t->open[0]));
+}
+
+void FIOutcome_Injected(fio_tracker_t *t, uint32_t site, uint32_t nowMs, uint32_t unit)
+{
+    fio_open_t *o;
+
+    if (site >= t->nSites)
+    {
+        return;
+    }
+    t->site[site].fired++;
+    if (t->openCount >= FIO_MAX_OPEN)
+    {
+        t->site[site].untracked++;
+        return;
+    }
+
+    o = &t->open[t->openCount++];
+    o->site    = (uint8_t)site;
+    o->channel = t->cfg[site].channel;
+    o->unit    = unit;
+    o->tMs     = nowMs;
+    o->bytes   = t->bytes;
+}
+
+void FIOutcome_Detected(fio_tracker_t *t, uint32_t barrier, uint32_t nowMs)
+{
+    if (barrier >= FIO_MAX_BARRIERS)
+    {
+        return;
+    }
+    for (uint32_t i = 0U; i < t->openCount; i++)
+    {
+        if ((t->cfg[t->open[i].site].barriers & (1U << barrier)) != 0U)
+        {
+            close_open(t, i, FIO_DETECTED, (int32_t)barrier, nowMs);
+            return;
+        }
+    }
+    t->falseAlarms[barrier]++;
+}
+
+void FIOutcome_Settle(fio_tracker_t *t, uint8_t channel, uint32_t unit, uint32_t nowMs,
+                      fio_outcome_t outcome)
+{
+    uint32_t i = 0U;
+
+    while (i < t->openCount)
+    {
+        const fio_open_t *o = &t->open[i];
+        /* unit distance, wrap-safe */
+        if ((o->channel == channel) && ((int32_t)(o->unit - unit) < 0))
+        {
+            close_open(t, i, outcome, -1, nowMs);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void FIOutcome_Poll(fio_tracker_t *t, uint32_t nowMs)
+{
+    uint32_t i = 0U;
+
+    while (i < t->openCount)
+    {
+        const fio_site_cfg_t *c = &t->cfg[t->open[i].site];
+        if ((c->timeoutMs != 0U) && ((nowMs - t->open[i].tMs) >= c->timeoutMs))
+        {
+            close_open(t, i, (fio_outcome_t)c->onTimeout, -1, nowMs);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+uint32_t FIOutcome_Total(const fio_tracker_t *t, fio_site_stats_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    for (uint32_t s = 0U; s < t->nSites; s++)
+    {
+        const fio_site_stats_t *p = &t->site[s];
+
+        out->fired += p->fired;
+        out->untracked += p->untracked;
+        for (uint32_t k = 0U; k < FIO_OUTCOME_COUNT; k++)
+        {
+            out->outcome[k] += p->outcome[k];
+        }
+        for (uint32_t b = 0U; b < FIO_MAX_BARRIERS; b++)
+        {
+            out->byBarrier[b] += p->byBarrier[b];
+        }
+        out->latMsSum += p->latMsSum;
+        out->latBytesSum += p->latBytesSum;
+        if (p->latMsMax > out->latMsMax) out->latMsMax = p->latMsMax;
+        if (p->latBytesMax > out->latBytesMax) out->latBytesMax = p->latBytesMax;
+    }
+    return t->openCount;
+}
+
+int32_t FIOutcome_CoveragePermille(const fio_site_stats_t *s)
+{
+    const uint32_t rated = s->outcome[FIO_DETECTED] + s->outcome[FIO_ESCAPED];
+    return (rated != 0U) ? (int32_t)((s->outcome[FIO_DETECTED] * 1000U + (rated / 2U)) / rated) : -1;
+}
+
+int32_t FIOutcome_EscapePermille(const fio_site_stats_t *s)
+{
+    const uint32_t closed = s->outcome[FIO_DETECTED] + s->outcome[FIO_ESCAPED] + s->outcome[FIO_MASKED];
+    return (closed != 0U) ? (int32_t)((s->outcome[FIO_ESCAPED] * 1000U + (closed / 2U)) / closed) : -1;
+}
+
+const char *FIOutcome_Name(uint8_t outcome)
+{
+    return (outcome < FIO_OUTCOME_COUNT) ? s_outcomeName[outcome] : "?";
+}
@@ -0,0 +1,109 @@
+#ifndef FI_OUTCOME_H
+#define FI_OUTCOME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * FI outcome tracker: links every fired injection to the barrier that
+ * caught it, or classifies it as an escape, and keeps per-site coverage and
+ * detection latency. Framework-neutral: sites are fi_core site ids, barriers
+ * and channels are small numbers the lab defines.
+ *
+ *   Injected(site, unit)    open an injection on the site's channel at
+ *                           unit (stream byte, word index, ...)
+ *   Detected(barrier)       close the oldest open injection whose site lists
+ *                           the barrier; nothing open: a false alarm
+ *   Settle(ch, unit, out)   close open injections of ch below unit: the data
+ *                           they hit has been judged without a detection
+ *                           (FIO_ESCAPED), or their effect was superseded
+ *                           (FIO_MASKED)
+ *   Poll(now)               close injections older than their site's
+ *                           timeout with the site's onTimeout outcome
+ *
+ * Latency is measured from Injected to Detected in ms and in bytes, where
+ * bytes is whatever the lab counts with FIOutcome_Bytes (the RX stream).
+ * Coverage = detected / (detected + escaped); masked ones are excluded.
+ */
+#ifndef FIO_MAX_SITES
+#define FIO_MAX_SITES     8U
+#endif
+#ifndef FIO_MAX_BARRIERS
+#define FIO_MAX_BARRIERS  8U
+#endif
+#ifndef FIO_MAX_OPEN
+#define FIO_MAX_OPEN      16U   /* more open injections are counted as untracked */
+#endif
+
+typedef enum
+{
+    FIO_DETECTED = 0,
+    FIO_ESCAPED,
+    FIO_MASKED,
+    FIO_OUTCOME_COUNT
+} fio_outcome_t;
+
+typedef struct
+{
+    uint8_t  channel;
+    uint8_t  barriers;    /* bit per barrier that can catch this site */
+    uint8_t  onTimeout;   /* fio_outcome_t */
+    uint32_t timeoutMs;   /* 0: never times out */
+} fio_site_cfg_t;
+
+typedef struct
+{
+    uint32_t fired;       /* Injected calls, including untracked */
+    uint32_t untracked;   /* open list was full */
+    uint32_t outcome[FIO_OUTCOME_COUNT];
+    uint32_t byBarrier[FIO_MAX_BARRIERS];
+    uint32_t latMsSum;
+    uint32_t latMsMax;
+    uint32_t latBytesSum;
+    uint32_t latBytesMax;
+} fio_site_stats_t;
+
+typedef struct
+{
+    uint8_t  site;
+    uint8_t  channel;
+    uint32_t unit;
+    uint32_t tMs;
+    uint32_t bytes;
+} fio_open_t;
+
+typedef struct
+{
+    const fio_site_cfg_t *cfg;    /* [FIO_MAX_SITES] */
+    uint32_t nSites;
+
+    fio_open_t open[FIO_MAX_OPEN];   /* oldest first */
+    uint32_t   openCount;
+    uint32_t   bytes;
+
+    fio_site_stats_t site[FIO_MAX_SITES];
+    uint32_t falseAlarms[FIO_MAX_BARRIERS];
+} fio_tracker_t;
+
+/* cfg[nSites] must outlive the tracker; sites >= nSites are ignored. */
+void FIOutcome_Init(fio_tracker_t *t, const fio_site_cfg_t *cfg, uint32_t nSites);
+void FIOutcome_Reset(fio_tracker_t *t);   /* stats and open list */
+
+void FIOutcome_Bytes(fio_tracker_t *t, uint32_t n);
+void FIOutcome_Injected(fio_tracker_t *t, uint32_t site, uint32_t nowMs, uint32_t unit);
+void FIOutcome_Detected(fio_tracker_t *t, uint32_t barrier, uint32_t nowMs);
+void FIOutcome_Settle(fio_tracker_t *t, uint8_t channel, uint32_t unit, uint32_t nowMs,
+                      fio_outcome_t outcome);
+void FIOutcome_Poll(fio_tracker_t *t, uint32_t nowMs);
+
+/* Totals over all sites into *out; returns the number still open. */
+uint32_t FIOutcome_Total(const fio_tracker_t *t, fio_site_stats_t *out);
+
+/* Coverage and escape rate in 0.1 % units; -1 if nothing to rate. */
+int32_t FIOutcome_CoveragePermille(const fio_site_stats_t *s);
+int32_t FIOutcome_EscapePermille(const fio_site_stats_t *s);
+
+const char *FIOutcome_Name(uint8_t outcome);
+
+#endif /* FI_OUTCOME_H */
@@ -0,0 +1,108 @@
+#ifndef FI_SITE_H
+#define FI_SITE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * Compile-time FI site registry. Each injection site is described once, in
+ * the module that injects it, with FI_SITE_REGISTER(); the descriptor goes
+ * into the "fi_sites" linker section and the CLI, dump and policy defaults
+ * walk that section instead of keeping their own name/id/default lists.
+ *
+ *   FI_SITE_REGISTER(s_siteRx, "rx", FI_SITE_RX_CORRUPT, FI_TRIG_EVERY_N, 200u, 3u, 0u);
+ *
+ * id is the framework's site handle (SFI fi_site_t, FI feature bit number),
+ * policy and arg[] its default policy and parameters. Several modules may
+ * register the same id (e.g. the UART shim and the --wrap variant); the
+ * first descriptor wins and FI_SiteIsFirst() lets walkers skip the rest, so
+ * duplicates must use the same values.
+ *
+ * The including framework sets FI_SITE_REGISTRY (1 = FI compiled in). With
+ * 0, FI_SITE_REGISTER only declares an extern that is never defined or
+ * referenced: no descriptor, no section, nothing in the map file.
+ *
+ * GNU ld provides __start_fi_sites / __stop_fi_sites for the orphan section
+ * and keeps it under --gc-sections. A hand-written linker script can place
+ * it explicitly (read-only, in flash):
+ *   .fi_sites : ALIGN(4)
+ *   {
+ *       PROVIDE(__start_fi_sites = .);
+ *       KEEP(*(fi_sites))
+ *       PROVIDE(__stop_fi_sites = .);
+ *   } > PROGRAM_FLASH
+ */
+#ifndef FI_SITE_REGISTRY
+#define FI_SITE_REGISTRY 1
+#endif
+
+typedef struct
+{
+    const char *name;    /* CLI / dump name */
+    uint16_t    id;      /* framework site id */
+    uint8_t     policy;  /* default policy (framework enum) */
+    uint8_t     flags;   /* reserved */
+    uint32_t    arg[3];  /* default policy parameters */
+} fi_site_desc_t;
+
+#if FI_SITE_REGISTRY
+
+#define FI_SITE_REGISTER(sym, name_, id_, policy_, a0, a1, a2)                               \
+    static const fi_site_desc_t sym                                                          \
+        __attribute__((section("fi_sites"), used, aligned(__alignof__(fi_site_desc_t)))) = \
+        {(name_), (uint16_t)(id_), (uint8_t)(policy_), 0u, {(a0), (a1), (a2)}}
+
+extern const fi_site_desc_t __start_fi_sites[];
+extern const fi_site_desc_t __stop_fi_sites[];
+
+#define FI_SITES_FOREACH(d) \
+    for (const fi_site_desc_t *d = __start_fi_sites; d < __stop_fi_sites; d++)
+
+#else
+
+#define FI_SITE_REGISTER(sym, name_, id_, policy_, a0, a1, a2) \
+    extern const fi_site_desc_t sym
+
+#define FI_SITES_FOREACH(d) \
+    for (const fi_site_desc_t *d = (const fi_site_desc_t *)0; d != (const fi_site_desc_t *)0; d++)
+
+#endif /* FI_SITE_REGISTRY */
+
+/* True unless an earlier descriptor already registered d->id. */
+static inline bool FI_SiteIsFirst(const fi_site_desc_t *d)
+{
+    FI_SITES_FOREACH(e)
+    {
+        if (e == d)
+            return true;
+        if (e->id == d->id)
+            return false;
+    }
+    return true;
+}
+
+static inline const fi_site_desc_t *FI_SiteById(uint32_t id)
+{
+    FI_SITES_FOREACH(d)
+    {
+        if (d->id == id)
+            return d;
+    }
+    return (const fi_site_desc_t *)0;
+}
+
+static inline const fi_site_desc_t *FI_SiteByName(const char *name)
+{
+    if (name == NULL)
+        return (const fi_site_desc_t *)0;
+    FI_SITES_FOREACH(d)
+    {
+        if (strcmp(d->name, name) == 0)
+            return d;
+    }
+    return (const fi_site_desc_t *)0;
+}
+
+#endif /* FI_SITE_H */
@@ -0,0 +1,576 @@
+/*
+ * Host-side ARINC 429 analyzer built from the on-target analyzer core
+ * (analyzer/analyzer_core.c and friends, no LPUART/console glue).
+ *
+ * Build (from DAY10_EXERCISES/host):
+ *   gcc -O2 -std=c11 -D_DEFAULT_SOURCE -pthread -I../analyzer \
+ *       a429_analyze.c ../analyzer/analyzer_core.c ../analyzer/label_stats.c \
+ *       ../analyzer/label_timing.c ../analyzer/capture.c ../analyzer/a429_text.c \
+ *       ../analyzer/sniff_frame.c ../analyzer/a429_filter.c ../common/crc32.c \
+ *       -o a429_analyze
+ *   (add -DLABEL_STATS_CHANNELS=N for more than two receiver channels)
+ *
+ * Usage:
+ *   a429_analyze [options] <capture>...     analyze capture files (host/a429_replay format)
+ *   a429_analyze [options] --stream <path>  read a live stream (tty, pty, fifo, '-' = stdin)
+ * Options:
+ *   --format capture|ascii|sniff  stream format (default capture; files are always capture)
+ *   -j N                          worker threads for capture files, sharded by channel
+ *                                 slot (LabelTiming_Slot), so the report does not
+ *                                 depend on N
+ *   --out summary|csv|json        report format (default summary = 's' + 'l' + 't')
+ *
+ * A pty stand-in for the board: socat -d -d pty,raw,echo=0 pty,raw,echo=0,
+ * then feed one end (cat capture.bin > /dev/pts/X) and analyze the other.
+ * Stream mode stops on EOF or Ctrl-C and then prints the report.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "analyzer_core.h"
+#include "capture.h"
+#include "a429_text.h"
+#include "sniff_frame.h"
+#include "../common/a429_word.h"
+
+#define MAX_THREADS 16U
+
+typedef enum
+{
+    OUT_SUMMARY,
+    OUT_CSV,
+    OUT_JSON,
+} out_format_t;
+
+typedef struct
+{
+    capture_block_t *blocks;
+    size_t           count;
+} block_index_t;
+
+typedef struct
+{
+    const block_index_t *index;
+    uint32_t             shard;
+    uint32_t             shards;
+    analyzer_core_t      core;
+} worker_t;
+
+static volatile sig_atomic_t s_stop;
+
+static void on_sigint(int sig)
+{
+    (void)sig;
+    s_stop = 1;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static int print_stdout(const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vprintf(fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+/* ---------------------------------------------------------------------------
+ * Capture files: validate once, then shard records across workers by channel
+ * slot: a slot's period streams must stay in one worker
+ * ------------------------------------------------------------------------- */
+
+static int index_file(const char *path, uint8_t **bufOut, block_index_t *idx, uint32_t *skipped)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+    long n;
+    size_t off = 0U;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((n > 0) ? (size_t)n : 1U);
+    if ((buf == NULL) || (fread(buf, 1, (size_t)n, f) != (size_t)n))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        fclose(f);
+        free(buf);
+        return -1;
+    }
+    fclose(f);
+
+    idx->blocks = malloc((((size_t)n / (CAPTURE_HDR_LEN + CAPTURE_REC_LEN + CAPTURE_CRC_LEN)) + 1U) * sizeof(capture_block_t));
+    idx->count  = 0U;
+    if (idx->blocks == NULL)
+    {
+        free(buf);
+        return -1;
+    }
+
+    while (off < (size_t)n)
+    {
+        int32_t len = Capture_ParseBlock(&buf[off], (size_t)n - off, &idx->blocks[idx->count]);
+        if (len <= 0)
+        {
+            *skipped += (len < 0) ? 1U : (uint32_t)((size_t)n - off);
+            off += (len < 0) ? 1U : ((size_t)n - off);
+            continue;
+        }
+        idx->count++;
+        off += (size_t)len;
+    }
+
+    *bufOut = buf;
+    return 0;
+}
+
+static void *worker_main(void *arg)
+{
+    worker_t *w = arg;
+
+    for (size_t b = 0U; b < w->index->count; b++)
+    {
+        const capture_block_t *blk = &w->index->blocks[b];
+        uint32_t ts = blk->firstTsUs;
+
+        for (uint32_t i = 0U; i < blk->count; i++)
+        {
+            uint8_t ch;
+            uint32_t word, dt;
+
+            Capture_GetRecord(blk, i, &ch, &word, &dt);
+            ts += dt;
+            if ((LabelTiming_Slot(ch) % w->shards) == w->shard)
+            {
+                (void)AnalyzerCore_ProcessWord(&w->core, ch, word, ts, NULL);
+            }
+        }
+    }
+    return NULL;
+}
+
+static int analyze_files(analyzer_core_t *out, char **paths, int npaths, uint32_t threads)
+{
+    static worker_t workers[MAX_THREADS];
+    pthread_t tid[MAX_THREADS];
+
+    for (int p = 0; p < npaths; p++)
+    {
+        uint8_t *buf = NULL;
+        block_index_t idx;
+        uint32_t skipped = 0U;
+
+        if (index_file(paths[p], &buf, &idx, &skipped) != 0)
+        {
+            return 1;
+        }
+        if (skipped != 0U)
+        {
+            fprintf(stderr, "%s: skipped %u bytes of damaged or foreign data\n", paths[p], (unsigned)skipped);
+        }
+
+        double t0 = now_s();
+        for (uint32_t t = 0U; t < threads; t++)
+        {
+            workers[t].index  = &idx;
+            workers[t].shard  = t;
+            workers[t].shards = threads;
+            AnalyzerCore_Init(&workers[t].core);
+            if (pthread_create(&tid[t], NULL, worker_main, &workers[t]) != 0)
+            {
+                perror("pthread_create");
+                return 1;
+            }
+        }
+        for (uint32_t t = 0U; t < threads; t++)
+        {
+            pthread_join(tid[t], NULL);
+            AnalyzerCore_Merge(out, &workers[t].core);
+        }
+        double el = now_s() - t0;
+
+        uint64_t words = 0U;
+        for (size_t b = 0U; b < idx.count; b++)
+        {
+            words += idx.blocks[b].count;
+        }
+        fprintf(stderr, "%s: %zu blocks, %llu words, %u thread(s), %.3f s, %.1f Mwords/s\n",
+                paths[p], idx.count, (unsigned long long)words, (unsigned)threads, el,
+                (el > 0.0) ? ((double)words / el / 1e6) : 0.0);
+
+        free(idx.blocks);
+        free(buf);
+    }
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Live stream (single thread; a UART link is far below one core's rate)
+ * ------------------------------------------------------------------------- */
+
+typedef struct
+{
+    analyzer_core_t *core;
+    double           t0;
+} stream_ctx_t;
+
+static uint32_t host_us(const stream_ctx_t *c)
+{
+    return (uint32_t)((now_s() - c->t0) * 1e6);
+}
+
+static void on_sniff_word(const sniff_word_t *w, void *user)
+{
+    stream_ctx_t *c = user;
+    (void)AnalyzerCore_ProcessWord(c->core, w->channel, w->word, w->ts_us, NULL);
+}
+
+static int analyze_stream(analyzer_core_t *core, const char *path, const char *format)
+{
+    int fd = (strcmp(path, "-") == 0) ? STDIN_FILENO : open(path, O_RDONLY | O_NOCTTY);
+    stream_ctx_t ctx = {core, now_s()};
+    static uint8_t acc[4U * CAPTURE_BLOCK_MAX];
+    size_t accLen = 0U;
+    char line[128];
+    size_t lineLen = 0U;
+    sniff_parser_t sp;
+    uint32_t rejected = 0U;
+
+    if (fd < 0)
+    {
+        perror(path);
+        return 1;
+    }
+    if (isatty(fd))
+    {
+        struct termios tio;
+        if (tcgetattr(fd, &tio) == 0)
+        {
+            cfmakeraw(&tio);
+            (void)tcsetattr(fd, TCSANOW, &tio);
+        }
+    }
+    SniffFrame_ParserInit(&sp);
+
+    while (!s_stop)
+    {
+        uint8_t buf[4096];
+        ssize_t n = read(fd, buf, sizeof(buf));
+
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("read");
+            break;
+        }
+        if (n == 0)
+        {
+            break;
+        }
+
+        if (strcmp(format, "sniff") == 0)
+        {
+            (void)SniffFrame_Parse(&sp, buf, (size_t)n, on_sniff_word, &ctx);
+        }
+        else if (strcmp(format, "ascii") == 0)
+        {
+            uint32_t ts = host_us(&ctx);
+            for (ssize_t i = 0; i < n; i++)
+            {
+                char ch = (char)buf[i];
+                if ((ch == '\r') || (ch == '\n'))
+                {
+                    a429_text_word_t w;
+                    if (lineLen == 0U)
+                    {
+                        continue;
+                    }
+                    if (A429Text_ParseLine(line, lineLen, &w))
+                    {
+                        (void)AnalyzerCore_ProcessWord(core, w.channel, w.word, ts, NULL);
+                    }
+                    else
+                    {
+                        rejected++;
+                    }
+                    lineLen = 0U;
+                }
+                else if (lineLen < sizeof(line))
+                {
+                    line[lineLen++] = ch;
+                }
+                else
+                {
+                    lineLen = 0U; /* overflow, drop line */
+                }
+            }
+        }
+        else
+        {
+            size_t used = 0U;
+
+            while (used < (size_t)n)
+            {
+                size_t off = 0U;
+                size_t take = (size_t)n - used;
+
+                if (take > (sizeof(acc) - accLen))
+                {
+                    take = sizeof(acc) - accLen;
+                }
+                memcpy(&acc[accLen], &buf[used], take);
+                accLen += take;
+                used += take;
+
+                while (off < accLen)
+                {
+                    capture_block_t b;
+                    int32_t len = Capture_ParseBlock(&acc[off], accLen - off, &b);
+                    if (len == 0)
+                    {
+                        break;
+                    }
+                    if (len < 0)
+                    {
+                        off++;
+                        continue;
+                    }
+                    uint32_t ts = b.firstTsUs;
+                    for (uint32_t i = 0U; i < b.count; i++)
+                    {
+                        uint8_t ch;
+                        uint32_t word, dt;
+                        Capture_GetRecord(&b, i, &ch, &word, &dt);
+                        ts += dt;
+                        (void)AnalyzerCore_ProcessWord(core, ch, word, ts, NULL);
+                    }
+                    off += (size_t)len;
+                }
+                memmove(acc, &acc[off], accLen - off);
+                accLen -= off;
+            }
+        }
+    }
+
+    if (rejected != 0U)
+    {
+        fprintf(stderr, "rejected %u malformed lines\n", (unsigned)rejected);
+    }
+    if (fd != STDIN_FILENO)
+    {
+        close(fd);
+    }
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Reports
+ * ------------------------------------------------------------------------- */
+
+static void report_csv(const analyzer_core_t *a)
+{
+    const label_stats_t *st = &a->stats;
+    const label_timing_t *tm = &a->timing;
+
+    printf("label,count");
+    for (uint32_t c = 0U; c < LABEL_STATS_CHANNELS; c++)
+    {
+        printf(",ch%u", (unsigned)(c + 1U));
+    }
+    printf(",parity_errors,last_data,last_sdi,last_ssm,last_channel");
+    /* Timing per channel slot, the other-channels slot last */
+    for (uint32_t c = 1U; c <= LABEL_TIMING_SLOTS; c++)
+    {
+        const uint32_t s = c % LABEL_TIMING_SLOTS;
+        char pfx[16];
+
+        if (s != 0U) snprintf(pfx, sizeof(pfx), "ch%u", (unsigned)s);
+        else         snprintf(pfx, sizeof(pfx), "other");
+        printf(",%s_periods,%s_min_us,%s_mean_us,%s_max_us", pfx, pfx, pfx, pfx);
+    }
+    printf("\n");
+
+    for (uint32_t l = LabelStats_Next(st, 0U); l < LABEL_STATS_LABELS; l = LabelStats_Next(st, l + 1U))
+    {
+        uint32_t last = st->lastWord[l];
+
+        printf("0x%02X,%u", (unsigned)l, (unsigned)st->total[l]);
+        for (uint32_t c = 0U; c < LABEL_STATS_CHANNELS; c++)
+        {
+            printf(",%u", (unsigned)st->chCount[c][l]);
+        }
+        printf(",%u,0x%05X,%u,%u,%u",
+               (unsigned)st->parityErr[l], (unsigned)A429_GetData(last),
+               (unsigned)A429_GetSdi(last), (unsigned)A429_GetSsm(last), (unsigned)st->lastChannel[l]);
+        for (uint32_t c = 1U; c <= LABEL_TIMING_SLOTS; c++)
+        {
+            const uint32_t s = c % LABEL_TIMING_SLOTS;
+            const uint32_t n = tm->periods[s][l];
+
+            printf(",%u,%u,%u,%u", (unsigned)n, (unsigned)((n != 0U) ? tm->minUs[s][l] : 0U),
+                   (unsigned)((n != 0U) ? (tm->sumUs[s][l] / n) : 0U), (unsigned)tm->maxUs[s][l]);
+        }
+        printf("\n");
+    }
+}
+
+static void report_json(const analyzer_core_t *a)
+{
+    const label_stats_t *st = &a->stats;
+    const label_timing_t *tm = &a->timing;
+    const char *sep = "";
+
+    printf("{\n  \"total_words\": %u,\n  \"total_parity_errors\": %u,\n  \"labels\": [",
+           (unsigned)a->totalWords, (unsigned)a->totalParityErrors);
+    for (uint32_t l = LabelStats_Next(st, 0U); l < LABEL_STATS_LABELS; l = LabelStats_Next(st, l + 1U))
+    {
+        uint32_t last = st->lastWord[l];
+        const char *psep = "";
+
+        printf("%s\n    {\"label\": %u, \"count\": %u, \"channels\": [", sep, (unsigned)l, (unsigned)st->total[l]);
+        for (uint32_t c = 0U; c < LABEL_STATS_CHANNELS; c++)
+        {
+            printf("%s%u", (c != 0U) ? ", " : "", (unsigned)st->chCount[c][l]);
+        }
+        printf("], \"parity_errors\": %u, \"last\": {\"data\": %u, \"sdi\": %u, \"ssm\": %u, \"channel\": %u}, "
+               "\"period_us\": [",
+               (unsigned)st->parityErr[l], (unsigned)A429_GetData(last),
+               (unsigned)A429_GetSdi(last), (unsigned)A429_GetSsm(last), (unsigned)st->lastChannel[l]);
+        /* One entry per channel slot with periods; ch null = other channels */
+        for (uint32_t c = 1U; c <= LABEL_TIMING_SLOTS; c++)
+        {
+            const uint32_t s = c % LABEL_TIMING_SLOTS;
+            const uint32_t n = tm->periods[s][l];
+            char ch[12];
+
+            if (n == 0U) continue;
+            if (s != 0U) snprintf(ch, sizeof(ch), "%u", (unsigned)s);
+            else         snprintf(ch, sizeof(ch), "null");
+            printf("%s{\"ch\": %s, \"n\": %u, \"min\": %u, \"mean\": %u, \"max\": %u}", psep, ch,
+                   (unsigned)n, (unsigned)tm->minUs[s][l], (unsigned)(tm->sumUs[s][l] / n), (unsigned)tm->maxUs[s][l]);
+            psep = ", ";
+        }
+        printf("]}");
+        sep = ",";
+    }
+    printf("\n  ]\n}\n");
+}
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: a429_analyze [-j N] [--out summary|csv|json] <capture>...\n"
+                    "       a429_analyze [--format capture|ascii|sniff] [--out ...] --stream <path|->\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    static analyzer_core_t core;
+    out_format_t out = OUT_SUMMARY;
+    const char *format = "capture";
+    const char *stream = NULL;
+    uint32_t threads = 1U;
+    char *files[64];
+    int nfiles = 0;
+    int rc;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-j") == 0) && (i + 1 < argc))
+        {
+            threads = (uint32_t)strtoul(argv[++i], NULL, 0);
+            if ((threads == 0U) || (threads > MAX_THREADS))
+            {
+                return usage();
+            }
+        }
+        else if ((strcmp(argv[i], "--out") == 0) && (i + 1 < argc))
+        {
+            const char *o = argv[++i];
+            if (strcmp(o, "summary") == 0)   out = OUT_SUMMARY;
+            else if (strcmp(o, "csv") == 0)  out = OUT_CSV;
+            else if (strcmp(o, "json") == 0) out = OUT_JSON;
+            else return usage();
+        }
+        else if ((strcmp(argv[i], "--format") == 0) && (i + 1 < argc))
+        {
+            format = argv[++i];
+            if ((strcmp(format, "capture") != 0) && (strcmp(format, "ascii") != 0) && (strcmp(format, "sniff") != 0))
+            {
+                return usage();
+            }
+        }
+        else if ((strcmp(argv[i], "--stream") == 0) && (i + 1 < argc))
+        {
+            stream = argv[++i];
+        }
+        else if ((argv[i][0] != '-') && (nfiles < (int)(sizeof(files) / sizeof(files[0]))))
+        {
+            files[nfiles++] = argv[i];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    if ((stream == NULL) == (nfiles == 0))
+    {
+        return usage();
+    }
+
+    AnalyzerCore_Init(&core);
+    if (stream != NULL)
+    {
+        signal(SIGINT, on_sigint);
+        rc = analyze_stream(&core, stream, format);
+    }
+    else
+    {
+        rc = analyze_files(&core, files, nfiles, threads);
+    }
+    if (rc != 0)
+    {
+        return rc;
+    }
+
+    switch (out)
+    {
+        case OUT_SUMMARY:
+            AnalyzerCore_PrintSummary(&core, print_stdout);
+            AnalyzerCore_PrintLabelTable(&core, print_stdout);
+            AnalyzerCore_PrintTiming(&core, print_stdout);
+            break;
+        case OUT_CSV:
+            report_csv(&core);
+            break;
+        case OUT_JSON:
+            report_json(&core);
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,483 @@
+/*
+ * Host-side benchmarks of the board-free ARINC 429 code.
+ *
+ * Build (from DAY10_EXERCISES/host):
+ *   S="../SOFTWARE_FAULT_INJECTION_ DATA_CORRUPTION_API_FAILURES"
+ *   gcc -O2 -std=c11 -D_POSIX_C_SOURCE=200809L -I"$S" -I../analyzer \
+ *       a429_bench.c "$S/a429_frame.c" ../analyzer/label_stats.c -o a429_bench
+ *   (add -DA429_PARITY_INLINE_FOLD to time A429_Parity32 as the xor fold)
+ *
+ * Usage:
+ *   a429_bench parser [options] [corpus]   SFI link RX: A429_ParserFeed byte by
+ *                                          byte against A429_ParserFeedBuf in
+ *                                          chunks, then the per-word validation
+ *                                          cost of the old parity routines
+ *   a429_bench layout [options]            analyzer label stats: the old
+ *                                          struct-per-label table against
+ *                                          label_stats.h (hot/cold split,
+ *                                          bitmap listing)
+ * Options:
+ *   --frames N     parser: synthetic corpus frames (default 100000)
+ *                  layout: words in the synthetic stream (default 1000000)
+ *   --rounds N     timed passes per variant, best one reported (default 20)
+ *   --seed S       corpus seed (default 0x1234567)
+ *
+ * The synthetic corpus is SFI link frames where ~1 in 8 has a bad checksum,
+ * ~1 in 16 is preceded by a stray 0xA5 and ~1 in 16 by a noise byte. A
+ * corpus file instead is taken as raw RX bytes (e.g. a capture of the data
+ * UART). Every chunk size must decode the same words as the whole corpus
+ * in one call; the byte-wise feed does not resync behind a false sync, so
+ * it reports fewer on a damaged corpus.
+ *
+ * The layout stream is a few dozen busy labels plus a sparse tail on two
+ * channels, 1 in 64 words with bad parity, the same sequence for both
+ * layouts. For the cache side run it under
+ *   perf stat -e cycles,L1-dcache-load-misses ./a429_bench layout
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "a429_frame.h"
+#include "label_stats.h"
+#include "../common/a429_word.h"
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t rounds;
+    uint32_t seed;
+} bench_opts_t;
+
+static uint8_t *g_corpus;
+static size_t   g_corpusLen;
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static uint32_t xorshift32(uint32_t *x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+static uint8_t *load_file(const char *path, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+    long n;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((n > 0) ? (size_t)n : 1U);
+    if ((buf == NULL) || (fread(buf, 1, (size_t)n, f) != (size_t)n))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        fclose(f);
+        free(buf);
+        return NULL;
+    }
+    fclose(f);
+    *len = (size_t)n;
+    return buf;
+}
+
+static void put_frame(uint32_t w, bool badChk)
+{
+    uint8_t *f = &g_corpus[g_corpusLen];
+
+    f[0] = A429_FRAME_SYNC;
+    f[1] = 4U;
+    f[2] = (uint8_t)w;
+    f[3] = (uint8_t)(w >> 8);
+    f[4] = (uint8_t)(w >> 16);
+    f[5] = (uint8_t)(w >> 24);
+    f[6] = (uint8_t)(f[1] + f[2] + f[3] + f[4] + f[5]);
+    if (badChk) f[6] ^= 0x01U;
+    g_corpusLen += A429_FRAME_LEN;
+}
+
+/* Returns the number of frames with a good checksum */
+static uint32_t build_corpus(uint32_t frames, uint32_t seed)
+{
+    uint32_t x = (seed != 0U) ? seed : 1U;
+    uint32_t good = 0U;
+
+    g_corpus = malloc((size_t)frames * (A429_FRAME_LEN + 2U));
+    if (g_corpus == NULL) return 0U;
+    g_corpusLen = 0U;
+
+    for (uint32_t i = 0U; i < frames; i++)
+    {
+        const bool bad = ((xorshift32(&x) & 0x7U) == 0U);
+
+        if ((x & 0xF00U) == 0x100U) g_corpus[g_corpusLen++] = A429_FRAME_SYNC;
+        if ((x & 0xF00U) == 0x200U) g_corpus[g_corpusLen++] = (uint8_t)(x >> 24);
+        put_frame(x, bad);
+        if (!bad) good++;
+    }
+    return good;
+}
+
+static uint32_t feed_bytes(void)
+{
+    a429_uart_parser_t p;
+    uint32_t word;
+    uint32_t words = 0U;
+
+    A429_ParserInit(&p);
+    for (size_t i = 0U; i < g_corpusLen; i++)
+    {
+        if (A429_ParserFeed(&p, g_corpus[i], &word) == A429_PARSE_WORD_OK) words++;
+    }
+    return words;
+}
+
+/* chunk bytes per call, as the main loop hands over ring spans */
+static uint32_t feed_buf(size_t chunk)
+{
+    a429_uart_parser_t p;
+    uint32_t out[16];
+    uint32_t words = 0U;
+
+    A429_ParserInit(&p);
+    for (size_t pos = 0U; pos < g_corpusLen;)
+    {
+        size_t n = g_corpusLen - pos;
+        size_t used = 0U;
+
+        if (n > chunk) n = chunk;
+        for (size_t off = 0U; off < n; off += used)
+        {
+            words += A429_ParserFeedBuf(&p, &g_corpus[pos + off], n - off, out, 16U, &used);
+        }
+        pos += n;
+    }
+    return words;
+}
+
+/* chunk == 0 times the byte-wise feed; returns the words of the last pass */
+static uint32_t time_feed(const bench_opts_t *o, size_t chunk, double *best)
+{
+    uint32_t words = 0U;
+
+    *best = 0.0;
+    for (uint32_t r = 0U; r < o->rounds; r++)
+    {
+        const double t0 = now_s();
+        words = (chunk == 0U) ? feed_bytes() : feed_buf(chunk);
+        const double t = now_s() - t0;
+        if ((r == 0U) || (t < *best)) *best = t;
+    }
+    return words;
+}
+
+/* Parity variants the tree used before common/a429_word.h, kept here only
+ * as the baseline for the per-word validation cost. */
+static uint32_t parity_bitloop(uint32_t v)
+{
+    uint32_t p = 0U;
+    while (v != 0U)
+    {
+        p ^= v & 1U;
+        v >>= 1U;
+    }
+    return p;
+}
+
+static uint32_t parity_nibble_fold(uint32_t x)
+{
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    return (0x6996U >> (x & 0xFU)) & 1U;
+}
+
+static uint32_t parity_swar_popcount(uint32_t x)
+{
+    x = x - ((x >> 1U) & 0x55555555U);
+    x = (x & 0x33333333U) + ((x >> 2U) & 0x33333333U);
+    x = (x + (x >> 4U)) & 0x0F0F0F0FU;
+    x = x + (x >> 8U);
+    x = x + (x >> 16U);
+    return x & 1U;
+}
+
+typedef uint32_t (*bench_parity_fn_t)(uint32_t v);
+
+/* Per-word validation: parity (called through a pointer, so every variant
+ * pays the same call) plus the label/SDI/SSM/data field extraction the
+ * receivers do on every accepted word. */
+static void bench_parity(const bench_opts_t *o)
+{
+    static const struct
+    {
+        const char       *name;
+        bench_parity_fn_t fn;
+    } variants[] = {
+        {"bit loop     ", parity_bitloop},
+        {"nibble fold  ", parity_nibble_fold},
+        {"SWAR popcount", parity_swar_popcount},
+        {"A429_Parity32", A429_Parity32},
+    };
+    bench_parity_fn_t volatile fn;
+    const uint32_t n = o->frames;
+
+    printf("\nWord validation: %u words (parity + field extraction)\n", (unsigned)n);
+    for (size_t v = 0U; v < (sizeof(variants) / sizeof(variants[0])); v++)
+    {
+        uint32_t odd = 0U;
+        uint32_t sink = 0U;
+        double best = 0.0;
+
+        fn = variants[v].fn;
+        for (uint32_t r = 0U; r < o->rounds; r++)
+        {
+            uint32_t x = o->seed;
+            const double t0 = now_s();
+
+            odd = 0U;
+            for (uint32_t i = 0U; i < n; i++)
+            {
+                xorshift32(&x);
+                odd += fn(x);
+                sink += A429_GetLabel(x) + A429_GetSdi(x) + A429_GetSsm(x) + A429_GetData(x);
+            }
+            const double t = now_s() - t0;
+            if ((r == 0U) || (t < best)) best = t;
+        }
+        printf("  %s %7.3f ns/word odd=%u (sink %08x)\n",
+               variants[v].name, (best * 1e9) / (double)n, (unsigned)odd, (unsigned)sink);
+    }
+}
+
+static int cmd_parser(const bench_opts_t *o, const char *path)
+{
+    static const size_t chunks[] = {16U, 64U, 256U, 4096U, 0U};
+    double t;
+    uint32_t bytewise;
+    uint32_t ref;
+    int rc = 0;
+
+    if (path != NULL)
+    {
+        g_corpus = load_file(path, &g_corpusLen);
+        if (g_corpus == NULL) return 1;
+        printf("Parser: %s, %zu bytes\n", path, g_corpusLen);
+    }
+    else
+    {
+        const uint32_t good = build_corpus(o->frames, o->seed);
+        if (g_corpus == NULL) return 1;
+        printf("Parser: %zu bytes, %u frames (%u valid)\n", g_corpusLen, (unsigned)o->frames, (unsigned)good);
+    }
+
+    ref = feed_buf(g_corpusLen);
+    bytewise = time_feed(o, 0U, &t);
+    printf("  byte-wise          words=%8u %7.3f ns/byte %8.1f MB/s  (%u lost without resync)\n",
+           (unsigned)bytewise, (t * 1e9) / (double)g_corpusLen, ((double)g_corpusLen / t) * 1e-6,
+           (unsigned)(ref - bytewise));
+
+    for (size_t c = 0U; c < (sizeof(chunks) / sizeof(chunks[0])); c++)
+    {
+        /* 0: the whole corpus in one call */
+        const size_t chunk = (chunks[c] != 0U) ? chunks[c] : g_corpusLen;
+        const uint32_t words = time_feed(o, chunk, &t);
+
+        printf("  buf chunk=%-8zu words=%8u %7.3f ns/byte %8.1f MB/s%s\n",
+               chunk, (unsigned)words, (t * 1e9) / (double)g_corpusLen, ((double)g_corpusLen / t) * 1e-6,
+               (words != ref) ? "  MISMATCH" : "");
+        if (words != ref) rc = 1;
+    }
+
+    bench_parity(o);
+    free(g_corpus);
+    return rc;
+}
+
+/* Old layout: one 24-byte struct per label, all fields touched per word. */
+typedef struct
+{
+    uint32_t totalCount;
+    uint32_t ch1Count;
+    uint32_t ch2Count;
+    uint32_t parityErrorCount;
+    uint32_t lastData;
+    uint8_t  lastSdi;
+    uint8_t  lastSsm;
+    uint8_t  lastChannel;
+} bench_aos_t;
+
+static bench_aos_t   s_aos[LABEL_STATS_LABELS];
+static label_stats_t s_split;
+
+#define BENCH_NEXT_WORD(x) ((x) = ((x) * 1664525UL) + 1013904223UL)
+#define BENCH_LIST_ROUNDS  1000U
+
+static void record_aos(uint32_t n, uint32_t seed)
+{
+    memset(s_aos, 0, sizeof(s_aos));
+    for (uint32_t i = 0U; i < n; i++)
+    {
+        const uint32_t w   = BENCH_NEXT_WORD(seed);
+        const uint32_t lbl = ((w & 0x300U) != 0U) ? (w & 0x3FU) : (w & 0xFFU);
+        const uint8_t  ch  = (uint8_t)(1U + ((w >> 12) & 1U));
+        const bool     ok  = ((w >> 20) & 0x3FU) != 0U;
+        bench_aos_t   *st  = &s_aos[lbl];
+
+        st->totalCount++;
+        if (ch == 1U)
+        {
+            st->ch1Count++;
+        }
+        else
+        {
+            st->ch2Count++;
+        }
+        if (!ok)
+        {
+            st->parityErrorCount++;
+        }
+        st->lastData    = (w >> 10) & 0x7FFFFU;
+        st->lastSdi     = (uint8_t)((w >> 8) & 0x03U);
+        st->lastSsm     = (uint8_t)((w >> 29) & 0x03U);
+        st->lastChannel = ch;
+    }
+}
+
+static void record_split(uint32_t n, uint32_t seed)
+{
+    LabelStats_Clear(&s_split);
+    for (uint32_t i = 0U; i < n; i++)
+    {
+        const uint32_t w   = BENCH_NEXT_WORD(seed);
+        const uint32_t lbl = ((w & 0x300U) != 0U) ? (w & 0x3FU) : (w & 0xFFU);
+        const uint8_t  ch  = (uint8_t)(1U + ((w >> 12) & 1U));
+        const bool     ok  = ((w >> 20) & 0x3FU) != 0U;
+
+        LabelStats_Record(&s_split, (w & ~0xFFUL) | lbl, ch, ok);
+    }
+}
+
+/* Listing cost without printing: full scan vs bitmap walk */
+static uint32_t list_aos(void)
+{
+    uint32_t seen = 0U;
+    for (uint32_t lbl = 0U; lbl < LABEL_STATS_LABELS; lbl++)
+    {
+        seen += (s_aos[lbl].totalCount != 0U) ? 1U : 0U;
+    }
+    return seen;
+}
+
+static uint32_t list_split(void)
+{
+    uint32_t seen = 0U;
+    for (uint32_t lbl = LabelStats_Next(&s_split, 0U); lbl < LABEL_STATS_LABELS;
+         lbl = LabelStats_Next(&s_split, lbl + 1U))
+    {
+        seen++;
+    }
+    return seen;
+}
+
+static int cmd_layout(const bench_opts_t *o)
+{
+    double tAos = 0.0, tSplit = 0.0, lAos = 0.0, lSplit = 0.0;
+    uint32_t volatile seenAos = 0U, seenSplit = 0U;
+    bool same = true;
+
+    for (uint32_t r = 0U; r < o->rounds; r++)
+    {
+        double t0 = now_s();
+        record_aos(o->frames, o->seed);
+        double t = now_s() - t0;
+        if ((r == 0U) || (t < tAos)) tAos = t;
+
+        t0 = now_s();
+        record_split(o->frames, o->seed);
+        t = now_s() - t0;
+        if ((r == 0U) || (t < tSplit)) tSplit = t;
+
+        t0 = now_s();
+        for (uint32_t k = 0U; k < BENCH_LIST_ROUNDS; k++) seenAos = list_aos();
+        t = now_s() - t0;
+        if ((r == 0U) || (t < lAos)) lAos = t;
+
+        t0 = now_s();
+        for (uint32_t k = 0U; k < BENCH_LIST_ROUNDS; k++) seenSplit = list_split();
+        t = now_s() - t0;
+        if ((r == 0U) || (t < lSplit)) lSplit = t;
+    }
+
+    for (uint32_t lbl = 0U; lbl < LABEL_STATS_LABELS; lbl++)
+    {
+        same = same && (s_aos[lbl].totalCount == s_split.total[lbl]) &&
+               (s_aos[lbl].ch1Count == s_split.chCount[0][lbl]) &&
+               (s_aos[lbl].ch2Count == s_split.chCount[1][lbl]) &&
+               (s_aos[lbl].parityErrorCount == s_split.parityErr[lbl]);
+    }
+
+    printf("Label stats: %u words, tables %zu vs %zu bytes\n",
+           (unsigned)o->frames, sizeof(s_aos), sizeof(s_split));
+    printf("  struct/label %7.3f ns/word, list %7.1f ns\n",
+           (tAos * 1e9) / (double)o->frames, (lAos * 1e9) / (double)BENCH_LIST_ROUNDS);
+    printf("  hot/cold     %7.3f ns/word, list %7.1f ns\n",
+           (tSplit * 1e9) / (double)o->frames, (lSplit * 1e9) / (double)BENCH_LIST_ROUNDS);
+    printf("  labels seen  %u / %u, counters %s\n",
+           (unsigned)seenAos, (unsigned)seenSplit, same ? "match" : "MISMATCH");
+    return same ? 0 : 1;
+}
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: a429_bench parser [--frames N] [--rounds N] [--seed S] [corpus]\n"
+                    "       a429_bench layout [--frames N] [--rounds N] [--seed S]\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    bench_opts_t o = {100000U, 20U, 0x1234567U};
+    const char *path = NULL;
+    bool layout;
+
+    if (argc < 2) return usage();
+    layout = (strcmp(argv[1], "layout") == 0);
+    if (layout)
+        o.frames = 1000000U;
+    else if (strcmp(argv[1], "parser") != 0)
+        return usage();
+
+    for (int i = 2; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--frames") == 0) && ((i + 1) < argc))
+            o.frames = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "--rounds") == 0) && ((i + 1) < argc))
+            o.rounds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "--seed") == 0) && ((i + 1) < argc))
+            o.seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if ((argv[i][0] != '-') && (path == NULL) && !layout)
+            path = argv[i];
+        else
+            return usage();
+    }
+    if ((o.frames == 0U) || (o.rounds == 0U)) return usage();
+
+    return layout ? cmd_layout(&o) : cmd_parser(&o, path);
+}
@@ -0,0 +1,429 @@
+/*
+ * Host-side replay of analyzer capture files (analyzer/capture.h format).
+ *
+ * Build (from DAY10_EXERCISES/host):
+ *   gcc -O2 -std=c11 -D_POSIX_C_SOURCE=200809L -I../analyzer \
+ *       -I"../SOFTWARE_FAULT_INJECTION_ DATA_CORRUPTION_API_FAILURES" \
+ *       a429_replay.c ../analyzer/capture.c ../common/crc32.c ../analyzer/a429_text.c \
+ *       ../analyzer/label_stats.c ../analyzer/label_timing.c \
+ *       "../SOFTWARE_FAULT_INJECTION_ DATA_CORRUPTION_API_FAILURES/a429_frame.c" \
+ *       "../SOFTWARE_FAULT_INJECTION_ DATA_CORRUPTION_API_FAILURES/a429_plaus.c" \
+ *       -o a429_replay
+ *
+ * Usage:
+ *   a429_replay index <capture>                 list blocks (seq, first ts, words)
+ *   a429_replay text  <capture> [options]       CH lines -> A429Text + label stats/timing
+ *   a429_replay frame <capture> [options]       SFI link frames -> A429_ParserFeed
+ *   a429_replay plaus <capture> [options]       parity + plausibility barrier
+ *   a429_replay gen   <capture> <words>         write a synthetic capture
+ * Options:
+ *   --speed X       pace at X times real time (default 0: as fast as possible)
+ *   --from-us T     start at the first block whose timestamp is >= T
+ *   --allow L,L,..  plausibility allow-list in hex (default: all labels)
+ *   --interval MS   plausibility minimum repeat interval (default 20)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "capture.h"
+#include "a429_text.h"
+#include "label_stats.h"
+#include "label_timing.h"
+#include "a429_frame.h"
+#include "a429_plaus.h"
+#include "../common/a429_word.h"
+
+typedef enum
+{
+    MODE_TEXT,
+    MODE_FRAME,
+    MODE_PLAUS,
+} replay_mode_t;
+
+typedef struct
+{
+    replay_mode_t mode;
+    double        speed;
+    uint32_t      fromUs;
+
+    /* text */
+    label_stats_t  stats;
+    label_timing_t timing;
+    uint32_t       textRejected;
+
+    /* frame */
+    a429_uart_parser_t parser;
+    uint32_t           frameMismatch;
+
+    /* plaus */
+    a429_plaus_t plaus;
+    uint32_t     plausOk, plausBadParity, plausBadPlaus;
+
+    uint32_t words;
+} replay_t;
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static uint8_t *load_file(const char *path, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+    long n;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((n > 0) ? (size_t)n : 1U);
+    if ((buf == NULL) || (fread(buf, 1, (size_t)n, f) != (size_t)n))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        fclose(f);
+        free(buf);
+        return NULL;
+    }
+    fclose(f);
+    *len = (size_t)n;
+    return buf;
+}
+
+static bool odd_parity_ok(uint32_t word)
+{
+    return A429_CheckOddParity(word);
+}
+
+static void replay_word(replay_t *r, uint8_t channel, uint32_t word, uint32_t tsUs)
+{
+    r->words++;
+
+    switch (r->mode)
+    {
+        case MODE_TEXT:
+        {
+            /* Same line the sniffer would have sent */
+            char line[64];
+            int n = snprintf(line, sizeof(line), "CH%u LBL=%02X SDI=%u DATA=%05X SSM=%u P=%u",
+                             (unsigned)channel, (unsigned)A429_GetLabel(word), (unsigned)A429_GetSdi(word),
+                             (unsigned)A429_GetData(word), (unsigned)A429_GetSsm(word),
+                             (unsigned)A429_GetParity(word));
+            a429_text_word_t w;
+            if (!A429Text_ParseLine(line, (size_t)n, &w))
+            {
+                r->textRejected++;
+                break;
+            }
+            LabelStats_Record(&r->stats, w.word, w.channel, odd_parity_ok(w.word));
+            LabelTiming_Record(&r->timing, w.channel, (uint8_t)A429_GetLabel(w.word), tsUs);
+            break;
+        }
+
+        case MODE_FRAME:
+        {
+            uint8_t f[A429_FRAME_LEN] = {A429_FRAME_SYNC, 4U,
+                                         (uint8_t)word, (uint8_t)(word >> 8),
+                                         (uint8_t)(word >> 16), (uint8_t)(word >> 24), 0U};
+            f[6] = (uint8_t)(f[1] + f[2] + f[3] + f[4] + f[5]);
+            for (uint32_t i = 0U; i < A429_FRAME_LEN; i++)
+            {
+                uint32_t out;
+                if ((A429_ParserFeed(&r->parser, f[i], &out) == A429_PARSE_WORD_OK) && (out != word))
+                {
+                    r->frameMismatch++;
+                }
+            }
+            break;
+        }
+
+        case MODE_PLAUS:
+            if (!odd_parity_ok(word))
+            {
+                r->plausBadParity++;
+            }
+            else if (!A429Plaus_Accept(&r->plaus, A429_Label(word), tsUs / 1000U))
+            {
+                r->plausBadPlaus++;
+            }
+            else
+            {
+                r->plausOk++;
+            }
+            break;
+    }
+}
+
+static int cmd_index(const uint8_t *buf, size_t len)
+{
+    size_t off = 0U;
+    uint32_t bad = 0U;
+
+    printf("%-10s %-8s %-12s %s\n", "offset", "seq", "first_us", "words");
+    while (off < len)
+    {
+        capture_block_t b;
+        int32_t n = Capture_ParseBlock(&buf[off], len - off, &b);
+        if (n <= 0)
+        {
+            bad += (n < 0) ? 1U : 0U;
+            off += (n < 0) ? 1U : (len - off);
+            continue;
+        }
+        printf("%-10zu %-8u %-12u %u\n", off, (unsigned)b.seq, (unsigned)b.firstTsUs, (unsigned)b.count);
+        off += (size_t)n;
+    }
+    if (bad != 0U)
+    {
+        printf("skipped %u bytes of damaged or foreign data\n", (unsigned)bad);
+    }
+    return 0;
+}
+
+static int cmd_replay(replay_t *r, const uint8_t *buf, size_t len)
+{
+    size_t off = 0U;
+    uint32_t blocks = 0U, skipped = 0U;
+    bool started = (r->fromUs == 0U);
+    double t0 = now_s();
+    double firstCapUs = -1.0;
+
+    while (off < len)
+    {
+        capture_block_t b;
+        int32_t n = Capture_ParseBlock(&buf[off], len - off, &b);
+        if (n <= 0)
+        {
+            skipped += (n < 0) ? 1U : 0U;
+            off += (n < 0) ? 1U : (len - off);
+            continue;
+        }
+        off += (size_t)n;
+
+        if (!started)
+        {
+            if (b.firstTsUs < r->fromUs)
+            {
+                continue;
+            }
+            started = true;
+        }
+        blocks++;
+
+        uint32_t ts = b.firstTsUs;
+        for (uint32_t i = 0U; i < b.count; i++)
+        {
+            uint8_t ch;
+            uint32_t word, dt;
+
+            Capture_GetRecord(&b, i, &ch, &word, &dt);
+            ts += dt;
+
+            if (r->speed > 0.0)
+            {
+                if (firstCapUs < 0.0)
+                {
+                    firstCapUs = ts;
+                }
+                double due = t0 + (((double)ts - firstCapUs) * 1e-6 / r->speed);
+                double wait = due - now_s();
+                if (wait > 0.0)
+                {
+                    struct timespec d = {(time_t)wait, (long)((wait - (double)(time_t)wait) * 1e9)};
+                    nanosleep(&d, NULL);
+                }
+            }
+            replay_word(r, ch, word, ts);
+        }
+    }
+
+    double el = now_s() - t0;
+    printf("blocks %u, words %u, skipped bytes %u, %.3f s, %.0f words/s\n",
+           (unsigned)blocks, (unsigned)r->words, (unsigned)skipped, el,
+           (el > 0.0) ? ((double)r->words / el) : 0.0);
+
+    switch (r->mode)
+    {
+        case MODE_TEXT:
+        {
+            uint32_t labels = 0U, parity = 0U;
+            for (uint32_t l = LabelStats_Next(&r->stats, 0U); l < LABEL_STATS_LABELS; l = LabelStats_Next(&r->stats, l + 1U))
+            {
+                labels++;
+                parity += r->stats.parityErr[l];
+            }
+            printf("text: rejected %u, labels %u, parity errors %u\n",
+                   (unsigned)r->textRejected, (unsigned)labels, (unsigned)parity);
+            for (uint32_t l = LabelStats_Next(&r->stats, 0U); l < LABEL_STATS_LABELS; l = LabelStats_Next(&r->stats, l + 1U))
+            {
+                for (uint32_t s = 0U; s < LABEL_TIMING_SLOTS; s++)
+                {
+                    uint32_t p = r->timing.periods[s][l];
+                    if (p != 0U)
+                    {
+                        printf("  0x%02X ch%s%u periods=%u min=%u mean=%u max=%u us\n", (unsigned)l,
+                               (s != 0U) ? "" : ">", (unsigned)((s != 0U) ? s : LABEL_STATS_CHANNELS), (unsigned)p,
+                               (unsigned)r->timing.minUs[s][l], (unsigned)(r->timing.sumUs[s][l] / p),
+                               (unsigned)r->timing.maxUs[s][l]);
+                    }
+                }
+            }
+            break;
+        }
+        case MODE_FRAME:
+            printf("frame: ok %u, bad_chk %u, bad_len %u, mismatch %u\n",
+                   (unsigned)r->parser.frames_ok, (unsigned)r->parser.frames_bad_chk,
+                   (unsigned)r->parser.frames_bad_len, (unsigned)r->frameMismatch);
+            break;
+        case MODE_PLAUS:
+            printf("plaus: ok %u, bad_parity %u, bad_plaus %u\n",
+                   (unsigned)r->plausOk, (unsigned)r->plausBadParity, (unsigned)r->plausBadPlaus);
+            break;
+    }
+    return 0;
+}
+
+static void gen_sink(const uint8_t *block, size_t len, void *user)
+{
+    (void)fwrite(block, 1, len, (FILE *)user);
+}
+
+/* Synthetic bus: labels 0x01..0x10 at 20..95 ms periods, two channels,
+   1 in 50 words with bad parity. */
+static int cmd_gen(const char *path, uint32_t words)
+{
+    FILE *f = fopen(path, "wb");
+    capture_writer_t w;
+    uint32_t nextUs[16];
+    uint32_t seed = 1U;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+    Capture_WriterInit(&w, gen_sink, f);
+    for (uint32_t l = 0U; l < 16U; l++)
+    {
+        nextUs[l] = l * 1000U;
+    }
+
+    for (uint32_t i = 0U; i < words; i++)
+    {
+        uint32_t l = 0U;
+        for (uint32_t k = 1U; k < 16U; k++)
+        {
+            if ((int32_t)(nextUs[k] - nextUs[l]) < 0)
+            {
+                l = k;
+            }
+        }
+        uint32_t ts = nextUs[l];
+        nextUs[l] += 20000U + (l * 5000U);
+
+        seed = (seed * 1664525UL) + 1013904223UL;
+        uint32_t word = (l + 1U) | (seed & 0x7FFFFF00UL);
+        word = A429_SetParity(word, A429_ParityBitFor(word));
+        if ((seed >> 24) % 50U == 0U)
+        {
+            word ^= A429_MASK(PARITY);
+        }
+        Capture_Record(&w, (uint8_t)(1U + (l & 1U)), word, ts);
+    }
+    Capture_Flush(&w);
+    fclose(f);
+    printf("wrote %u words in %u blocks to %s\n", (unsigned)w.words, (unsigned)w.blocks, path);
+    return 0;
+}
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: a429_replay index|text|frame|plaus <capture> [--speed X] [--from-us T] [--allow L,..] [--interval MS]\n"
+                    "       a429_replay gen <capture> <words>\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    static replay_t r;
+    uint8_t *buf;
+    size_t len = 0U;
+    uint32_t interval = 20U;
+    const char *allow = NULL;
+    int rc;
+
+    if (argc < 3)
+    {
+        return usage();
+    }
+    if (strcmp(argv[1], "gen") == 0)
+    {
+        return (argc == 4) ? cmd_gen(argv[2], (uint32_t)strtoul(argv[3], NULL, 0)) : usage();
+    }
+
+    if (strcmp(argv[1], "text") == 0)       r.mode = MODE_TEXT;
+    else if (strcmp(argv[1], "frame") == 0) r.mode = MODE_FRAME;
+    else if (strcmp(argv[1], "plaus") == 0) r.mode = MODE_PLAUS;
+    else if (strcmp(argv[1], "index") != 0) return usage();
+
+    for (int i = 3; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--speed") == 0) && (i + 1 < argc))         r.speed = strtod(argv[++i], NULL);
+        else if ((strcmp(argv[i], "--from-us") == 0) && (i + 1 < argc))  r.fromUs = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "--allow") == 0) && (i + 1 < argc))    allow = argv[++i];
+        else if ((strcmp(argv[i], "--interval") == 0) && (i + 1 < argc)) interval = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else return usage();
+    }
+
+    buf = load_file(argv[2], &len);
+    if (buf == NULL)
+    {
+        return 1;
+    }
+
+    if (strcmp(argv[1], "index") == 0)
+    {
+        rc = cmd_index(buf, len);
+        free(buf);
+        return rc;
+    }
+
+    LabelStats_Clear(&r.stats);
+    LabelTiming_Clear(&r.timing);
+    A429_ParserInit(&r.parser);
+    A429Plaus_Init(&r.plaus, interval);
+    if (allow == NULL)
+    {
+        for (uint32_t l = 0U; l < 256U; l++)
+        {
+            A429Plaus_Allow(&r.plaus, (uint8_t)l);
+        }
+    }
+    else
+    {
+        for (const char *p = allow; *p != '\0';)
+        {
+            char *end;
+            unsigned long l = strtoul(p, &end, 16);
+            if ((end == p) || (l > 0xFFUL) || ((*end != ',') && (*end != '\0')))
+            {
+                free(buf);
+                return usage();
+            }
+            A429Plaus_Allow(&r.plaus, (uint8_t)l);
+            p = (*end == ',') ? (end + 1) : end;
+        }
+    }
+
+    rc = cmd_replay(&r, buf, len);
+    free(buf);
+    return rc;
+}
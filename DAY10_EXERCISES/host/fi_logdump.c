@@ -0,0 +1,307 @@
+/*
+ * Host-side decoder for the binary FI log drain (common/fi_logstream.h):
+ * a raw capture of the lab console, text and FIL1 blocks interleaved.
+ *
+ * Build (from DAY10_EXERCISES/host):
+ *   gcc -O2 -std=c11 -D_POSIX_C_SOURCE=200809L -I../common \
+ *       fi_logdump.c ../common/fi_logstream.c ../common/crc32.c ../common/fi_core.c \
+ *       -o fi_logdump
+ *
+ * Usage:
+ *   fi_logdump text <capture> [options]   one line per record, capture order
+ *   fi_logdump csv  <capture> [options]   ts_ms,ctx,site,hit,extra,data
+ *   fi_logdump stat <capture> [options]   per-site counts, seq gaps, drops
+ *   fi_logdump gen  <capture> <ms>        write a synthetic capture (fi_core
+ *                                         sites driven for <ms>, drained in
+ *                                         random slices between text lines)
+ * Options:
+ *   --sites N,N,..  site names by id, e.g. rx,label,parity,txbusy,txstall
+ *                   for the SFI lab (default: numbers)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fi_core.h"
+#include "fi_logstream.h"
+
+typedef enum
+{
+    MODE_TEXT,
+    MODE_CSV,
+    MODE_STAT,
+} dump_mode_t;
+
+#define MAX_NAMES 32U
+
+typedef struct
+{
+    dump_mode_t mode;
+    char       *names[MAX_NAMES];
+
+    uint32_t blocks;
+    uint32_t records;
+    uint32_t seqGaps;     /* blocks missing between consecutive seq */
+    uint32_t skipped;     /* bytes outside valid blocks (text, damage) */
+    uint32_t lastDrops;
+    uint32_t perSite[MAX_NAMES];
+    uint32_t firstTs;
+    uint32_t lastTs;
+    bool     haveSeq;
+    uint16_t nextSeq;
+} dump_t;
+
+static uint8_t *load_file(const char *path, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+    long n;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((n > 0) ? (size_t)n : 1U);
+    if ((buf == NULL) || (fread(buf, 1, (size_t)n, f) != (size_t)n))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        fclose(f);
+        free(buf);
+        return NULL;
+    }
+    fclose(f);
+    *len = (size_t)n;
+    return buf;
+}
+
+static const char *site_name(const dump_t *d, uint8_t site, char tmp[8])
+{
+    if ((site < MAX_NAMES) && (d->names[site] != NULL))
+    {
+        return d->names[site];
+    }
+    snprintf(tmp, 8, "%u", (unsigned)site);
+    return tmp;
+}
+
+static void dump_record(dump_t *d, const fi_core_event_t *e)
+{
+    char tmp[8];
+
+    if (d->records == 0U)
+    {
+        d->firstTs = e->tsMs;
+    }
+    d->lastTs = e->tsMs;
+    d->records++;
+    if (e->site < MAX_NAMES)
+    {
+        d->perSite[e->site]++;
+    }
+
+    switch (d->mode)
+    {
+        case MODE_TEXT:
+            printf("t=%-8u ctx=%u site=%-8s hit=%-8u extra=%-5u data=0x%08X\n",
+                   (unsigned)e->tsMs, (unsigned)e->ctx, site_name(d, e->site, tmp),
+                   (unsigned)e->hit, (unsigned)e->extra, (unsigned)e->data);
+            break;
+        case MODE_CSV:
+            printf("%u,%u,%s,%u,%u,%u\n", (unsigned)e->tsMs, (unsigned)e->ctx,
+                   site_name(d, e->site, tmp), (unsigned)e->hit, (unsigned)e->extra,
+                   (unsigned)e->data);
+            break;
+        case MODE_STAT:
+            break;
+    }
+}
+
+static int cmd_dump(dump_t *d, const uint8_t *buf, size_t len)
+{
+    size_t off = 0U;
+
+    if (d->mode == MODE_CSV)
+    {
+        printf("ts_ms,ctx,site,hit,extra,data\n");
+    }
+
+    while (off < len)
+    {
+        filog_block_t b;
+        int32_t n = FILog_ParseBlock(&buf[off], len - off, &b);
+        if (n <= 0)
+        {
+            d->skipped += (n < 0) ? 1U : (uint32_t)(len - off);
+            off += (n < 0) ? 1U : (len - off);
+            continue;
+        }
+
+        if (d->haveSeq && (b.seq != d->nextSeq))
+        {
+            d->seqGaps += (uint16_t)(b.seq - d->nextSeq);
+        }
+        d->haveSeq   = true;
+        d->nextSeq   = (uint16_t)(b.seq + 1U);
+        d->lastDrops = b.drops;
+        d->blocks++;
+
+        for (uint32_t i = 0U; i < b.count; i++)
+        {
+            fi_core_event_t e;
+            FILog_GetRecord(&b, i, &e);
+            dump_record(d, &e);
+        }
+        off += (size_t)n;
+    }
+
+    if (d->mode == MODE_STAT)
+    {
+        char tmp[8];
+
+        printf("blocks=%u records=%u span=%u..%u ms\n", (unsigned)d->blocks,
+               (unsigned)d->records, (unsigned)d->firstTs, (unsigned)d->lastTs);
+        for (uint32_t s = 0U; s < MAX_NAMES; s++)
+        {
+            if (d->perSite[s] != 0U)
+            {
+                printf("  site %-8s fires=%u\n", site_name(d, (uint8_t)s, tmp), (unsigned)d->perSite[s]);
+            }
+        }
+    }
+    fprintf(stderr, "%u blocks, %u records, %u blocks lost (seq), %u dropped on target, %u bytes skipped\n",
+            (unsigned)d->blocks, (unsigned)d->records, (unsigned)d->seqGaps,
+            (unsigned)d->lastDrops, (unsigned)d->skipped);
+    return 0;
+}
+
+/* --- gen: the target-side pieces on the host --- */
+
+static uint32_t s_genSeed = 1U;
+
+static uint32_t gen_rand(void)
+{
+    s_genSeed = (s_genSeed * 1103515245U) + 12345U;
+    return s_genSeed >> 16;
+}
+
+/* A UART that takes 0..8 bytes per poll */
+static size_t gen_write(void *user, const uint8_t *p, size_t n)
+{
+    size_t take = gen_rand() % 9U;
+
+    if (take > n)
+    {
+        take = n;
+    }
+    fwrite(p, 1, take, (FILE *)user);
+    return take;
+}
+
+static int cmd_gen(const char *path, uint32_t ms)
+{
+    FILE *f = fopen(path, "wb");
+    filog_drain_t drain;
+    const uint32_t every[3] = {37U, 0U, 0U};
+    const uint32_t prob[3]  = {2U, 0U, 0U};
+    const uint32_t burst[3] = {200U, 3U, 0U};
+    uint32_t fires = 0U;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+
+    FICore_Init(1U);
+    FICore_SetClock(NULL);
+    (void)FICore_ArmArgs(0U, FI_TRIG_EVERY_N, every);
+    (void)FICore_ArmArgs(1U, FI_TRIG_PROB, prob);
+    (void)FICore_ArmArgs(2U, FI_TRIG_BURST, burst);
+    FILog_DrainInit(&drain);
+
+    for (uint32_t t = 0U; t < ms; t++)
+    {
+        FICore_SetNowMs(t);
+        for (uint32_t site = 0U; site < 3U; site++)
+        {
+            if (FICore_ShouldFire(site))
+            {
+                FICore_LogDetail(site, t & 0xFFFFU, gen_rand());
+            }
+        }
+        (void)FILog_DrainPoll(&drain, gen_write, f);
+
+        /* Console text between blocks, as the lab's telemetry does */
+        if (((t % 1000U) == 0U) && !FILog_DrainBusy(&drain))
+        {
+            fprintf(f, "\r\n[%u ms] telemetry line\r\n", (unsigned)t);
+        }
+    }
+    while (FILog_DrainPoll(&drain, gen_write, f))
+    {
+    }
+    fclose(f);
+
+    for (uint32_t site = 0U; site < 3U; site++)
+    {
+        fires += FICore_Site(site)->fires;
+    }
+    fprintf(stderr, "%u fires, %u records in %u blocks, %u dropped\n", (unsigned)fires,
+            (unsigned)drain.records, (unsigned)drain.blocks, (unsigned)FICore_LogDrops());
+    return 0;
+}
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: fi_logdump text|csv|stat <capture> [--sites N,N,..]\n"
+                    "       fi_logdump gen <capture> <ms>\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    static dump_t d;
+    uint8_t *buf;
+    size_t len = 0U;
+    int rc;
+
+    if (argc < 3)
+    {
+        return usage();
+    }
+    if (strcmp(argv[1], "gen") == 0)
+    {
+        return (argc == 4) ? cmd_gen(argv[2], (uint32_t)strtoul(argv[3], NULL, 0)) : usage();
+    }
+
+    if (strcmp(argv[1], "text") == 0)      d.mode = MODE_TEXT;
+    else if (strcmp(argv[1], "csv") == 0)  d.mode = MODE_CSV;
+    else if (strcmp(argv[1], "stat") == 0) d.mode = MODE_STAT;
+    else return usage();
+
+    for (int i = 3; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--sites") == 0) && (i + 1 < argc))
+        {
+            uint32_t n = 0U;
+            for (char *tok = strtok(argv[++i], ","); (tok != NULL) && (n < MAX_NAMES); tok = strtok(NULL, ","))
+            {
+                d.names[n++] = tok;
+            }
+        }
+        else return usage();
+    }
+
+    buf = load_file(argv[2], &len);
+    if (buf == NULL)
+    {
+        return 1;
+    }
+    rc = cmd_dump(&d, buf, len);
+    free(buf);
+    return rc;
+}
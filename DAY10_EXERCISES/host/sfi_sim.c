@@ -0,0 +1,1070 @@
+/*
+ * Host-side Monte Carlo run of the SFI lab's link (sfi_link.c: parser,
+ * parity / plausibility barriers, ACK queue, TX retry and stall recovery,
+ * outcome tracking) on the same fi_core sites, against a simulated data
+ * UART instead of the EVKB + ADK-8582 loop. Each trial is one board run
+ * in simulated time; trials are spread over worker threads, each with its
+ * own fi_core state (FI_CORE_TLS), and the per-site coverage / escape
+ * statistics are summed over all trials of a sweep point.
+ *
+ * Build (from DAY10_EXERCISES/host):
+ *   S="../SOFTWARE_FAULT_INJECTION_ DATA_CORRUPTION_API_FAILURES"
+ *   gcc -O2 -std=c11 -D_POSIX_C_SOURCE=200809L -DSFI_ENABLED=1 \
+ *       -DFI_CORE_TLS=_Thread_local -I"$S" -I../common \
+ *       sfi_sim.c "$S/sfi_link.c" "$S/sfi_camp.c" "$S/fi.c" "$S/a429_frame.c" \
+ *       "$S/a429_plaus.c" ../common/fi_core.c ../common/fi_outcome.c \
+ *       ../common/fi_corrupt.c ../common/fi_campaign.c \
+ *       -pthread -lm -o sfi_sim
+ *
+ * Usage:
+ *   sfi_sim [options]
+ * Options:
+ *   --trials N        trials per sweep point (default 1000)
+ *   --threads N       worker threads (default: online CPUs)
+ *   --ms N            injection phase per trial in ms (default 5000); a
+ *                     disarmed settle phase follows so open injections close
+ *   --seed S          base seed (default 1); trial k of a point always gets
+ *                     the same seed, whatever the thread count
+ *   --site NAME       site the sweep arms (default rx)
+ *   --every N,N,..    sweep 'every N' on the site (default: its registered
+ *                     policy, unchanged)
+ *   --bits B,B,..     sweep bits to flip with --every (default 3)
+ *   --model "NAME V.."  what an rx fire does to the chunk instead of
+ *                     flipping bits: common/fi_corrupt.h model, 'fi model'
+ *                     syntax (ge, stuck, drop, ins, dup, slip)
+ *   --arm "SITE POLICY V.."   extra arming for every trial, FICore_ArmArgs
+ *                     syntax as in 'fi arm' (repeatable)
+ *   --only            start trials with all sites off instead of the
+ *                     registered defaults
+ *   --campaign FILE|STEPS   run a campaign script (common/fi_campaign.h)
+ *                     in every trial's injection phase through the
+ *                     board's adapter (sfi_camp.h); STEPS is inline text,
+ *                     'demo' the board's 'fi camp demo' script. The text
+ *                     report adds the summed pass/fail and the first
+ *                     failing trial; exit status 3 if any step failed
+ *   --period MS       peer frame period (default 5; labels 01..04 in turn)
+ *   --baud N          data UART rate (default 115200)
+ *   --csv             one line per sweep point and site
+ *   --record DIR      record every trial's FI decisions (fi_core record /
+ *                     replay) and keep those of trials with an escape as
+ *                     DIR/p<point>_t<trial>.fir (up to 4 per thread and point)
+ *   --replay FILE     run one trial with the decisions from FILE instead of
+ *                     the arming: same --seed/--ms/--period/--baud as the
+ *                     recording, point and trial from the file name or
+ *                     --point / --trial. Bit-exact, so a rare escape can be
+ *                     stepped through under a debugger (--threads ignored)
+ *   --dump FILE       list the fires of a recording
+ *   FILE may also be a console capture with the labs' 'rec load' lines.
+ *
+ * Time advances 1 ms per step: peer frames arrive at line rate and are
+ * handed to SfiLink_RxChunk in one to three chunks per step (DMA ring
+ * split), ACKs drain at line rate, and a stalled transfer makes no
+ * progress until the stall monitor aborts it.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "fi.h"
+#include "sfi_link.h"
+#include "sfi_camp.h"
+#include "a429_frame.h"
+#include "a429_word.h"
+
+#define SIM_SETTLE_MS   2100U   /* longest outcome timeout (rx, 2 s) + margin */
+#define SIM_MAX_SWEEP   32U
+#define SIM_MAX_ARMS    8U
+#define SIM_RX_MAX      4096U
+#define SIM_RR_MAX      65536U  /* decision recording per trial */
+#define SIM_SAVE_MAX    4U      /* recordings kept per thread and point */
+#define SIM_CAMP_MAX    4096U   /* --campaign script text */
+#define SIM_CAMP_FAILED 3       /* exit status: a campaign step failed */
+
+/* -------------------------------
+ * Simulated data UART
+ * ------------------------------- */
+typedef struct
+{
+    uint32_t rng;
+    uint32_t bytesPerMs;
+
+    /* Peer -> us: frames queued at the line, moved into rx each step */
+    uint8_t  line[SIM_RX_MAX];
+    uint32_t lineLen;
+    uint32_t nextFrameMs;
+    uint32_t period;
+    uint8_t  nextLabel;
+    uint8_t  rx[SIM_RX_MAX];
+
+    /* Us -> peer */
+    bool     txOnGoing;
+    bool     txStall;
+    uint32_t txLen;
+    uint32_t txSent;
+} sim_uart_t;
+
+static uint32_t sim_rand(sim_uart_t *u)
+{
+    u->rng ^= u->rng << 13;
+    u->rng ^= u->rng >> 17;
+    u->rng ^= u->rng << 5;
+    return u->rng;
+}
+
+/* The link has decided the TX injections; a stall freezes the transfer */
+static sfi_tx_status_t sim_tx_send(void *ctx, const uint8_t *data, size_t len, bool stall)
+{
+    sim_uart_t *u = (sim_uart_t *)ctx;
+
+    (void)data;
+    u->txStall = stall;
+    u->txOnGoing = true;
+    u->txLen = (uint32_t)len;
+    u->txSent = 0U;
+    return SFI_TX_STARTED;
+}
+
+static bool sim_tx_busy(void *ctx)
+{
+    return ((sim_uart_t *)ctx)->txOnGoing;
+}
+
+static bool sim_tx_send_count(void *ctx, uint32_t *count)
+{
+    *count = ((sim_uart_t *)ctx)->txSent;
+    return true;
+}
+
+static void sim_tx_abort(void *ctx)
+{
+    sim_uart_t *u = (sim_uart_t *)ctx;
+    u->txOnGoing = false;
+    u->txStall = false;
+}
+
+static void sim_put_frame(sim_uart_t *u, uint32_t w)
+{
+    uint8_t *f = &u->line[u->lineLen];
+
+    if ((u->lineLen + A429_FRAME_LEN) > SIM_RX_MAX)
+    {
+        return;   /* peer faster than the line: frame lost before the UART */
+    }
+    f[0] = A429_FRAME_SYNC;
+    f[1] = 4U;
+    f[2] = (uint8_t)w;
+    f[3] = (uint8_t)(w >> 8);
+    f[4] = (uint8_t)(w >> 16);
+    f[5] = (uint8_t)(w >> 24);
+    f[6] = (uint8_t)(f[1] + f[2] + f[3] + f[4] + f[5]);
+    u->lineLen += A429_FRAME_LEN;
+}
+
+/* One ms of line time in both directions; returns the bytes received. */
+static uint32_t sim_uart_step(sim_uart_t *u, uint32_t nowMs)
+{
+    uint32_t n;
+
+    if ((int32_t)(nowMs - u->nextFrameMs) >= 0)
+    {
+        u->nextFrameMs += u->period;
+        sim_put_frame(u, A429_Pack(u->nextLabel, sim_rand(u), sim_rand(u), sim_rand(u)));
+        u->nextLabel = (uint8_t)((u->nextLabel & 3U) + 1U);
+    }
+
+    n = (u->lineLen < u->bytesPerMs) ? u->lineLen : u->bytesPerMs;
+    memcpy(u->rx, u->line, n);
+    memmove(u->line, &u->line[n], u->lineLen - n);
+    u->lineLen -= n;
+
+    if (u->txOnGoing && !u->txStall)
+    {
+        u->txSent += u->bytesPerMs;
+        if (u->txSent >= u->txLen)
+        {
+            u->txOnGoing = false;
+        }
+    }
+    return n;
+}
+
+/* -------------------------------
+ * Configuration and statistics
+ * ------------------------------- */
+typedef struct
+{
+    uint32_t site;
+    int      policy;
+    uint32_t v[3];
+} sim_arm_t;
+
+typedef struct
+{
+    uint32_t  trials;
+    uint32_t  threads;
+    uint32_t  ms;
+    uint32_t  seed;
+    uint32_t  period;
+    uint32_t  baud;
+    bool      only;
+    bool      csv;
+
+    const char    *recordDir;
+    const char    *replayFile;
+    const uint8_t *rr;        /* replay stream */
+    uint32_t       rrLen;
+
+    const fi_site_desc_t *site;
+    uint32_t  every[SIM_MAX_SWEEP];
+    uint32_t  nEvery;
+    uint32_t  bits[SIM_MAX_SWEEP];
+    uint32_t  nBits;
+    sim_arm_t arm[SIM_MAX_ARMS];
+    uint32_t  nArm;
+    ficm_t    rxModel;
+    const char *campaign;     /* script text, NULL: none */
+} sim_cfg_t;
+
+typedef struct
+{
+    uint64_t fired;
+    uint64_t untracked;
+    uint64_t outcome[FIO_OUTCOME_COUNT];
+    uint64_t byBarrier[FIO_MAX_BARRIERS];
+    uint64_t latMsSum;
+    uint64_t latBytesSum;
+    uint32_t latMsMax;
+    uint32_t latBytesMax;
+} sim_site_acc_t;
+
+/* Link counters summed over trials */
+static const struct
+{
+    const char *name;
+    size_t      off;
+} s_ctr[] = {
+    {"rx_ok", offsetof(sfi_link_t, rx_ok)},
+    {"bad_chk", offsetof(sfi_link_t, rx_bad_chk)},
+    {"bad_parity", offsetof(sfi_link_t, rx_bad_parity)},
+    {"bad_plaus", offsetof(sfi_link_t, rx_bad_plaus)},
+    {"bad_len", offsetof(sfi_link_t, rx_bad_len)},
+    {"tx_retry", offsetof(sfi_link_t, tx_retries)},
+    {"tx_fail", offsetof(sfi_link_t, tx_failures)},
+    {"tx_recov", offsetof(sfi_link_t, tx_recoveries)},
+    {"tx_drop", offsetof(sfi_link_t, tx_drops)},
+};
+#define SIM_CTR_COUNT (sizeof(s_ctr) / sizeof(s_ctr[0]))
+
+typedef struct
+{
+    uint64_t       trials;
+    uint64_t       escTrials;   /* trials with at least one escape */
+    uint64_t       open;        /* still open after the settle phase */
+    uint64_t       falseAlarms[FIO_MAX_BARRIERS];
+    uint64_t       ctr[SIM_CTR_COUNT];
+    sim_site_acc_t site[FI_SITE_COUNT];
+
+    /* --campaign */
+    uint64_t       campIter;
+    uint64_t       campPass;
+    uint64_t       campFail;
+    uint64_t       campFailTrials;
+    uint32_t       campFirstTrial;   /* UINT32_MAX: no failure */
+    fic_result_t   campFirstFail;
+} sim_acc_t;
+
+typedef struct
+{
+    const sim_cfg_t *cfg;
+    uint32_t         every;   /* 0: registered policy */
+    uint32_t         bits;
+    uint32_t         point;
+    uint32_t         first;   /* trials first, first + step, ... */
+    uint32_t         step;
+    sim_acc_t        acc;
+
+    uint8_t          *rrBuf;   /* --record */
+    uint32_t          saved;
+    fi_core_rr_stat_t rrStat;  /* --replay */
+} sim_worker_t;
+
+static void acc_site(sim_site_acc_t *a, const fio_site_stats_t *s)
+{
+    a->fired += s->fired;
+    a->untracked += s->untracked;
+    for (uint32_t k = 0U; k < FIO_OUTCOME_COUNT; k++)
+    {
+        a->outcome[k] += s->outcome[k];
+    }
+    for (uint32_t b = 0U; b < FIO_MAX_BARRIERS; b++)
+    {
+        a->byBarrier[b] += s->byBarrier[b];
+    }
+    a->latMsSum += s->latMsSum;
+    a->latBytesSum += s->latBytesSum;
+    if (s->latMsMax > a->latMsMax) a->latMsMax = s->latMsMax;
+    if (s->latBytesMax > a->latBytesMax) a->latBytesMax = s->latBytesMax;
+}
+
+static void acc_add(sim_site_acc_t *t, const sim_site_acc_t *f)
+{
+    t->fired += f->fired;
+    t->untracked += f->untracked;
+    for (uint32_t k = 0U; k < FIO_OUTCOME_COUNT; k++)
+    {
+        t->outcome[k] += f->outcome[k];
+    }
+    for (uint32_t b = 0U; b < FIO_MAX_BARRIERS; b++)
+    {
+        t->byBarrier[b] += f->byBarrier[b];
+    }
+    t->latMsSum += f->latMsSum;
+    t->latBytesSum += f->latBytesSum;
+    if (f->latMsMax > t->latMsMax) t->latMsMax = f->latMsMax;
+    if (f->latBytesMax > t->latBytesMax) t->latBytesMax = f->latBytesMax;
+}
+
+static void acc_merge(sim_acc_t *to, const sim_acc_t *from)
+{
+    to->trials += from->trials;
+    to->escTrials += from->escTrials;
+    to->open += from->open;
+    for (uint32_t b = 0U; b < FIO_MAX_BARRIERS; b++)
+    {
+        to->falseAlarms[b] += from->falseAlarms[b];
+    }
+    for (uint32_t c = 0U; c < SIM_CTR_COUNT; c++)
+    {
+        to->ctr[c] += from->ctr[c];
+    }
+    for (uint32_t s = 0U; s < FI_SITE_COUNT; s++)
+    {
+        acc_add(&to->site[s], &from->site[s]);
+    }
+    to->campIter += from->campIter;
+    to->campPass += from->campPass;
+    to->campFail += from->campFail;
+    to->campFailTrials += from->campFailTrials;
+    if (from->campFirstTrial < to->campFirstTrial)
+    {
+        to->campFirstTrial = from->campFirstTrial;
+        to->campFirstFail = from->campFirstFail;
+    }
+}
+
+/* splitmix64: independent seeds from (base, point, trial) */
+static uint64_t seed_mix(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/* -------------------------------
+ * Decision recordings
+ * ------------------------------- */
+static void save_recording(sim_worker_t *w, uint32_t trial, uint32_t len, const fio_site_stats_t *total)
+{
+    char path[512];
+    FILE *f;
+
+    (void)snprintf(path, sizeof(path), "%s/p%u_t%u.fir", w->cfg->recordDir, (unsigned)w->point, (unsigned)trial);
+    f = fopen(path, "wb");
+    if ((f == NULL) || (fwrite(w->rrBuf, 1, len, f) != len))
+    {
+        perror(path);
+    }
+    else
+    {
+        fprintf(stderr, "saved %s: %u bytes, det %u esc %u mask %u\n", path, (unsigned)len,
+                (unsigned)total->outcome[FIO_DETECTED], (unsigned)total->outcome[FIO_ESCAPED],
+                (unsigned)total->outcome[FIO_MASKED]);
+        w->saved++;
+    }
+    if (f != NULL) fclose(f);
+}
+
+static uint8_t *load_file(const char *path, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+    long n;
+
+    if (f == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((n > 0) ? (size_t)n + 1U : 1U);
+    if ((buf == NULL) || (fread(buf, 1, (size_t)n, f) != (size_t)n))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        fclose(f);
+        free(buf);
+        return NULL;
+    }
+    fclose(f);
+    buf[n] = 0U;
+    *len = (size_t)n;
+    return buf;
+}
+
+/* A binary stream, or the 'rec load OFF HEX' lines of a console capture */
+static uint8_t *load_recording(const char *path, uint32_t *len)
+{
+    size_t n;
+    uint8_t *raw = load_file(path, &n);
+    uint8_t *out;
+    uint32_t outLen = 0U;
+
+    if (raw == NULL) return NULL;
+    if ((n >= 4U) && (memcmp(raw, "FIR1", 4U) == 0))
+    {
+        *len = (uint32_t)n;
+        return raw;
+    }
+
+    out = calloc(SIM_RR_MAX, 1U);
+    for (char *p = strstr((char *)raw, "rec load "); (out != NULL) && (p != NULL); p = strstr(p, "rec load "))
+    {
+        char *hex;
+        uint32_t off = (uint32_t)strtoul(p + 9, &hex, 0);
+        uint32_t i = 0U;
+
+        while (*hex == ' ') hex++;
+        for (; (hex[2U * i] != '\0') && (hex[(2U * i) + 1U] != '\0') && ((off + i) < SIM_RR_MAX); i++)
+        {
+            char pair[3] = {hex[2U * i], hex[(2U * i) + 1U], '\0'};
+            char *end;
+            unsigned long b = strtoul(pair, &end, 16);
+            if (*end != '\0') break;
+            out[off + i] = (uint8_t)b;
+        }
+        if ((off + i) > outLen) outLen = off + i;
+        p = hex + (2U * i);
+    }
+    free(raw);
+    if ((out == NULL) || (outLen == 0U))
+    {
+        fprintf(stderr, "%s: no decision recording\n", path);
+        free(out);
+        return NULL;
+    }
+    *len = outLen;
+    return out;
+}
+
+static int cmd_dump(const char *path)
+{
+    uint32_t len;
+    uint8_t *buf = load_recording(path, &len);
+    fi_core_rr_iter_t it;
+    fi_core_rr_fire_t f;
+    uint32_t rng0;
+    uint32_t totals[FI_CORE_SITES];
+    uint32_t n = 0U;
+
+    if (buf == NULL) return 1;
+    if (!FICore_RRIterInit(&it, buf, len, &rng0))
+    {
+        fprintf(stderr, "%s: not a decision recording\n", path);
+        free(buf);
+        return 1;
+    }
+    printf("%s: %u bytes, rng 0x%08X\n", path, (unsigned)len, (unsigned)rng0);
+    while (FICore_RRIterNext(&it, &f))
+    {
+        printf("  %-8s call %10u  rng 0x%08X\n", (f.site < FI_SITE_COUNT) ? FI_SiteName((fi_site_t)f.site) : "?",
+               (unsigned)f.call, (unsigned)f.rng);
+        n++;
+    }
+    if (!FICore_RRIterTotals(&it, totals))
+    {
+        fprintf(stderr, "%s: malformed after %u fires\n", path, (unsigned)n);
+        free(buf);
+        return 1;
+    }
+    printf("%u fires; calls:", (unsigned)n);
+    for (uint32_t s = 0U; s < FI_CORE_SITES; s++)
+    {
+        if (totals[s] != 0U) printf(" %s=%u", (s < FI_SITE_COUNT) ? FI_SiteName((fi_site_t)s) : "?", (unsigned)totals[s]);
+    }
+    printf("\n");
+    free(buf);
+    return 0;
+}
+
+/* -------------------------------
+ * One trial
+ * ------------------------------- */
+static void run_trial(sim_worker_t *w, uint32_t trial)
+{
+    const sim_cfg_t *c = w->cfg;
+    const uint64_t seed = seed_mix(((uint64_t)c->seed << 32) ^ ((uint64_t)w->point << 24) ^ trial);
+    sim_uart_t u;
+    sfi_link_t link;
+    const sfi_tx_ops_t ops = {&u, sim_tx_send, sim_tx_busy, sim_tx_send_count, sim_tx_abort};
+    fio_site_stats_t total;
+    volatile uint32_t nowMs = 0U;
+    sfi_camp_t campAdapter;
+    fic_campaign_t camp;
+
+    memset(&u, 0, sizeof(u));
+    u.rng = (uint32_t)(seed >> 32) | 1U;
+    u.bytesPerMs = (c->baud + 9999U) / 10000U;   /* 10 bits per byte */
+    u.period = c->period;
+    u.nextLabel = 1U;
+    u.nextFrameMs = 20U;   /* plausibility: first repeat interval from 0 */
+
+    FI_Init((uint32_t)seed);
+    if (c->only) FICore_DisarmAll();
+    if (w->every != 0U)
+    {
+        const uint32_t v[3] = {w->every, w->bits, 0U};
+        (void)FICore_ArmArgs(c->site->id, FICore_ArmPolicyId("every"), v);
+    }
+    for (uint32_t i = 0U; i < c->nArm; i++)
+    {
+        (void)FICore_ArmArgs(c->arm[i].site, c->arm[i].policy, c->arm[i].v);
+    }
+    SfiLink_Init(&link, &ops, NULL, NULL, 20U);
+    link.rxModel = c->rxModel;
+    SfiCamp_Init(&campAdapter, &camp, &link, &nowMs, NULL, NULL);
+    if (c->campaign != NULL) (void)FICampaign_Compile(&camp, c->campaign, NULL);   /* checked in main */
+    if (w->rrBuf != NULL) (void)FICore_RecordStart(w->rrBuf, SIM_RR_MAX);
+    if ((c->rr != NULL) && !FICore_ReplayStart(c->rr, c->rrLen))
+    {
+        fprintf(stderr, "%s: not a decision recording\n", c->replayFile);
+        exit(1);
+    }
+
+    for (uint32_t ms = 1U; ms <= (c->ms + SIM_SETTLE_MS); ms++)
+    {
+        uint32_t n;
+
+        if (ms == (c->ms + 1U))
+        {
+            FICampaign_Stop(&camp);
+            FICore_DisarmAll();
+        }
+        FICore_SetNowMs(ms);
+        nowMs = ms;
+        if ((ms == 1U) && (c->campaign != NULL)) SfiCamp_Start(&campAdapter, &camp);
+        (void)FICampaign_Poll(&camp);
+
+        n = sim_uart_step(&u, ms);
+        for (uint32_t pos = 0U; pos < n;)
+        {
+            /* One to three chunks per step, as the DMA ring splits them */
+            uint32_t take = n - pos;
+            if (take > 1U && (sim_rand(&u) & 1U)) take = 1U + (sim_rand(&u) % take);
+            SfiLink_RxChunk(&link, &u.rx[pos], take, ms);
+            pos += take;
+        }
+        SfiLink_TxPoll(&link, ms);
+
+        /* The fi_core log is not read here; keep it from filling */
+        if (FICore_LogPending() > (FI_CORE_LOG_DEPTH / 2U))
+        {
+            fi_core_event_t e;
+            while (FICore_LogRead(&e)) {}
+        }
+    }
+
+    w->acc.trials++;
+    w->acc.open += FIOutcome_Total(&link.cov, &total);
+    w->acc.campIter += camp.iterations;
+    w->acc.campPass += camp.passed;
+    w->acc.campFail += camp.failed;
+    if (camp.failed != 0U)
+    {
+        w->acc.campFailTrials++;
+        if (trial < w->acc.campFirstTrial)
+        {
+            w->acc.campFirstTrial = trial;
+            w->acc.campFirstFail = camp.firstFail;
+        }
+    }
+    if (total.outcome[FIO_ESCAPED] != 0U) w->acc.escTrials++;
+
+    if (c->rr != NULL)
+    {
+        FICore_RRStat(&w->rrStat);
+        FICore_ReplayStop();
+    }
+    if (w->rrBuf != NULL)
+    {
+        const uint32_t len = FICore_RecordStop();
+        if ((total.outcome[FIO_ESCAPED] != 0U) && (w->saved < SIM_SAVE_MAX))
+        {
+            save_recording(w, trial, len, &total);
+        }
+    }
+    for (uint32_t b = 0U; b < FIO_MAX_BARRIERS; b++)
+    {
+        w->acc.falseAlarms[b] += link.cov.falseAlarms[b];
+    }
+    for (uint32_t k = 0U; k < SIM_CTR_COUNT; k++)
+    {
+        w->acc.ctr[k] += *(const uint32_t *)((const uint8_t *)&link + s_ctr[k].off);
+    }
+    for (uint32_t s = 0U; s < FI_SITE_COUNT; s++)
+    {
+        acc_site(&w->acc.site[s], &link.cov.site[s]);
+    }
+}
+
+static void *worker_main(void *arg)
+{
+    sim_worker_t *w = (sim_worker_t *)arg;
+
+    for (uint32_t t = w->first; t < w->cfg->trials; t += w->step)
+    {
+        run_trial(w, t);
+    }
+    return NULL;
+}
+
+/* -------------------------------
+ * Report
+ * ------------------------------- */
+static double rate(uint64_t num, uint64_t den)
+{
+    return (den != 0U) ? (100.0 * (double)num / (double)den) : -1.0;
+}
+
+/* 95 % half-width of a proportion, in % */
+static double ci95(uint64_t num, uint64_t den)
+{
+    if (den == 0U) return 0.0;
+    const double p = (double)num / (double)den;
+    return 100.0 * 1.96 * sqrt(p * (1.0 - p) / (double)den);
+}
+
+static void print_row(const char *name, const sim_site_acc_t *s)
+{
+    const uint64_t det = s->outcome[FIO_DETECTED];
+    const uint64_t esc = s->outcome[FIO_ESCAPED];
+    const uint64_t mask = s->outcome[FIO_MASKED];
+
+    printf("  %-8s %10llu %10llu %9llu %9llu", name, (unsigned long long)s->fired,
+           (unsigned long long)det, (unsigned long long)esc, (unsigned long long)mask);
+    if ((det + esc) != 0U) printf("  %6.2f+-%-5.2f", rate(det, det + esc), ci95(det, det + esc));
+    else printf("  %14s", "-");
+    if ((det + esc + mask) != 0U) printf(" %6.2f", rate(esc, det + esc + mask));
+    else printf(" %6s", "-");
+    printf("  %7.1f/%-5u %7.1f/%-5u", det ? ((double)s->latMsSum / (double)det) : 0.0, s->latMsMax,
+           det ? ((double)s->latBytesSum / (double)det) : 0.0, s->latBytesMax);
+    for (uint32_t b = 0U; b < COV_B_COUNT; b++)
+    {
+        if (s->byBarrier[b] != 0U) printf(" %s=%llu", SfiLink_BarrierName(b), (unsigned long long)s->byBarrier[b]);
+    }
+    if (s->untracked != 0U) printf(" untracked=%llu", (unsigned long long)s->untracked);
+    printf("\n");
+}
+
+static void site_total(const sim_acc_t *a, sim_site_acc_t *t)
+{
+    memset(t, 0, sizeof(*t));
+    for (uint32_t s = 0U; s < FI_SITE_COUNT; s++)
+    {
+        acc_add(t, &a->site[s]);
+    }
+}
+
+static void print_point(const sim_cfg_t *c, const sim_worker_t *w, const sim_acc_t *a, double secs)
+{
+    sim_site_acc_t total;
+
+    site_total(a, &total);
+    if (c->rr != NULL)
+    {
+        printf("\nreplay of %s (point %u, trial %u):", c->replayFile, (unsigned)w->point, (unsigned)w->first);
+    }
+    else if (w->every != 0U)
+    {
+        printf("\n%s every %u bits %u:", c->site->name, (unsigned)w->every, (unsigned)w->bits);
+    }
+    else
+    {
+        printf("\nregistered policies:");
+    }
+    printf(" %llu trials x %u ms in %.2f s, %.2f %% of trials with an escape, %llu open\n",
+           (unsigned long long)a->trials, (unsigned)c->ms, secs, rate(a->escTrials, a->trials),
+           (unsigned long long)a->open);
+    printf("  %-8s %10s %10s %9s %9s  %-14s %6s  %-13s %-13s %s\n", "site", "fired", "det", "esc", "mask",
+           "cov% (95%)", "esc%", "lat ms a/m", "lat B a/m", "caught by");
+    for (uint32_t s = 0U; s < FI_SITE_COUNT; s++)
+    {
+        if (a->site[s].fired != 0U) print_row(FI_SiteName((fi_site_t)s), &a->site[s]);
+    }
+    print_row("total", &total);
+
+    printf("  unattributed detections:");
+    for (uint32_t b = 0U; b < COV_B_COUNT; b++)
+    {
+        printf(" %s=%llu", SfiLink_BarrierName(b), (unsigned long long)a->falseAlarms[b]);
+    }
+    printf("\n  link:");
+    for (uint32_t k = 0U; k < SIM_CTR_COUNT; k++)
+    {
+        printf(" %s=%llu", s_ctr[k].name, (unsigned long long)a->ctr[k]);
+    }
+    printf("\n");
+    if (c->campaign != NULL)
+    {
+        printf("  campaign: %llu iterations, %llu pass, %llu fail, %llu trials failed\n",
+               (unsigned long long)a->campIter, (unsigned long long)a->campPass,
+               (unsigned long long)a->campFail, (unsigned long long)a->campFailTrials);
+        if (a->campFail != 0U)
+        {
+            printf("  first fail: trial %u it=%u step=%u %s delta=%u (+%u ms)\n", (unsigned)a->campFirstTrial,
+                   (unsigned)a->campFirstFail.iteration, (unsigned)a->campFirstFail.step,
+                   FICampaign_OpName(a->campFirstFail.op), (unsigned)a->campFirstFail.delta,
+                   (unsigned)a->campFirstFail.tMs);
+        }
+    }
+}
+
+static void print_csv_point(const sim_cfg_t *c, const sim_worker_t *w, const sim_acc_t *a)
+{
+    sim_site_acc_t total;
+
+    site_total(a, &total);
+    for (uint32_t s = 0U; s <= FI_SITE_COUNT; s++)
+    {
+        const sim_site_acc_t *p = (s < FI_SITE_COUNT) ? &a->site[s] : &total;
+        const uint64_t det = p->outcome[FIO_DETECTED];
+        const uint64_t esc = p->outcome[FIO_ESCAPED];
+
+        if (p->fired == 0U) continue;
+        printf("%s,%u,%u,%llu,%s,%llu,%llu,%llu,%llu,%.4f,%.4f,%.2f,%u\n", c->site->name,
+               (unsigned)w->every, (unsigned)w->bits, (unsigned long long)a->trials,
+               (s < FI_SITE_COUNT) ? FI_SiteName((fi_site_t)s) : "total", (unsigned long long)p->fired,
+               (unsigned long long)det, (unsigned long long)esc,
+               (unsigned long long)p->outcome[FIO_MASKED], rate(det, det + esc),
+               rate(esc, det + esc + p->outcome[FIO_MASKED]),
+               det ? ((double)p->latMsSum / (double)det) : 0.0, p->latMsMax);
+    }
+}
+
+/* -------------------------------
+ * Sweep
+ * ------------------------------- */
+static int run_point(const sim_cfg_t *c, uint32_t point, uint32_t every, uint32_t bits)
+{
+    sim_worker_t *w = calloc(c->threads, sizeof(*w));
+    pthread_t *tid = calloc(c->threads, sizeof(*tid));
+    sim_acc_t acc;
+    struct timespec t0, t1;
+
+    if ((w == NULL) || (tid == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        free(w);
+        free(tid);
+        return 1;
+    }
+    memset(&acc, 0, sizeof(acc));
+    acc.campFirstTrial = UINT32_MAX;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0U; i < c->threads; i++)
+    {
+        w[i].acc.campFirstTrial = UINT32_MAX;
+        w[i].rrBuf = (c->recordDir != NULL) ? malloc(SIM_RR_MAX) : NULL;
+        w[i].cfg = c;
+        w[i].every = every;
+        w[i].bits = bits;
+        w[i].point = point;
+        w[i].first = i;
+        w[i].step = c->threads;
+        if (pthread_create(&tid[i], NULL, worker_main, &w[i]) != 0)
+        {
+            fprintf(stderr, "pthread_create failed\n");
+            exit(1);
+        }
+    }
+    for (uint32_t i = 0U; i < c->threads; i++)
+    {
+        (void)pthread_join(tid[i], NULL);
+        acc_merge(&acc, &w[i].acc);
+        free(w[i].rrBuf);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    if (c->csv) print_csv_point(c, &w[0], &acc);
+    else print_point(c, &w[0], &acc, (double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) * 1e-9));
+    fflush(stdout);
+
+    free(w);
+    free(tid);
+    return (acc.campFail != 0U) ? SIM_CAMP_FAILED : 0;
+}
+
+/* One trial with the decisions from c->replayFile */
+static int run_replay(sim_cfg_t *c, uint32_t point, uint32_t trial)
+{
+    const char *base = strrchr(c->replayFile, '/');
+    unsigned p, t;
+    sim_worker_t w;
+    uint32_t len;
+    uint8_t *buf;
+
+    base = (base != NULL) ? (base + 1) : c->replayFile;
+    if (sscanf(base, "p%u_t%u", &p, &t) == 2)
+    {
+        if (point == UINT32_MAX) point = p;
+        if (trial == UINT32_MAX) trial = t;
+    }
+    if ((point == UINT32_MAX) || (trial == UINT32_MAX))
+    {
+        fprintf(stderr, "%s: give --point and --trial\n", c->replayFile);
+        return 2;
+    }
+    buf = load_recording(c->replayFile, &len);
+    if (buf == NULL) return 1;
+    c->rr = buf;
+    c->rrLen = len;
+
+    memset(&w, 0, sizeof(w));
+    w.acc.campFirstTrial = UINT32_MAX;
+    w.cfg = c;
+    w.point = point;
+    w.first = trial;
+    w.step = 1U;
+    run_trial(&w, trial);
+    print_point(c, &w, &w.acc, 0.0);
+    printf("  replayed %u fires, %u pending, diverged sites 0x%08X\n", (unsigned)w.rrStat.fires,
+           (unsigned)w.rrStat.pending, (unsigned)w.rrStat.diverged);
+
+    free(buf);
+    if ((w.rrStat.pending != 0U) || (w.rrStat.diverged != 0U)) return 1;
+    return (w.acc.campFail != 0U) ? SIM_CAMP_FAILED : 0;
+}
+
+static uint32_t parse_list(const char *s, uint32_t *out, uint32_t max)
+{
+    uint32_t n = 0U;
+    char *end;
+
+    while ((*s != '\0') && (n < max))
+    {
+        out[n++] = (uint32_t)strtoul(s, &end, 0);
+        if (*end != ',') break;
+        s = end + 1;
+    }
+    return n;
+}
+
+static bool parse_model(const char *spec, ficm_t *m)
+{
+    char buf[96];
+    char *name;
+    uint32_t v[FICM_ARGS] = {0U, 0U, 0U, 0U};
+    uint32_t nv = 0U;
+
+    strncpy(buf, spec, sizeof(buf) - 1U);
+    buf[sizeof(buf) - 1U] = '\0';
+    name = strtok(buf, " ");
+    if (name == NULL) return false;
+    for (char *t = strtok(NULL, " "); (t != NULL) && (nv < FICM_ARGS); t = strtok(NULL, " "))
+    {
+        v[nv++] = (uint32_t)strtoul(t, NULL, 0);
+    }
+    return FICorrupt_Set(m, FICorrupt_ModelId(name), v);
+}
+
+static bool parse_arm(const char *spec, sim_arm_t *a)
+{
+    char buf[96];
+    char *tok[6];
+    uint32_t n = 0U;
+    uint32_t nv = 0U;
+    const fi_site_desc_t *d;
+
+    strncpy(buf, spec, sizeof(buf) - 1U);
+    buf[sizeof(buf) - 1U] = '\0';
+    for (char *t = strtok(buf, " "); (t != NULL) && (n < 6U); t = strtok(NULL, " "))
+    {
+        tok[n++] = t;
+    }
+    if (n < 2U) return false;
+
+    d = FI_SiteByName(tok[0]);
+    a->policy = FICore_ArmPolicyId(tok[1]);
+    if ((d == NULL) || (d->id >= FI_SITE_COUNT) || (a->policy < 0)) return false;
+    a->site = d->id;
+    memset(a->v, 0, sizeof(a->v));
+    for (uint32_t i = 2U; (i < n) && (nv < 3U); i++)
+    {
+        if (strcmp(tok[i], "bits") == 0) continue;
+        a->v[nv++] = (uint32_t)strtoul(tok[i], NULL, 0);
+    }
+    return true;
+}
+
+/* --campaign: a script file, 'demo', or the steps themselves. The text is
+ * compiled here once so a bad script fails before any trial runs. */
+static const char *load_campaign(const char *arg)
+{
+    static char text[SIM_CAMP_MAX];
+    static sfi_link_t link;
+    sfi_camp_t a;
+    fic_campaign_t camp;
+    uint32_t errLine = 0U;
+    const volatile uint32_t now = 0U;
+    const char *script = arg;
+    FILE *f;
+
+    if (strcmp(arg, "demo") == 0)
+    {
+        script = SfiCamp_Demo;
+    }
+    else if ((f = fopen(arg, "r")) != NULL)
+    {
+        const size_t n = fread(text, 1U, sizeof(text) - 1U, f);
+        const bool whole = (feof(f) != 0);
+        fclose(f);
+        if (!whole)
+        {
+            fprintf(stderr, "%s: script longer than %u bytes\n", arg, (unsigned)(SIM_CAMP_MAX - 1U));
+            return NULL;
+        }
+        text[n] = '\0';
+        script = text;
+    }
+    SfiCamp_Init(&a, &camp, &link, &now, NULL, NULL);
+    if (!FICampaign_Compile(&camp, script, &errLine))
+    {
+        fprintf(stderr, "--campaign %s: step %u rejected\n", arg, (unsigned)errLine);
+        return NULL;
+    }
+    return script;
+}
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: sfi_sim [--trials N] [--threads N] [--ms N] [--seed S] [--site NAME]\n"
+                    "               [--every N,..] [--bits B,..] [--arm \"SITE POLICY V..\"] [--only]\n"
+                    "               [--model \"NAME V..\"] [--period MS] [--baud N] [--csv] [--record DIR]\n"
+                    "               [--campaign FILE|STEPS|demo]\n"
+                    "       sfi_sim [options] --replay FILE [--point P --trial T]\n"
+                    "       sfi_sim --dump FILE\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    static sim_cfg_t c;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t point = 0U;
+    uint32_t replayPoint = UINT32_MAX;
+    uint32_t replayTrial = UINT32_MAX;
+    int status = 0;
+
+    c.trials = 1000U;
+    c.threads = (cpus > 0) ? (uint32_t)cpus : 1U;
+    c.ms = 5000U;
+    c.seed = 1U;
+    c.period = 5U;
+    c.baud = 115200U;
+    c.site = FI_SiteByName("rx");
+    c.bits[0] = 3U;
+    c.nBits = 1U;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(a, "--only") == 0) { c.only = true; continue; }
+        if (strcmp(a, "--csv") == 0) { c.csv = true; continue; }
+        if (v == NULL) return usage();
+        i++;
+        if (strcmp(a, "--trials") == 0) c.trials = (uint32_t)strtoul(v, NULL, 0);
+        else if (strcmp(a, "--threads") == 0) c.threads = (uint32_t)strtoul(v, NULL, 0);
+        else if (strcmp(a, "--ms") == 0) c.ms = (uint32_t)strtoul(v, NULL, 0);
+        else if (strcmp(a, "--seed") == 0) c.seed = (uint32_t)strtoul(v, NULL, 0);
+        else if (strcmp(a, "--period") == 0) c.period = (uint32_t)strtoul(v, NULL, 0);
+        else if (strcmp(a, "--baud") == 0) c.baud = (uint32_t)strtoul(v, NULL, 0);
+        else if (strcmp(a, "--every") == 0) c.nEvery = parse_list(v, c.every, SIM_MAX_SWEEP);
+        else if (strcmp(a, "--bits") == 0) c.nBits = parse_list(v, c.bits, SIM_MAX_SWEEP);
+        else if (strcmp(a, "--record") == 0) c.recordDir = v;
+        else if (strcmp(a, "--replay") == 0) c.replayFile = v;
+        else if (strcmp(a, "--point") == 0) replayPoint = (uint32_t)strtoul(v, NULL, 0);
+        else if (strcmp(a, "--trial") == 0) replayTrial = (uint32_t)strtoul(v, NULL, 0);
+        else if (strcmp(a, "--dump") == 0) return cmd_dump(v);
+        else if (strcmp(a, "--site") == 0)
+        {
+            c.site = FI_SiteByName(v);
+            if ((c.site == NULL) || (c.site->id >= FI_SITE_COUNT))
+            {
+                fprintf(stderr, "unknown site %s\n", v);
+                return 2;
+            }
+        }
+        else if (strcmp(a, "--model") == 0)
+        {
+            if (!parse_model(v, &c.rxModel))
+            {
+                fprintf(stderr, "bad --model \"%s\"\n", v);
+                return 2;
+            }
+        }
+        else if (strcmp(a, "--campaign") == 0)
+        {
+            c.campaign = load_campaign(v);
+            if (c.campaign == NULL) return 2;
+        }
+        else if (strcmp(a, "--arm") == 0)
+        {
+            if ((c.nArm >= SIM_MAX_ARMS) || !parse_arm(v, &c.arm[c.nArm]))
+            {
+                fprintf(stderr, "bad --arm \"%s\"\n", v);
+                return 2;
+            }
+            c.nArm++;
+        }
+        else return usage();
+    }
+    if ((c.threads == 0U) || (c.period == 0U) || (c.nBits == 0U) || (c.baud < 10000U)) return usage();
+    if (c.threads > c.trials) c.threads = (c.trials != 0U) ? c.trials : 1U;
+    if (c.replayFile != NULL) return run_replay(&c, replayPoint, replayTrial);
+
+    if (c.csv) printf("site,every,bits,trials,fault_site,fired,det,esc,mask,cov_pct,esc_pct,lat_ms_avg,lat_ms_max\n");
+    else
+    {
+        printf("sfi_sim: %u threads, seed %u, frame every %u ms at %u baud\n", (unsigned)c.threads,
+               (unsigned)c.seed, (unsigned)c.period, (unsigned)c.baud);
+        if (c.rxModel.model != (uint8_t)FICM_OFF)
+        {
+            printf("rx model %s %u %u %u %u\n", FICorrupt_ModelName(c.rxModel.model), (unsigned)c.rxModel.args[0],
+                   (unsigned)c.rxModel.args[1], (unsigned)c.rxModel.args[2], (unsigned)c.rxModel.args[3]);
+        }
+    }
+
+    if (c.nEvery == 0U)
+    {
+        return run_point(&c, 0U, 0U, 0U);
+    }
+    for (uint32_t e = 0U; e < c.nEvery; e++)
+    {
+        for (uint32_t b = 0U; b < c.nBits; b++)
+        {
+            const int rc = (c.every[e] != 0U) ? run_point(&c, point, c.every[e], c.bits[b]) : 1;
+            if ((rc != 0) && (rc != SIM_CAMP_FAILED)) return 1;
+            if (rc != 0) status = rc;
+            point++;
+        }
+    }
+    return status;
+}
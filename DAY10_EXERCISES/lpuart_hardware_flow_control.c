@@ -3,87 +3,315 @@
 #include "fsl_lpuart.h"
 #include "fsl_debug_console.h"
 
-#include <stdio.h>
+#include "analyzer/sniff_frame.h"
+#include "analyzer/a429_text.h"
+#include "analyzer/analyzer_core.h"
+#include "analyzer/capture.h"
+#include "analyzer/log_throttle.h"
+#include "analyzer/word_dedup.h"
+#include "common/a429_word.h"
+
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
+#if defined(ANALYZER_BENCH_SSCANF) && ANALYZER_BENCH_SSCANF
+#include <stdio.h>
+#endif
 
 /*******************************************************************************
  * Configuration
  ******************************************************************************/
 
-#define UART_SNiffer_BAUDRATE       (115200U)
-#define UART_RX_RING_BUFFER_SIZE    (512U)
-#define UART_RX_TEMP_BUFFER_SIZE    (64U)
+#define UART_SNiffer_BAUDRATE       (115200U)  /* port 0 */
+#define UART_RX_RING_BUFFER_SIZE    (512U)     /* port 0, ~44 ms at 115200 */
+#define UART_RX_DRAIN_PASSES        (4U)  /* max ring snapshots per poll */
 #define UART_LINE_BUFFER_SIZE       (80U)
-#define ANALYZER_MAX_LABELS         (256U)
+#define CMD_LINE_BUFFER_SIZE        (64U)
+
+/* 'b' benchmark also times the old sscanf() parser. Off by default so that
+   scanf stays out of the link map. */
+#ifndef ANALYZER_BENCH_SSCANF
+#define ANALYZER_BENCH_SSCANF       (0)
+#endif
+#define ANALYZER_BENCH_ROUNDS       (1000U)
+
+/* Live word print budget on the debug console (0 disables a stage). At
+   115200 baud a ~45 byte line caps out near 250 lines/s; beyond the budget
+   lines are counted and summarized once per second instead. */
+#ifndef ANALYZER_LOG_RATE
+#define ANALYZER_LOG_RATE           (100U)   /* lines/s */
+#endif
+#ifndef ANALYZER_LOG_BURST
+#define ANALYZER_LOG_BURST          (20U)
+#endif
+#ifndef ANALYZER_LOG_LABEL_QUOTA
+#define ANALYZER_LOG_LABEL_QUOTA    (0U)     /* lines per label per second */
+#endif
+#ifndef ANALYZER_LOG_SAMPLE_N
+#define ANALYZER_LOG_SAMPLE_N       (1U)     /* print 1 in N matching words */
+#endif
+
+/* Change-only live print ('d'): refresh unchanged values this often
+   (0 = only ever print changes). */
+#ifndef ANALYZER_DEDUP_HEARTBEAT_MS
+#define ANALYZER_DEDUP_HEARTBEAT_MS (5000U)
+#endif
+
+/* Capture RAM ring, in blocks of CAPTURE_BLOCK_MAX bytes */
+#ifndef ANALYZER_CAP_RING_BLOCKS
+#define ANALYZER_CAP_RING_BLOCKS    (8U)
+#endif
+
+/* Sniffer input ports. Port 0 is DEMO_LPUART (LPUART3); its TX also carries
+   the capture stream. More front ends (second HI-8582 receiver pair, other
+   boxes) are added by raising SNIFFER_PORT_COUNT and defining, in app.h, for
+   each extra port n:
+     SNIFFER_PORTn_LPUART     LPUART instance (pins muxed in pin_mux.c)
+     SNIFFER_PORTn_BAUDRATE   link rate               (default 115200)
+     SNIFFER_PORTn_RING_SIZE  RX ring bytes; size for ~40 ms at the link rate
+     SNIFFER_PORTn_CH_OFFSET  added to the channel ids the port reports
+                              (default 2n, so box n reports CH2n+1/CH2n+2)
+   LABEL_STATS_CHANNELS must reach the highest resulting channel id, or the
+   port's channels would share slot 0 of the counts, filters and dedup; it
+   sizes tables in the analyzer sources, so set it project-wide
+   (-DLABEL_STATS_CHANNELS=N), the build stops otherwise. All LPUARTs run
+   from the same UART clock root (DEMO_LPUART_CLK_FREQ). */
+#ifndef SNIFFER_PORT_COUNT
+#define SNIFFER_PORT_COUNT          (1U)
+#endif
+#if (SNIFFER_PORT_COUNT < 1) || (SNIFFER_PORT_COUNT > 4)
+#error "SNIFFER_PORT_COUNT must be 1..4"
+#endif
+
+#if SNIFFER_PORT_COUNT > 1
+#ifndef SNIFFER_PORT1_LPUART
+#error "SNIFFER_PORT1_LPUART not defined (app.h)"
+#endif
+#ifndef SNIFFER_PORT1_BAUDRATE
+#define SNIFFER_PORT1_BAUDRATE      (115200U)
+#endif
+#ifndef SNIFFER_PORT1_RING_SIZE
+#define SNIFFER_PORT1_RING_SIZE     (512U)
+#endif
+#ifndef SNIFFER_PORT1_CH_OFFSET
+#define SNIFFER_PORT1_CH_OFFSET     (2U)
+#endif
+#endif
+
+#if SNIFFER_PORT_COUNT > 2
+#ifndef SNIFFER_PORT2_LPUART
+#error "SNIFFER_PORT2_LPUART not defined (app.h)"
+#endif
+#ifndef SNIFFER_PORT2_BAUDRATE
+#define SNIFFER_PORT2_BAUDRATE      (115200U)
+#endif
+#ifndef SNIFFER_PORT2_RING_SIZE
+#define SNIFFER_PORT2_RING_SIZE     (512U)
+#endif
+#ifndef SNIFFER_PORT2_CH_OFFSET
+#define SNIFFER_PORT2_CH_OFFSET     (4U)
+#endif
+#endif
+
+#if SNIFFER_PORT_COUNT > 3
+#ifndef SNIFFER_PORT3_LPUART
+#error "SNIFFER_PORT3_LPUART not defined (app.h)"
+#endif
+#ifndef SNIFFER_PORT3_BAUDRATE
+#define SNIFFER_PORT3_BAUDRATE      (115200U)
+#endif
+#ifndef SNIFFER_PORT3_RING_SIZE
+#define SNIFFER_PORT3_RING_SIZE     (512U)
+#endif
+#ifndef SNIFFER_PORT3_CH_OFFSET
+#define SNIFFER_PORT3_CH_OFFSET     (6U)
+#endif
+#endif
+
+/* Each port reports CH1/CH2 plus its offset */
+#if (SNIFFER_PORT_COUNT > 1) && (LABEL_STATS_CHANNELS < (SNIFFER_PORT1_CH_OFFSET + 2U))
+#error "LABEL_STATS_CHANNELS below SNIFFER_PORT1_CH_OFFSET + 2: define it project-wide"
+#endif
+#if (SNIFFER_PORT_COUNT > 2) && (LABEL_STATS_CHANNELS < (SNIFFER_PORT2_CH_OFFSET + 2U))
+#error "LABEL_STATS_CHANNELS below SNIFFER_PORT2_CH_OFFSET + 2: define it project-wide"
+#endif
+#if (SNIFFER_PORT_COUNT > 3) && (LABEL_STATS_CHANNELS < (SNIFFER_PORT3_CH_OFFSET + 2U))
+#error "LABEL_STATS_CHANNELS below SNIFFER_PORT3_CH_OFFSET + 2: define it project-wide"
+#endif
 
 /*******************************************************************************
  * Types and globals
  ******************************************************************************/
 
-/* Per-label statistics */
+/* Static description of one sniffer input */
 typedef struct
 {
-    uint32_t totalCount;
-    uint32_t ch1Count;
-    uint32_t ch2Count;
-    uint32_t parityErrorCount;
-    uint32_t lastData;
-    uint8_t  lastSdi;
-    uint8_t  lastSsm;
-    uint8_t  lastChannel;
-} analyzer_label_stats_t;
-
-/* LPUART3 handle and ring buffer for sniffer input */
-static lpuart_handle_t g_lpuartHandle;
-static uint8_t         g_rxRingBuffer[UART_RX_RING_BUFFER_SIZE];
-
-/* Line assembly buffer */
-static char   s_lineBuffer[UART_LINE_BUFFER_SIZE];
-static size_t s_lineLength = 0U;
-
-/* Statistics */
-static analyzer_label_stats_t s_labelStats[ANALYZER_MAX_LABELS];
-static uint32_t              s_totalWords        = 0U;
-static uint32_t              s_totalParityErrors = 0U;
-
-/* Filters */
-static bool    s_filterByLabelEnabled   = false;
-static uint8_t s_filterLabel            = 0U;
-static bool    s_filterByChannelEnabled = false;
-static uint8_t s_filterChannel          = 0U; /* 1 or 2 */
+    LPUART_Type *base;
+    uint32_t     baudRate;
+    uint8_t     *ring;
+    size_t       ringSize;
+    uint8_t      chOffset;
+} sniffer_port_cfg_t;
+
+/* Runtime state of one sniffer input: SDK handle over its own RX ring,
+   line assembly / frame parser state and ring health counters. */
+typedef struct
+{
+    const sniffer_port_cfg_t *cfg;
+    lpuart_handle_t handle;
+    char            line[UART_LINE_BUFFER_SIZE];
+    size_t          lineLength;
+    bool            lineDiscard;  /* overflowed: skip to end of line */
+    sniff_parser_t  bin;
+    uint32_t        bytes;
+    volatile uint32_t ringOverruns; /* SDK ring full: oldest byte overwritten */
+    volatile uint32_t hwOverruns;   /* LPUART FIFO overrun */
+    uint32_t        resyncs;        /* parsed spans invalidated by an overrun */
+    uint32_t        peakFill;       /* max bytes seen waiting in the ring */
+} sniffer_port_t;
+
+static uint8_t s_rxRing0[UART_RX_RING_BUFFER_SIZE];
+#if SNIFFER_PORT_COUNT > 1
+static uint8_t s_rxRing1[SNIFFER_PORT1_RING_SIZE];
+#endif
+#if SNIFFER_PORT_COUNT > 2
+static uint8_t s_rxRing2[SNIFFER_PORT2_RING_SIZE];
+#endif
+#if SNIFFER_PORT_COUNT > 3
+static uint8_t s_rxRing3[SNIFFER_PORT3_RING_SIZE];
+#endif
+
+static const sniffer_port_cfg_t s_portCfg[SNIFFER_PORT_COUNT] = {
+    {DEMO_LPUART, UART_SNiffer_BAUDRATE, s_rxRing0, sizeof(s_rxRing0), 0U},
+#if SNIFFER_PORT_COUNT > 1
+    {SNIFFER_PORT1_LPUART, SNIFFER_PORT1_BAUDRATE, s_rxRing1, sizeof(s_rxRing1), SNIFFER_PORT1_CH_OFFSET},
+#endif
+#if SNIFFER_PORT_COUNT > 2
+    {SNIFFER_PORT2_LPUART, SNIFFER_PORT2_BAUDRATE, s_rxRing2, sizeof(s_rxRing2), SNIFFER_PORT2_CH_OFFSET},
+#endif
+#if SNIFFER_PORT_COUNT > 3
+    {SNIFFER_PORT3_LPUART, SNIFFER_PORT3_BAUDRATE, s_rxRing3, sizeof(s_rxRing3), SNIFFER_PORT3_CH_OFFSET},
+#endif
+};
+
+static sniffer_port_t    s_ports[SNIFFER_PORT_COUNT];
+static volatile uint32_t s_portReady; /* bit n: port n went idle or overran (IRQ) */
+static uint32_t          s_portNext;  /* round-robin start for the next poll */
+
+/* Statistics and filters (board-independent core) */
+static analyzer_core_t s_core;
+
+/* Sniffer input format: ASCII lines (compatibility) or binary frames */
+typedef enum
+{
+    ANALYZER_INPUT_ASCII = 0,
+    ANALYZER_INPUT_BINARY,
+    ANALYZER_INPUT_COUNT
+} analyzer_input_t;
+
+static analyzer_input_t s_inputMode = ANALYZER_INPUT_ASCII;
+
+/* Ingest performance per input format (DWT cycles) */
+typedef struct
+{
+    uint32_t words;
+    uint32_t bytes;
+    uint64_t ingestCycles; /* UART drain + decode + stats + live print */
+    uint64_t printCycles;  /* live print only */
+    uint64_t startCycles;  /* wall-clock reference for words/s */
+} analyzer_perf_t;
+
+static analyzer_perf_t s_perf[ANALYZER_INPUT_COUNT];
+static uint32_t        s_cycLast;
+static uint64_t        s_cycHigh;
+static uint32_t        s_cyclesPerUs;
+static uint32_t        s_lineTimestampUs; /* drain time of the current chunk (ASCII stamps, print throttle) */
+
+/* Debug-console command line (filter commands), edited one char per loop pass */
+static char   s_cmdLine[CMD_LINE_BUFFER_SIZE];
+static size_t s_cmdLength = 0U;
+static bool   s_cmdActive = false;
+
+/* Live print throttle */
+static log_throttle_t   s_logThrottle;
+
+/* Change-only live print: repeats of an unchanged value are not printed */
+static word_dedup_t     s_dedup;
+static bool             s_dedupOn = false;
+
+/* Capture: finished blocks queue in a RAM ring. With streaming on they are
+   sent out of port 0 (LPUART3) TX for the host (host/a429_replay); otherwise the ring
+   keeps the newest blocks, readable from s_capRing with a debugger. */
+static capture_writer_t  s_capWriter;
+static bool              s_capEnabled = false;
+static bool              s_capStream  = false;
+static uint8_t           s_capRing[ANALYZER_CAP_RING_BLOCKS][CAPTURE_BLOCK_MAX];
+static uint16_t          s_capLen[ANALYZER_CAP_RING_BLOCKS];
+static uint32_t          s_capHead;       /* blocks written (free-running) */
+static volatile uint32_t s_capTail;       /* blocks sent or overwritten */
+static volatile bool     s_capTxBusy;
+static uint32_t          s_capDropped;
+
 
 /*******************************************************************************
- * Utility: ARINC parity
+ * Timebase: DWT cycle counter extended to 64 bits (main loop polls far more
+ * often than the ~7 s CYCCNT wrap at 600 MHz).
  ******************************************************************************/
 
-/* Compute ARINC 429 odd parity bit for bits 0..30 of the word */
-static uint8_t Analyzer_ComputeParityBit(uint32_t wordNoParity)
+static void Analyzer_TimeInit(void)
 {
-    uint8_t parity = 0U;
-    uint32_t v = wordNoParity & 0x7FFFFFFFU; /* Only 31 bits used */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    s_cycLast = 0U;
+    s_cycHigh = 0U;
+    s_cyclesPerUs = SystemCoreClock / 1000000U;
+}
 
-    while (v != 0U)
+static uint64_t Analyzer_Cycles64(void)
+{
+    uint32_t now = DWT->CYCCNT;
+    if (now < s_cycLast)
     {
-        parity ^= (uint8_t)(v & 1U);
-        v >>= 1U;
+        s_cycHigh += (1ULL << 32);
     }
+    s_cycLast = now;
+    return s_cycHigh | now;
+}
 
-    /* If number of ones in bits 0..30 is odd (parity=1), parity bit must be 0.
-       If number of ones is even (parity=0), parity bit must be 1. */
-    return (uint8_t)(parity ^ 1U);
+static uint32_t Analyzer_NowUs(void)
+{
+    return (uint32_t)(Analyzer_Cycles64() / s_cyclesPerUs);
 }
 
 /*******************************************************************************
  * Analyzer logic
  ******************************************************************************/
 
+static void Analyzer_ResetPerf(void)
+{
+    uint64_t now = Analyzer_Cycles64();
+    memset(s_perf, 0, sizeof(s_perf));
+    LogThrottle_ResetCounters(&s_logThrottle);
+    for (uint32_t i = 0U; i < SNIFFER_PORT_COUNT; i++)
+    {
+        s_ports[i].bytes        = 0U;
+        s_ports[i].ringOverruns = 0U;
+        s_ports[i].hwOverruns   = 0U;
+        s_ports[i].resyncs      = 0U;
+        s_ports[i].peakFill     = 0U;
+    }
+    for (uint32_t i = 0U; i < ANALYZER_INPUT_COUNT; i++)
+    {
+        s_perf[i].startCycles = now;
+    }
+}
+
 static void Analyzer_ClearStats(void)
 {
-    memset(s_labelStats, 0, sizeof(s_labelStats));
-    s_totalWords        = 0U;
-    s_totalParityErrors = 0U;
+    AnalyzerCore_ClearStats(&s_core);
+    WordDedup_Clear(&s_dedup);
+    Analyzer_ResetPerf();
 }
 
 static void Analyzer_PrintHelp(void)
@@ -92,255 +320,601 @@ static void Analyzer_PrintHelp(void)
     PRINTF("  h - show this help\r\n");
     PRINTF("  s - show overall summary\r\n");
     PRINTF("  l - list labels with non-zero counts\r\n");
+    PRINTF("  t - per-label rate, period and jitter\r\n");
     PRINTF("  c - clear statistics\r\n");
-    PRINTF("  f - set label/channel filter\r\n");
+    PRINTF("  f - filter command, Enter to apply, Esc to cancel (empty = show):\r\n");
+    PRINTF("        allow [chN] L[-L]..   deny [chN] L[-L]..   (labels in hex)\r\n");
+    PRINTF("        ch N..   sdi V..   ssm V..   data MIN MAX   off\r\n");
     PRINTF("  r - remove filters\r\n");
+    PRINTF("  d - toggle change-only live print (repeats suppressed, %u ms refresh)\r\n",
+           (unsigned int)ANALYZER_DEDUP_HEARTBEAT_MS);
+    PRINTF("  m - toggle input format (ASCII lines / binary frames)\r\n");
+    PRINTF("  p - show ingest performance (words/s, cycles/word)\r\n");
+    PRINTF("  w - start/stop capture of raw timestamped words\r\n");
+    PRINTF("  o - toggle streaming capture blocks out of port 0 (LPUART3) TX\r\n");
+    PRINTF("  b - benchmark the ASCII line parser\r\n");
+}
+
+static void Analyzer_PrintDedup(void)
+{
+    PRINTF("Change-only %s: %u changed, %u refreshes, %u repeats suppressed\r\n",
+           s_dedupOn ? "on" : "off",
+           (unsigned int)s_dedup.changed,
+           (unsigned int)s_dedup.heartbeats,
+           (unsigned int)s_dedup.suppressed);
 }
 
-static void Analyzer_PrintSummary(void)
+static void Analyzer_PrintPerf(void)
 {
-    PRINTF("\r\n=== Summary ===\r\n");
-    PRINTF("Total words        : %u\r\n", (unsigned int)s_totalWords);
-    PRINTF("Total parity errors: %u\r\n", (unsigned int)s_totalParityErrors);
+    static const char *const names[ANALYZER_INPUT_COUNT] = {"ASCII", "binary"};
+    uint64_t now = Analyzer_Cycles64();
+    uint32_t hz  = SystemCoreClock;
+
+    PRINTF("\r\n=== Ingest performance (input: %s) ===\r\n", names[s_inputMode]);
+    PRINTF("Format  Words     Bytes     B/word  Words/s  DecodeCyc/word  PrintCyc/word\r\n");
+    for (uint32_t i = 0U; i < ANALYZER_INPUT_COUNT; i++)
+    {
+        const analyzer_perf_t *pf = &s_perf[i];
+        uint64_t elapsed  = now - pf->startCycles;
+        uint32_t wps      = (elapsed != 0U) ? (uint32_t)(((uint64_t)pf->words * hz) / elapsed) : 0U;
+        uint32_t bpw      = (pf->words != 0U) ? (pf->bytes / pf->words) : 0U;
+        uint32_t decode   = (pf->words != 0U) ? (uint32_t)((pf->ingestCycles - pf->printCycles) / pf->words) : 0U;
+        uint32_t printCyc = (pf->words != 0U) ? (uint32_t)(pf->printCycles / pf->words) : 0U;
+
+        PRINTF("%-6s  %-8u  %-8u  %-6u  %-7u  %-14u  %u\r\n",
+               names[i],
+               (unsigned int)pf->words,
+               (unsigned int)pf->bytes,
+               (unsigned int)bpw,
+               (unsigned int)wps,
+               (unsigned int)decode,
+               (unsigned int)printCyc);
+    }
+    PRINTF("Port  LPUART  Baud     Link words/s (ASCII/bin)  Bytes     Ring peak/size  Overruns (hw)  Resyncs\r\n");
+    for (uint32_t i = 0U; i < SNIFFER_PORT_COUNT; i++)
+    {
+        const sniffer_port_t *port = &s_ports[i];
+        uint32_t baud = port->cfg->baudRate;
+
+        PRINTF("%-4u  %-6u  %-7u  ~%-6u / %-15u  %-8u  %4u/%-9u  %-5u (%-5u)  %u\r\n",
+               (unsigned int)i,
+               (unsigned int)LPUART_GetInstance(port->cfg->base),
+               (unsigned int)baud,
+               (unsigned int)(baud / 10U / 40U),
+               (unsigned int)(baud / 10U / SNIFF_FRAME_LEN),
+               (unsigned int)port->bytes,
+               (unsigned int)port->peakFill,
+               (unsigned int)port->cfg->ringSize,
+               (unsigned int)port->ringOverruns,
+               (unsigned int)port->hwOverruns,
+               (unsigned int)port->resyncs);
+    }
+    PRINTF("Live print: %u printed, dropped %u (rate %u, label quota %u, sampled %u)\r\n",
+           (unsigned int)s_logThrottle.passed,
+           (unsigned int)LogThrottle_Dropped(&s_logThrottle),
+           (unsigned int)s_logThrottle.droppedRate,
+           (unsigned int)s_logThrottle.droppedQuota,
+           (unsigned int)s_logThrottle.droppedSample);
+    Analyzer_PrintDedup();
 }
 
-static void Analyzer_PrintLabelTable(void)
+/* Once per second while the print budget is exceeded: one aggregate line
+   instead of the dropped per-word lines. */
+static void Analyzer_ThrottleTick(void)
 {
-    uint32_t lbl;
+    uint32_t passed, dropped;
 
-    PRINTF("\r\nLabel  Count   CH1   CH2   ParErr  LastData   SDI SSM CH\r\n");
-    for (lbl = 0U; lbl < ANALYZER_MAX_LABELS; lbl++)
+    if (LogThrottle_SummaryDue(&s_logThrottle, Analyzer_NowUs(), &passed, &dropped))
     {
-        const analyzer_label_stats_t *st = &s_labelStats[lbl];
-        if (st->totalCount != 0U)
+        PRINTF("[live] %u printed, %u suppressed in last %u ms (total words %u, parity errors %u)\r\n",
+               (unsigned int)passed,
+               (unsigned int)dropped,
+               (unsigned int)(s_logThrottle.windowUs / 1000U),
+               (unsigned int)s_core.totalWords,
+               (unsigned int)s_core.totalParityErrors);
+    }
+}
+
+/*******************************************************************************
+ * Capture
+ ******************************************************************************/
+
+/* Writer sink (main context): queue the finished block in the RAM ring. */
+static void Analyzer_CaptureSink(const uint8_t *block, size_t len, void *user)
+{
+    (void)user;
+
+    if ((s_capHead - s_capTail) >= ANALYZER_CAP_RING_BLOCKS)
+    {
+        if (s_capStream || s_capTxBusy)
         {
-            PRINTF("0x%02X  %6u %5u %5u %7u  0x%05X    %u   %u  %u\r\n",
-                   (unsigned int)lbl,
-                   (unsigned int)st->totalCount,
-                   (unsigned int)st->ch1Count,
-                   (unsigned int)st->ch2Count,
-                   (unsigned int)st->parityErrorCount,
-                   (unsigned int)st->lastData,
-                   (unsigned int)st->lastSdi,
-                   (unsigned int)st->lastSsm,
-                   (unsigned int)st->lastChannel);
+            s_capDropped++;
+            return;
         }
+        s_capTail++; /* ring mode: overwrite the oldest block */
     }
+
+    uint32_t slot = s_capHead % ANALYZER_CAP_RING_BLOCKS;
+    memcpy(s_capRing[slot], block, len);
+    s_capLen[slot] = (uint16_t)len;
+    s_capHead++;
 }
 
-/* Parse one line from sniffer and update statistics. */
-static void Analyzer_ProcessLine(const char *line)
-{
-    unsigned int ch = 0U;
-    unsigned int lbl = 0U;
-    unsigned int sdi = 0U;
-    unsigned int data = 0U;
-    unsigned int ssm = 0U;
-    unsigned int p = 0U;
-
-    /* Example line:
-       CH1 LBL=1F SDI=0 DATA=12345 SSM=1 P=1
-     */
-    int parsed = sscanf(line,
-                        "CH%u LBL=%x SDI=%u DATA=%x SSM=%u P=%u",
-                        &ch, &lbl, &sdi, &data, &ssm, &p);
-    if (parsed != 6)
-    {
-        PRINTF("WARN: Could not parse line: \"%s\"\r\n", line);
+/* Start sending the oldest queued block if streaming and TX is idle. */
+static void Analyzer_CapturePump(void)
+{
+    if (!s_capStream || s_capTxBusy || (s_capHead == s_capTail))
+    {
         return;
     }
 
-    uint8_t  channel   = (uint8_t)ch;
-    uint8_t  labelByte = (uint8_t)(lbl & 0xFFU);
-    uint8_t  sdiBits   = (uint8_t)(sdi & 0x03U);
-    uint32_t dataBits  = (uint32_t)(data & 0x1FFFFFU); /* 19-bit field */
-    uint8_t  ssmBits   = (uint8_t)(ssm & 0x03U);
-    uint8_t  parityBit = (uint8_t)(p & 0x01U);
+    uint32_t slot = s_capTail % ANALYZER_CAP_RING_BLOCKS;
+    lpuart_transfer_t xfer;
 
-    /* Reconstruct bits 0..30 (no parity) in Holt/our bit layout:
-       bits 0..7   : LABEL
-       bits 8..9   : SDI
-       bits 10..28 : DATA (19 bits)
-       bits 29..30 : SSM
-       bit  31     : parity
-     */
-    uint32_t wordNoParity = 0U;
-    wordNoParity |= (uint32_t)labelByte;
-    wordNoParity |= ((uint32_t)sdiBits << 8);
-    wordNoParity |= ((uint32_t)dataBits << 10);
-    wordNoParity |= ((uint32_t)ssmBits << 29);
+    xfer.data     = s_capRing[slot];
+    xfer.dataSize = s_capLen[slot];
+    s_capTxBusy   = true;
+    if (LPUART_TransferSendNonBlocking(s_portCfg[0].base, &s_ports[0].handle, &xfer) != kStatus_Success)
+    {
+        s_capTxBusy = false;
+    }
+}
 
-    uint8_t expectedParity = Analyzer_ComputeParityBit(wordNoParity);
-    bool parityOk = (parityBit == expectedParity);
+static void Analyzer_PrintCapture(void)
+{
+    PRINTF("\r\nCapture %s, streaming %s: words=%u blocks=%u ring=%u/%u dropped=%u\r\n",
+           s_capEnabled ? "on" : "off",
+           s_capStream ? "on" : "off",
+           (unsigned int)s_capWriter.words,
+           (unsigned int)s_capWriter.blocks,
+           (unsigned int)(s_capHead - s_capTail),
+           (unsigned int)ANALYZER_CAP_RING_BLOCKS,
+           (unsigned int)s_capDropped);
+}
 
-    s_totalWords++;
+/* Update statistics and live output for one received ARINC word. */
+static void Analyzer_ProcessWord(uint8_t channel, uint32_t word, uint32_t timestampUs)
+{
+    bool parityOk;
 
-    analyzer_label_stats_t *st = &s_labelStats[labelByte];
-    st->totalCount++;
-    if (channel == 1U)
+    s_perf[s_inputMode].words++;
+    if (s_capEnabled)
     {
-        st->ch1Count++;
+        Capture_Record(&s_capWriter, channel, word, timestampUs);
     }
-    else if (channel == 2U)
+
+    if (AnalyzerCore_ProcessWord(&s_core, channel, word, timestampUs, &parityOk) &&
+        (!s_dedupOn || WordDedup_Check(&s_dedup, channel, word, s_lineTimestampUs)) &&
+        LogThrottle_Allow(&s_logThrottle, (uint8_t)A429_GetLabel(word), s_lineTimestampUs))
     {
-        st->ch2Count++;
+        /* Only a printed word counts as sent: one the throttle dropped
+           stays new for the dedup */
+        if (s_dedupOn)
+        {
+            WordDedup_Commit(&s_dedup, channel, word, s_lineTimestampUs);
+        }
+
+        uint32_t t0 = DWT->CYCCNT;
+        PRINTF("CH%u LBL=%02X SDI=%u DATA=%05X SSM=%u P=%u%s\r\n",
+               (unsigned int)channel,
+               (unsigned int)A429_GetLabel(word),
+               (unsigned int)A429_GetSdi(word),
+               (unsigned int)A429_GetData(word),
+               (unsigned int)A429_GetSsm(word),
+               (unsigned int)A429_GetParity(word),
+               parityOk ? "" : " [PARITY ERR]");
+        s_perf[s_inputMode].printCycles += (uint32_t)(DWT->CYCCNT - t0);
     }
-    if (!parityOk)
+}
+
+/* Parse one ASCII line from a sniffer port and update statistics.
+   Accepted lines:
+     CH1 LBL=1F SDI=0 DATA=12345 SSM=1 P=1
+     R1,1F,0,A0012345
+ */
+static void Analyzer_ProcessLine(const sniffer_port_t *port, const char *line, size_t len)
+{
+    a429_text_word_t w;
+
+    if (!A429Text_ParseLine(line, len, &w))
     {
-        st->parityErrorCount++;
-        s_totalParityErrors++;
+        /* line may point into the RX ring: copy for printing */
+        char text[UART_LINE_BUFFER_SIZE];
+        size_t n = (len < (sizeof(text) - 1U)) ? len : (sizeof(text) - 1U);
+        memcpy(text, line, n);
+        text[n] = '\0';
+        PRINTF("WARN: Could not parse line: \"%s\"\r\n", text);
+        return;
     }
 
-    st->lastData    = dataBits;
-    st->lastSdi     = sdiBits;
-    st->lastSsm     = ssmBits;
-    st->lastChannel = channel;
-
-    /* Apply filters for live output on debug console */
-    bool match = true;
+    Analyzer_ProcessWord((uint8_t)(w.channel + port->cfg->chOffset), w.word, s_lineTimestampUs);
+}
 
-    if (s_filterByLabelEnabled && (labelByte != s_filterLabel))
+/* Time the line parser alone (no stats, no PRINTF) over a fixed mix of
+   good and malformed lines. */
+static void Analyzer_BenchParser(void)
+{
+    static const char *const lines[] = {
+        "CH1 LBL=1F SDI=0 DATA=12345 SSM=1 P=1",
+        "CH2 LBL=A3 SDI=2 DATA=7FFFF SSM=3 P=0",
+        "R1,1F,0,A0012345",
+        "R2,A3,2,7FFFFEA3",
+        "CH1 LBL=1F SDI=9 DATA=12345 SSM=1 P=1",
+        "R1,1F,0,",
+    };
+    const uint32_t n = (uint32_t)(sizeof(lines) / sizeof(lines[0]));
+    size_t lens[sizeof(lines) / sizeof(lines[0])];
+    uint32_t accepted = 0U;
+    uint32_t t0;
+    uint32_t fastCyc;
+
+    for (uint32_t i = 0U; i < n; i++)
     {
-        match = false;
+        lens[i] = strlen(lines[i]);
     }
 
-    if (s_filterByChannelEnabled && (channel != s_filterChannel))
+    t0 = DWT->CYCCNT;
+    for (uint32_t r = 0U; r < ANALYZER_BENCH_ROUNDS; r++)
     {
-        match = false;
+        for (uint32_t i = 0U; i < n; i++)
+        {
+            a429_text_word_t w;
+            accepted += A429Text_ParseLine(lines[i], lens[i], &w) ? 1U : 0U;
+        }
     }
-
-    if (match)
+    fastCyc = DWT->CYCCNT - t0;
+
+    PRINTF("\r\n=== Line parser benchmark (%u lines) ===\r\n", (unsigned int)(n * ANALYZER_BENCH_ROUNDS));
+    PRINTF("A429Text : %u cycles/line, %u accepted\r\n",
+           (unsigned int)(fastCyc / (n * ANALYZER_BENCH_ROUNDS)),
+           (unsigned int)accepted);
+
+#if ANALYZER_BENCH_SSCANF
+    uint32_t scanCyc;
+    accepted = 0U;
+    t0 = DWT->CYCCNT;
+    for (uint32_t r = 0U; r < ANALYZER_BENCH_ROUNDS; r++)
     {
-        PRINTF("CH%u LBL=%02X SDI=%u DATA=%05X SSM=%u P=%u%s\r\n",
-               (unsigned int)channel,
-               (unsigned int)labelByte,
-               (unsigned int)sdiBits,
-               (unsigned int)dataBits,
-               (unsigned int)ssmBits,
-               (unsigned int)parityBit,
-               parityOk ? "" : " [PARITY ERR]");
+        for (uint32_t i = 0U; i < n; i++)
+        {
+            unsigned int ch, lbl, sdi, data, ssm, p;
+            accepted += (sscanf(lines[i], "CH%u LBL=%x SDI=%u DATA=%x SSM=%u P=%u",
+                                &ch, &lbl, &sdi, &data, &ssm, &p) == 6) ? 1U : 0U;
+        }
     }
+    scanCyc = DWT->CYCCNT - t0;
+    PRINTF("sscanf   : %u cycles/line, %u accepted (CH format only)\r\n",
+           (unsigned int)(scanCyc / (n * ANALYZER_BENCH_ROUNDS)),
+           (unsigned int)accepted);
+#endif
+}
+
+/* Binary frame callback: the sender already packed the raw word and
+   timestamped it at capture. user is the sniffer port. */
+static void Analyzer_OnBinaryWord(const sniff_word_t *w, void *user)
+{
+    const sniffer_port_t *port = (const sniffer_port_t *)user;
+    Analyzer_ProcessWord((uint8_t)(w->channel + port->cfg->chOffset), w->word, w->ts_us);
 }
 
 /*******************************************************************************
- * UART (sniffer) handling – LPUART3
+ * UART (sniffer) handling – one LPUART + RX ring per port
  ******************************************************************************/
 
-/* We don't need anything in the callback for this use-case (ring buffer only). */
+/* RX uses the ring buffer only. Idle line (end of a burst) and overruns mark
+   the port ready; TX completion on port 0 releases a capture block. */
 static void LPUART_SnifferCallback(LPUART_Type *base,
                                    lpuart_handle_t *handle,
                                    status_t status,
                                    void *userData)
 {
+    sniffer_port_t *port = (sniffer_port_t *)userData;
+    uint32_t bit = 1UL << (uint32_t)(port - s_ports);
+
     (void)base;
     (void)handle;
-    (void)status;
-    (void)userData;
+
+    if (status == kStatus_LPUART_TxIdle)
+    {
+        s_capTail++;
+        s_capTxBusy = false;
+    }
+    else if (status == kStatus_LPUART_IdleLineDetected)
+    {
+        s_portReady |= bit;
+    }
+    else if (status == kStatus_LPUART_RxRingBufferOverrun)
+    {
+        /* The driver advances the tail after this returns (drops oldest) */
+        port->ringOverruns++;
+        s_portReady |= bit;
+    }
+    else if (status == kStatus_LPUART_RxHardwareOverrun)
+    {
+        port->hwOverruns++;
+        s_portReady |= bit;
+    }
 }
 
-/* Pull available bytes from the LPUART ring buffer and feed the line parser. */
-static void Sniffer_PollUart(void)
+/* Zero-copy view of the unread part of a port's SDK RX ring: up to two
+   contiguous spans (before and after the wrap). */
+typedef struct
 {
-    size_t available = LPUART_TransferGetRxRingBufferLength(DEMO_LPUART, &g_lpuartHandle);
+    const uint8_t *data[2];
+    size_t         len[2];
+    uint16_t       head;      /* ring head at snapshot time */
+    uint32_t       overruns;  /* port->ringOverruns at snapshot time */
+} sniffer_spans_t;
 
-    if (available == 0U)
-    {
-        return;
-    }
+static size_t Sniffer_RxSpans(const sniffer_port_t *port, sniffer_spans_t *sp)
+{
+    const lpuart_handle_t *h = &port->handle;
+    uint16_t head = h->rxRingBufferHead;
+    uint16_t tail = h->rxRingBufferTail;
 
-    uint8_t rxTemp[UART_RX_TEMP_BUFFER_SIZE];
-    lpuart_transfer_t xfer;
-    size_t toRead = available;
+    sp->head     = head;
+    sp->overruns = port->ringOverruns;
+    sp->data[0]  = &h->rxRingBuffer[tail];
+    sp->data[1]  = h->rxRingBuffer;
 
-    if (toRead > UART_RX_TEMP_BUFFER_SIZE)
+    if (head >= tail)
+    {
+        sp->len[0] = (size_t)(head - tail);
+        sp->len[1] = 0U;
+    }
+    else
     {
-        toRead = UART_RX_TEMP_BUFFER_SIZE;
+        sp->len[0] = h->rxRingBufferSize - tail;
+        sp->len[1] = head;
     }
+    return sp->len[0] + sp->len[1];
+}
 
-    xfer.data     = rxTemp;
-    xfer.dataSize = toRead;
+/* Release everything covered by the snapshot with one tail update. Returns
+   false if the driver overwrote unread bytes meanwhile (the parsed data may
+   be torn); the tail is then left where the driver put it. */
+static bool Sniffer_RxRelease(sniffer_port_t *port, const sniffer_spans_t *sp)
+{
+    bool ok;
+    uint32_t primask = DisableGlobalIRQ();
 
-    size_t receivedBytes = 0U;
-    status_t status = LPUART_TransferReceiveNonBlocking(DEMO_LPUART,
-                                                        &g_lpuartHandle,
-                                                        &xfer,
-                                                        &receivedBytes);
-    if ((status != kStatus_Success) && (status != kStatus_LPUART_RxIdle))
+    ok = (port->ringOverruns == sp->overruns);
+    if (ok)
     {
-        /* RX busy or error: just skip this time */
-        return;
+        port->handle.rxRingBufferTail = sp->head;
     }
+    EnableGlobalIRQ(primask);
+    return ok;
+}
 
-    for (size_t i = 0U; i < receivedBytes; i++)
+/* Forget a partial line / frame (format switch or torn ring data). */
+static void Sniffer_ResetParse(sniffer_port_t *port, bool discardLine)
+{
+    port->lineLength  = 0U;
+    port->lineDiscard = discardLine;
+    SniffFrame_ParserInit(&port->bin);
+}
+
+/* Assemble ASCII lines from one span. Lines wholly inside the span are
+   parsed in place; only a line split across spans or polls is copied. */
+static void Sniffer_FeedAscii(sniffer_port_t *port, const uint8_t *data, size_t len)
+{
+    while (len != 0U)
     {
-        char ch = (char)rxTemp[i];
+        size_t n = 0U;
 
-        if ((ch == '\r') || (ch == '\n'))
+        while ((n < len) && (data[n] != '\r') && (data[n] != '\n'))
         {
-            if (s_lineLength > 0U)
+            n++;
+        }
+
+        if (port->lineDiscard)
+        {
+            /* drop the rest of an over-long line */
+        }
+        else if ((port->lineLength + n) >= UART_LINE_BUFFER_SIZE)
+        {
+            port->lineDiscard = true;
+            port->lineLength  = 0U;
+        }
+        else if ((n < len) && (port->lineLength == 0U))
+        {
+            if (n != 0U)
             {
-                s_lineBuffer[s_lineLength] = '\0';
-                Analyzer_ProcessLine(s_lineBuffer);
-                s_lineLength = 0U;
+                Analyzer_ProcessLine(port, (const char *)data, n);
             }
         }
         else
         {
-            if (s_lineLength < (UART_LINE_BUFFER_SIZE - 1U))
+            memcpy(&port->line[port->lineLength], data, n);
+            port->lineLength += n;
+            if ((n < len) && (port->lineLength != 0U))
             {
-                s_lineBuffer[s_lineLength++] = ch;
+                port->line[port->lineLength] = '\0';
+                Analyzer_ProcessLine(port, port->line, port->lineLength);
+                port->lineLength = 0U;
+            }
+        }
+
+        if (n == len)
+        {
+            break; /* line continues in the next span */
+        }
+        port->lineDiscard = false;
+        data += n + 1U;
+        len  -= n + 1U;
+    }
+}
+
+/* Drain one port's RX ring: parse straight from the ring spans, release
+   them with one tail update, and repeat while new bytes keep arriving
+   (bounded so the other ports and console commands stay responsive). */
+static void Sniffer_PollPort(sniffer_port_t *port)
+{
+    for (uint32_t pass = 0U; pass < UART_RX_DRAIN_PASSES; pass++)
+    {
+        sniffer_spans_t sp;
+        size_t available = Sniffer_RxSpans(port, &sp);
+
+        if (available == 0U)
+        {
+            return;
+        }
+        if (available > port->peakFill)
+        {
+            port->peakFill = (uint32_t)available;
+        }
+
+        uint32_t t0 = DWT->CYCCNT;
+        analyzer_input_t mode = s_inputMode;
+
+        /* ASCII lines carry no timestamp: use the drain time of this pass. */
+        s_lineTimestampUs = Analyzer_NowUs();
+
+        for (uint32_t i = 0U; i < 2U; i++)
+        {
+            if (sp.len[i] == 0U)
+            {
+                continue;
+            }
+            if (mode == ANALYZER_INPUT_BINARY)
+            {
+                (void)SniffFrame_Parse(&port->bin, sp.data[i], sp.len[i], Analyzer_OnBinaryWord, port);
             }
             else
             {
-                /* Overflow, drop line */
-                s_lineLength = 0U;
+                Sniffer_FeedAscii(port, sp.data[i], sp.len[i]);
+            }
+        }
+
+        if (!Sniffer_RxRelease(port, &sp))
+        {
+            /* Bytes were overwritten under the parser: drop partial state */
+            port->resyncs++;
+            Sniffer_ResetParse(port, true);
+        }
+
+        port->bytes += (uint32_t)available;
+        s_perf[mode].bytes += (uint32_t)available;
+        s_perf[mode].ingestCycles += (uint32_t)(DWT->CYCCNT - t0);
+    }
+}
+
+/* Serve all ports once per main-loop pass. Ports flagged by their IRQ (a
+   burst ended or the ring overran) go first, the rest follow; both sweeps
+   start one port further on each call so no link is always served last. */
+static void Sniffer_PollPorts(void)
+{
+    uint32_t primask = DisableGlobalIRQ();
+    uint32_t ready   = s_portReady;
+    s_portReady      = 0U;
+    EnableGlobalIRQ(primask);
+
+    uint32_t start = s_portNext;
+    s_portNext = (start + 1U) % SNIFFER_PORT_COUNT;
+
+    for (uint32_t sweep = 0U; sweep < 2U; sweep++)
+    {
+        for (uint32_t i = 0U; i < SNIFFER_PORT_COUNT; i++)
+        {
+            uint32_t idx     = (start + i) % SNIFFER_PORT_COUNT;
+            bool     isReady = ((ready >> idx) & 1U) != 0U;
+
+            if (isReady == (sweep == 0U))
+            {
+                Sniffer_PollPort(&s_ports[idx]);
             }
         }
     }
 }
 
+/* Bring up every configured sniffer port. Only port 0 enables TX (capture
+   stream); the others are receive-only. */
+static void Sniffer_InitPorts(void)
+{
+    lpuart_config_t config;
+
+    for (uint32_t i = 0U; i < SNIFFER_PORT_COUNT; i++)
+    {
+        sniffer_port_t *port = &s_ports[i];
+        const sniffer_port_cfg_t *cfg = &s_portCfg[i];
+
+        port->cfg = cfg;
+        Sniffer_ResetParse(port, false);
+
+        LPUART_GetDefaultConfig(&config);
+        config.baudRate_Bps = cfg->baudRate;
+        config.enableTx     = (i == 0U);
+        config.enableRx     = true;
+        LPUART_Init(cfg->base, &config, DEMO_LPUART_CLK_FREQ);
+
+        LPUART_TransferCreateHandle(cfg->base, &port->handle, LPUART_SnifferCallback, port);
+        LPUART_TransferStartRingBuffer(cfg->base, &port->handle, cfg->ring, cfg->ringSize);
+        LPUART_EnableInterrupts(cfg->base, kLPUART_IdleLineInterruptEnable);
+
+        PRINTF("Port %u: LPUART%u at %u baud, ring %u bytes, channel offset %u\r\n",
+               (unsigned int)i,
+               (unsigned int)LPUART_GetInstance(cfg->base),
+               (unsigned int)cfg->baudRate,
+               (unsigned int)cfg->ringSize,
+               (unsigned int)cfg->chOffset);
+    }
+}
+
 /*******************************************************************************
  * Debug-console command handling
  ******************************************************************************/
 
-static void Analyzer_SetFilterInteractive(void)
+/* Execute the completed "f" command line. */
+static void Analyzer_RunFilterCommand(void)
 {
-    uint32_t label = 0U;
-    uint32_t channel = 0U;
-
-    PRINTF("\r\nEnter hex label to filter (e.g. 1F), or 0xFF to disable label filter: ");
-    SCANF("%x", &label);
-    label &= 0xFFU;
+    s_cmdLine[s_cmdLength] = '\0';
 
-    if (label == 0xFFU)
+    if (s_cmdLength == 0U)
     {
-        s_filterByLabelEnabled = false;
-        PRINTF("\r\nLabel filter disabled.\r\n");
+        AnalyzerCore_PrintFilter(&s_core, PRINTF);
+    }
+    else if (A429Filter_Command(&s_core.filter, s_cmdLine))
+    {
+        AnalyzerCore_PrintFilter(&s_core, PRINTF);
     }
     else
     {
-        s_filterByLabelEnabled = true;
-        s_filterLabel          = (uint8_t)label;
-        PRINTF("\r\nLabel filter set to 0x%02X.\r\n", (unsigned int)s_filterLabel);
+        PRINTF("\r\nERR: bad filter command \"%s\" (h for help)\r\n", s_cmdLine);
     }
+}
 
-    PRINTF("Enter channel filter (0=any, 1 or 2): ");
-    SCANF("%u", &channel);
-
-    if (channel == 1U || channel == 2U)
+/* Line editing for the filter prompt. Never blocks: one character per call,
+   so sniffer RX keeps being drained while a command is typed. */
+static void Analyzer_CommandChar(char ch)
+{
+    if ((ch == '\r') || (ch == '\n'))
     {
-        s_filterByChannelEnabled = true;
-        s_filterChannel          = (uint8_t)channel;
-        PRINTF("\r\nChannel filter set to %u.\r\n", (unsigned int)s_filterChannel);
+        s_cmdActive = false;
+        Analyzer_RunFilterCommand();
+        s_cmdLength = 0U;
     }
-    else
+    else if (ch == 0x1B) /* Esc */
     {
-        s_filterByChannelEnabled = false;
-        PRINTF("\r\nChannel filter disabled (any channel).\r\n");
+        s_cmdActive = false;
+        s_cmdLength = 0U;
+        PRINTF("\r\n(cancelled)\r\n");
+    }
+    else if ((ch == '\b') || (ch == 0x7F))
+    {
+        if (s_cmdLength > 0U)
+        {
+            s_cmdLength--;
+            PRINTF("\b \b");
+        }
+    }
+    else if ((ch >= ' ') && (s_cmdLength < (CMD_LINE_BUFFER_SIZE - 1U)))
+    {
+        s_cmdLine[s_cmdLength++] = ch;
+        PUTCHAR(ch);
     }
 }
 
-/* Non-blocking poll for a console command using DbgConsole_TryGetchar. */
 static void Analyzer_HandleUserInput(void)
 {
     char ch;
@@ -351,6 +925,12 @@ static void Analyzer_HandleUserInput(void)
         return;
     }
 
+    if (s_cmdActive)
+    {
+        Analyzer_CommandChar(ch);
+        return;
+    }
+
     switch (ch)
     {
         case 'h':
@@ -360,12 +940,33 @@ static void Analyzer_HandleUserInput(void)
 
         case 's':
         case 'S':
-            Analyzer_PrintSummary();
+            AnalyzerCore_PrintSummary(&s_core, PRINTF);
             break;
 
         case 'l':
         case 'L':
-            Analyzer_PrintLabelTable();
+            AnalyzerCore_PrintLabelTable(&s_core, PRINTF);
+            break;
+
+        case 't':
+        case 'T':
+            AnalyzerCore_PrintTiming(&s_core, PRINTF);
+            break;
+
+        case 'w':
+        case 'W':
+            s_capEnabled = !s_capEnabled;
+            if (!s_capEnabled)
+            {
+                Capture_Flush(&s_capWriter);
+            }
+            Analyzer_PrintCapture();
+            break;
+
+        case 'o':
+        case 'O':
+            s_capStream = !s_capStream;
+            Analyzer_PrintCapture();
             break;
 
         case 'c':
@@ -376,16 +977,51 @@ static void Analyzer_HandleUserInput(void)
 
         case 'f':
         case 'F':
-            Analyzer_SetFilterInteractive();
+            s_cmdActive = true;
+            s_cmdLength = 0U;
+            PRINTF("\r\nfilter> ");
             break;
 
         case 'r':
         case 'R':
-            s_filterByLabelEnabled   = false;
-            s_filterByChannelEnabled = false;
+            A429Filter_Reset(&s_core.filter);
             PRINTF("\r\nAll filters disabled.\r\n");
             break;
 
+        case 'd':
+        case 'D':
+            s_dedupOn = !s_dedupOn;
+            WordDedup_Clear(&s_dedup); /* first word of every key prints again */
+            PRINTF("\r\n");
+            Analyzer_PrintDedup();
+            break;
+
+        case 'm':
+        case 'M':
+            s_inputMode  = (s_inputMode == ANALYZER_INPUT_ASCII) ? ANALYZER_INPUT_BINARY : ANALYZER_INPUT_ASCII;
+            for (uint32_t i = 0U; i < SNIFFER_PORT_COUNT; i++)
+            {
+                Sniffer_ResetParse(&s_ports[i], false);
+            }
+            LabelTiming_Clear(&s_core.timing); /* timestamps switch clock domain */
+            WordDedup_Clear(&s_dedup);
+            if (s_capEnabled)
+            {
+                Capture_Flush(&s_capWriter);
+            }
+            PRINTF("\r\nInput format: %s\r\n", (s_inputMode == ANALYZER_INPUT_BINARY) ? "binary frames" : "ASCII lines");
+            break;
+
+        case 'p':
+        case 'P':
+            Analyzer_PrintPerf();
+            break;
+
+        case 'b':
+        case 'B':
+            Analyzer_BenchParser();
+            break;
+
         default:
             PRINTF("\r\nUnknown command '%c'. Press 'h' for help.\r\n", ch);
             break;
@@ -398,34 +1034,32 @@ static void Analyzer_HandleUserInput(void)
 
 int main(void)
 {
-    lpuart_config_t config;
-
     BOARD_InitHardware();
 
     PRINTF("\r\n=== IMXRT1050 ARINC 429 UART Host ===\r\n");
-    PRINTF("LPUART3 is used to receive sniffer output at %u baud.\r\n", (unsigned int)UART_SNiffer_BAUDRATE);
-    PRINTF("Use the debug console (USB CDC) for commands. Press 'h' for help.\r\n");
+    PRINTF("%u sniffer port(s), 8-N-1:\r\n", (unsigned int)SNIFFER_PORT_COUNT);
 
-    /* Configure LPUART3 (DEMO_LPUART) for 115200, 8-N-1 */
-    LPUART_GetDefaultConfig(&config);
-    config.baudRate_Bps = UART_SNiffer_BAUDRATE;
-    config.enableTx     = false; /* We only receive from sniffer; TX is not required */
-    config.enableRx     = true;
-
-    LPUART_Init(DEMO_LPUART, &config, DEMO_LPUART_CLK_FREQ);
-
-    /* Create handle and start RX ring buffer */
-    LPUART_TransferCreateHandle(DEMO_LPUART, &g_lpuartHandle, LPUART_SnifferCallback, NULL);
-    LPUART_TransferStartRingBuffer(DEMO_LPUART, &g_lpuartHandle, g_rxRingBuffer, sizeof(g_rxRingBuffer));
+    /* Configure every sniffer LPUART and start its RX ring buffer */
+    Sniffer_InitPorts();
+    PRINTF("Use the debug console (USB CDC) for commands. Press 'h' for help.\r\n");
 
     /* Initialize analyzer state */
+    Analyzer_TimeInit();
+    Capture_WriterInit(&s_capWriter, Analyzer_CaptureSink, NULL);
+    AnalyzerCore_Init(&s_core);
+    WordDedup_Init(&s_dedup, ANALYZER_DEDUP_HEARTBEAT_MS);
+    LogThrottle_Init(&s_logThrottle, ANALYZER_LOG_RATE, ANALYZER_LOG_BURST,
+                     ANALYZER_LOG_LABEL_QUOTA, ANALYZER_LOG_SAMPLE_N, Analyzer_NowUs());
     Analyzer_ClearStats();
     Analyzer_PrintHelp();
 
     while (1)
     {
-        /* Continuously grab data from the sniffer UART and parse it */
-        Sniffer_PollUart();
+        /* Continuously grab data from the sniffer UARTs and parse it */
+        (void)Analyzer_Cycles64();
+        Sniffer_PollPorts();
+        Analyzer_CapturePump();
+        Analyzer_ThrottleTick();
 
         /* Handle any PC console commands (non-blocking) */
         Analyzer_HandleUserInput();